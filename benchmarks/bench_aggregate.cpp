@@ -0,0 +1,75 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#include "../include/reflect/aggregate.hpp"
+#include "bench_common.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace benchmarks {
+
+struct position_info
+{
+    int64_t account;
+    double bod_position;
+    double position;
+    double buy_quantity;
+    double sell_quantity;
+    int32_t lots;
+
+    REFLECT(position_info, (), (account, bod_position, position, buy_quantity, sell_quantity, lots));
+};
+
+} // namespace benchmarks
+
+int main()
+{
+    using namespace benchmarks;
+    using ::krrs::reflect::simd::level;
+
+    constexpr std::size_t count = 5'000'000;
+    std::vector<position_info> aos;
+    ::krrs::reflect::soa_vector<position_info> soa;
+    aos.reserve(count);
+    soa.reserve(count);
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        const auto value = static_cast<double>(i % 1000) - 500.0;
+        const position_info pos{static_cast<int64_t>(i % 97), value, value + 1.0, value * 2.0, value, static_cast<int32_t>(i % 13) - 6};
+        aos.push_back(pos);
+        soa.push_back(pos);
+    }
+    std::printf("-- %zu positions, simd level %d\n", count, static_cast<int>(::krrs::reflect::simd::detected_level()));
+
+    const auto run = [](const char* name, std::size_t bytes, auto&& fn) {
+        return measure(name, 50, [bytes, &fn] {
+            do_not_optimize(fn());
+            return bytes;
+        });
+    };
+
+    // sum of position, the member read the ways a risk loop would
+    const std::size_t bytes = count * sizeof(double);
+    const result loop = run("for_each + get_member_variable", bytes, [&aos] {
+        double total = 0.0;
+        for (const position_info& pos : aos)
+        {
+            ::krrs::reflect::for_each<position_info>([&total, &pos]<typename Descriptor>() {
+                if constexpr (Descriptor::name == "position")
+                {
+                    total += ::krrs::reflect::get_member_variable<Descriptor>(pos);
+                }
+            });
+        }
+        return total;
+    });
+    run("sum<position>(vector) scalar", bytes, [&aos] { return ::krrs::reflect::sum<&position_info::position>(aos, level::scalar); });
+    const result aos_simd = run("sum<position>(vector) avx2 gather", bytes, [&aos] { return ::krrs::reflect::sum<&position_info::position>(aos); });
+    run("sum<position>(soa_vector) scalar", bytes, [&soa] { return ::krrs::reflect::sum<&position_info::position>(soa, level::scalar); });
+    const result soa_simd = run("sum<position>(soa_vector) avx2", bytes, [&soa] { return ::krrs::reflect::sum<&position_info::position>(soa); });
+    run("max<lots>(soa_vector) scalar", count * sizeof(int32_t), [&soa] { return *::krrs::reflect::max<&position_info::lots>(soa, level::scalar); });
+    run("max<lots>(soa_vector) avx2", count * sizeof(int32_t), [&soa] { return *::krrs::reflect::max<&position_info::lots>(soa); });
+    std::printf("speedup over the loop: %.2fx (vector), %.2fx (soa_vector)\n", loop.ns_per_op / aos_simd.ns_per_op, loop.ns_per_op / soa_simd.ns_per_op);
+}
@@ -0,0 +1,135 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#include "../include/binary/convert.hpp"
+#include "../include/binary/stream.hpp"
+#include "../include/json/parser.hpp"
+#include "bench_common.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace benchmarks {
+
+struct quote
+{
+    std::string symbol;
+    int64_t sequence;
+    double bid;
+    double ask;
+    int32_t bid_size;
+    int32_t ask_size;
+
+    REFLECT(quote, (), (symbol, sequence, bid, ask, bid_size, ask_size));
+};
+
+struct depth_snapshot
+{
+    std::string venue;
+    int64_t sequence;
+    std::vector<double> bids;
+    std::vector<double> asks;
+    std::vector<quote> quotes;
+
+    REFLECT(depth_snapshot, (), (venue, sequence, bids, asks, quotes));
+};
+
+// quote as a newer build sees it, the sizes widened and the members in another order
+struct quote_v2
+{
+    double bid;
+    double ask;
+    int64_t bid_size;
+    int64_t ask_size;
+    std::string symbol;
+    int64_t sequence;
+
+    REFLECT(quote_v2, (), (bid, ask, bid_size, ask_size, symbol, sequence));
+};
+
+template <typename T>
+void run_suite(std::string_view label, const T& obj, std::size_t iterations)
+{
+    const std::string json = ::krrs::json::convert_to_json(obj);
+    const std::string bytes = ::krrs::binary::encode(obj);
+    std::printf("-- %.*s (json %zu bytes, binary %zu bytes, %.2fx smaller)\n", static_cast<int>(label.size()), label.data(), json.size(), bytes.size(),
+                static_cast<double>(json.size()) / static_cast<double>(bytes.size()));
+
+    std::string buffer;
+    const result json_encode = measure("json::convert_to_json", iterations, [&obj, &buffer] {
+        buffer.clear();
+        ::krrs::json::convert_to_json(obj, buffer);
+        do_not_optimize(buffer.data());
+        return buffer.size();
+    });
+    const result binary_encode = measure("binary::encode", iterations, [&obj, &buffer] {
+        buffer.clear();
+        ::krrs::binary::encode(obj, buffer);
+        do_not_optimize(buffer.data());
+        return buffer.size();
+    });
+    std::printf("encode speedup: %.2fx\n", json_encode.ns_per_op / binary_encode.ns_per_op);
+
+    const result json_decode = measure("json::convert_from_json", iterations, [&json] {
+        T decoded{};
+        ::krrs::json::convert_from_json(decoded, json);
+        do_not_optimize(decoded);
+        return json.size();
+    });
+    const result binary_decode = measure("binary::decode", iterations, [&bytes] {
+        T decoded{};
+        ::krrs::binary::decode(decoded, bytes);
+        do_not_optimize(decoded);
+        return bytes.size();
+    });
+    std::printf("decode speedup: %.2fx\n\n", json_decode.ns_per_op / binary_decode.ns_per_op);
+}
+
+// reading a stream of quotes with the writer's own type (fingerprints agree) and with quote_v2 (matched by name)
+void run_stream_suite(const std::vector<quote>& quotes, std::size_t iterations)
+{
+    std::string bytes;
+    ::krrs::io::string_sink sink{bytes};
+    ::krrs::binary::stream_writer<quote, ::krrs::io::string_sink> writer{sink};
+    for (const quote& q : quotes)
+    {
+        writer.write(q);
+    }
+    std::printf("-- stream of %zu quotes (ns/op is per stream)\n", quotes.size());
+
+    const auto read_all = [&bytes]<typename T>() {
+        return [&bytes] {
+            ::krrs::binary::stream_reader<T> reader{bytes};
+            T record{};
+            while (reader.read(record))
+            {
+                do_not_optimize(record);
+            }
+            return bytes.size();
+        };
+    };
+    const result fast = measure("matching fingerprint", iterations, read_all.template operator()<quote>());
+    const result tagged = measure("other version, fields by name", iterations, read_all.template operator()<quote_v2>());
+    std::printf("tagged slow path costs %.2fx the fast path\n\n", tagged.ns_per_op / fast.ns_per_op);
+}
+
+} // namespace benchmarks
+
+int main()
+{
+    using namespace benchmarks;
+
+    const quote single{"AAPL", 9'223'372'036'854, 189.25, 189.27, 300, 1'200};
+    run_suite("single quote", single, 1'000'000);
+
+    depth_snapshot snapshot{.venue = "XNAS", .sequence = 77, .bids = {}, .asks = {}, .quotes = {}};
+    for (int i = 0; i != 50; ++i)
+    {
+        snapshot.bids.push_back(189.25 - static_cast<double>(i) / 100.0);
+        snapshot.asks.push_back(189.27 + static_cast<double>(i) / 100.0);
+        snapshot.quotes.push_back(quote{"SYM" + std::to_string(i), i, 100.0 + i / 8.0, 100.5 + i / 8.0, 100 * i, 50 * i});
+    }
+    run_suite("depth snapshot", snapshot, 20'000);
+    run_stream_suite(snapshot.quotes, 20'000);
+}
@@ -0,0 +1,87 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#include "../include/binary/convert.hpp"
+#include "../include/columnar/reader.hpp"
+#include "../include/columnar/writer.hpp"
+#include "bench_common.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace benchmarks {
+
+enum class side : uint8_t
+{
+    BUY = 1,
+    SELL = 2,
+};
+
+struct trade
+{
+    std::string symbol;
+    int64_t timestamp;
+    uint64_t sequence;
+    side direction;
+    double price;
+    int32_t quantity;
+
+    REFLECT(trade, (), (symbol, timestamp, sequence, direction, price, quantity));
+};
+
+struct trade_log
+{
+    std::vector<trade> trades;
+
+    REFLECT(trade_log, (), (trades));
+};
+
+} // namespace benchmarks
+
+int main()
+{
+    using namespace benchmarks;
+
+    constexpr std::size_t count = 1'000'000;
+    static constexpr const char* symbols[] = {"AAPL", "MSFT", "NVDA", "AMZN", "GOOG", "META", "TSLA", "AMD"};
+    trade_log log;
+    log.trades.reserve(count);
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        log.trades.push_back(trade{symbols[i * 7 % 8], 1'700'000'000'000'000'000 + static_cast<int64_t>(i) * 1'250, 5'000'000 + i,
+                                   i % 3 == 0 ? side::SELL : side::BUY, 100.0 + static_cast<double>(i % 400) / 100.0, static_cast<int32_t>(i % 9 + 1) * 100});
+    }
+
+    const std::string binary = ::krrs::binary::encode(log);
+    const std::string columnar = ::krrs::columnar::write(log.trades);
+    std::printf("-- %zu trades (binary %.1f MB, columnar %.1f MB)\n", count, static_cast<double>(binary.size()) / (1024.0 * 1024.0),
+                static_cast<double>(columnar.size()) / (1024.0 * 1024.0));
+
+    measure("columnar::write", 5, [&log] {
+        const std::string bytes = ::krrs::columnar::write(log.trades);
+        do_not_optimize(bytes.data());
+        return bytes.size();
+    });
+
+    // total traded quantity: decode every row, or decode the one column
+    const result decode_then_sum = measure("binary::decode + sum", 5, [&binary] {
+        const auto decoded = ::krrs::binary::decode<trade_log>(binary);
+        int64_t total = 0;
+        for (const trade& t : decoded.trades)
+        {
+            total += t.quantity;
+        }
+        do_not_optimize(total);
+        return binary.size();
+    });
+    const result scan_sum = measure("columnar::reader::scan<quantity>", 20, [&columnar] {
+        const ::krrs::columnar::reader<trade> reader{columnar};
+        int64_t total = 0;
+        reader.scan<&trade::quantity>([&total](int32_t quantity) { total += quantity; });
+        do_not_optimize(total);
+        return columnar.size();
+    });
+    std::printf("scan speedup: %.2fx\n", decode_then_sum.ns_per_op / scan_sum.ns_per_op);
+}
@@ -0,0 +1,54 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <string_view>
+
+namespace benchmarks {
+
+// keeps the optimizer from discarding the result of a benchmarked expression
+template <typename T>
+inline void do_not_optimize(const T& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+struct result
+{
+    double ns_per_op;
+    double mb_per_sec;
+};
+
+// runs func `iterations` times and reports the time per op. func returns the number of bytes it produced
+template <typename Functor>
+result measure(std::string_view name, std::size_t iterations, Functor&& func)
+{
+    std::size_t bytes = 0;
+
+    // warm up caches and the allocator before timing anything
+    for (std::size_t i = 0; i != iterations / 10 + 1; ++i)
+    {
+        bytes += func();
+    }
+
+    bytes = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i != iterations; ++i)
+    {
+        bytes += func();
+    }
+    const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    const result r{
+        .ns_per_op = elapsed / static_cast<double>(iterations),
+        .mb_per_sec = (static_cast<double>(bytes) / (1024.0 * 1024.0)) / (elapsed / 1e9),
+    };
+    std::printf("%-40.*s %10.1f ns/op %10.1f MB/s\n", static_cast<int>(name.size()), name.data(), r.ns_per_op, r.mb_per_sec);
+    return r;
+}
+
+} // namespace benchmarks
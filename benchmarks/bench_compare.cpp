@@ -0,0 +1,89 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#include "../include/reflect/compare.hpp"
+#include "bench_common.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace benchmarks {
+
+// declared in message order, the strings come first and are mostly the same from one record to the next
+struct trade_record
+{
+    std::string desk;
+    std::string book;
+    int64_t trade_id;
+    int32_t version;
+    int32_t flags;
+    double price;
+
+    REFLECT(trade_record, (), (desk, book, trade_id, version, flags, price));
+
+    bool operator==(const trade_record&) const = default;
+};
+
+// integers only and no padding, a single memcmp
+struct fill_record
+{
+    int64_t order_id;
+    int64_t fill_id;
+    int32_t quantity;
+    int32_t venue;
+    int64_t timestamp;
+
+    REFLECT(fill_record, (), (order_id, fill_id, quantity, venue, timestamp));
+
+    bool operator==(const fill_record&) const = default;
+};
+
+static_assert(::krrs::reflect::is_bitwise_comparable<fill_record>);
+
+} // namespace benchmarks
+
+int main()
+{
+    using namespace benchmarks;
+
+    // small enough to stay in cache, a million records would measure memory bandwidth instead
+    constexpr std::size_t count = 16'384;
+    std::vector<trade_record> trades;
+    std::vector<fill_record> fills;
+    trades.reserve(count);
+    fills.reserve(count);
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        // every fourth record repeats the one before it, as a replayed message would
+        const std::size_t id = i - (i % 4 == 3 ? 1 : 0);
+        trades.push_back({"EMEA rates trading desk", "london government bonds book", static_cast<int64_t>(id), 1, 0, 100.25});
+        fills.push_back({static_cast<int64_t>(id / 8), static_cast<int64_t>(id), 100, 3, static_cast<int64_t>(id) * 1000});
+    }
+
+    std::printf("-- comparing %zu neighbouring records\n", count - 1);
+    const auto dedup = [](const auto& records, auto&& equal) {
+        std::size_t duplicates = 0;
+        for (std::size_t i = 1; i != records.size(); ++i)
+        {
+            duplicates += equal(records[i - 1], records[i]) ? 1 : 0;
+        }
+        do_not_optimize(duplicates);
+        return records.size() * sizeof(records[0]);
+    };
+
+    const result trade_default = measure("operator== trade_record", 2000, [&] { return dedup(trades, std::equal_to<>{}); });
+    const result trade_reflected = measure("reflect::equal trade_record", 2000, [&] {
+        return dedup(trades, [](const trade_record& lhs, const trade_record& rhs) { return ::krrs::reflect::equal(lhs, rhs); });
+    });
+    const result fill_default = measure("operator== fill_record", 2000, [&] { return dedup(fills, std::equal_to<>{}); });
+    const result fill_reflected = measure("reflect::equal fill_record", 2000, [&] {
+        return dedup(fills, [](const fill_record& lhs, const fill_record& rhs) { return ::krrs::reflect::equal(lhs, rhs); });
+    });
+    measure("reflect::compare trade_record", 2000, [&] {
+        return dedup(trades, [](const trade_record& lhs, const trade_record& rhs) { return ::krrs::reflect::compare(lhs, rhs) == 0; });
+    });
+    std::printf("equal speedup: %.2fx trade_record, %.2fx fill_record\n", trade_default.ns_per_op / trade_reflected.ns_per_op,
+                fill_default.ns_per_op / fill_reflected.ns_per_op);
+}
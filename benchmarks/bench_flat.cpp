@@ -0,0 +1,93 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#include "../include/binary/convert.hpp"
+#include "../include/flat/builder.hpp"
+#include "../include/flat/view.hpp"
+#include "bench_common.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace benchmarks {
+
+struct quote
+{
+    std::string symbol;
+    int64_t sequence;
+    double bid;
+    double ask;
+    int32_t bid_size;
+    int32_t ask_size;
+
+    REFLECT(quote, (), (symbol, sequence, bid, ask, bid_size, ask_size));
+};
+
+struct depth_snapshot
+{
+    std::string venue;
+    int64_t sequence;
+    std::vector<double> bids;
+    std::vector<double> asks;
+    std::vector<quote> quotes;
+
+    REFLECT(depth_snapshot, (), (venue, sequence, bids, asks, quotes));
+};
+
+} // namespace benchmarks
+
+int main()
+{
+    using namespace benchmarks;
+
+    depth_snapshot snapshot{.venue = "XNAS", .sequence = 77, .bids = {}, .asks = {}, .quotes = {}};
+    for (int i = 0; i != 50; ++i)
+    {
+        snapshot.bids.push_back(189.25 - static_cast<double>(i) / 100.0);
+        snapshot.asks.push_back(189.27 + static_cast<double>(i) / 100.0);
+        snapshot.quotes.push_back(quote{"SYM" + std::to_string(i), i, 100.0 + i / 8.0, 100.5 + i / 8.0, 100 * i, 50 * i});
+    }
+
+    const std::string binary = ::krrs::binary::encode(snapshot);
+    const std::string flat = ::krrs::flat::build(snapshot);
+    std::printf("-- depth snapshot (binary %zu bytes, flat %zu bytes)\n", binary.size(), flat.size());
+
+    std::string buffer;
+    const result binary_encode = measure("binary::encode", 20'000, [&snapshot, &buffer] {
+        buffer.clear();
+        ::krrs::binary::encode(snapshot, buffer);
+        do_not_optimize(buffer.data());
+        return buffer.size();
+    });
+    ::krrs::flat::builder<depth_snapshot> builder;
+    const result flat_build = measure("flat::builder::build", 20'000, [&snapshot, &builder] {
+        const std::string_view bytes = builder.build(snapshot);
+        do_not_optimize(bytes.data());
+        return bytes.size();
+    });
+    std::printf("build costs %.2fx binary::encode\n", flat_build.ns_per_op / binary_encode.ns_per_op);
+
+    // summing the ask size of every quote: decode everything first, or read the one member in place
+    const result decode_then_read = measure("binary::decode + sum", 20'000, [&binary] {
+        const auto decoded = ::krrs::binary::decode<depth_snapshot>(binary);
+        int64_t total = 0;
+        for (const quote& q : decoded.quotes)
+        {
+            total += q.ask_size;
+        }
+        do_not_optimize(total);
+        return binary.size();
+    });
+    const result view_read = measure("flat::view + sum", 20'000, [&flat] {
+        const ::krrs::flat::view<depth_snapshot> view{flat};
+        int64_t total = 0;
+        for (const auto q : view.get<&depth_snapshot::quotes>())
+        {
+            total += q.get<&quote::ask_size>();
+        }
+        do_not_optimize(total);
+        return flat.size();
+    });
+    std::printf("read speedup: %.2fx\n", decode_then_read.ns_per_op / view_read.ns_per_op);
+}
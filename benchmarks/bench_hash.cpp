@@ -0,0 +1,159 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#include "../include/reflect/hash.hpp"
+#include "bench_common.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace benchmarks {
+
+// 16 bytes with no padding, hashed as a single block
+struct risk_key
+{
+    int64_t instrument;
+    int32_t account;
+    int32_t book;
+
+    REFLECT(risk_key, (), (instrument, account, book));
+
+    bool operator==(const risk_key&) const = default;
+};
+
+struct desk_key
+{
+    int64_t instrument;
+    int32_t account;
+    int32_t book;
+    std::string desk;
+
+    REFLECT(desk_key, (), (instrument, account, book, desk));
+
+    bool operator==(const desk_key&) const = default;
+};
+
+inline void hash_combine(std::size_t& seed, std::size_t value)
+{
+    seed ^= value + 0x9E3779B9 + (seed << 6) + (seed >> 2);
+}
+
+// what the keys were hashed with before, one std::hash and hash_combine per member
+struct risk_key_hash
+{
+    std::size_t operator()(const risk_key& key) const noexcept
+    {
+        std::size_t seed = 0;
+        hash_combine(seed, std::hash<int64_t>{}(key.instrument));
+        hash_combine(seed, std::hash<int32_t>{}(key.account));
+        hash_combine(seed, std::hash<int32_t>{}(key.book));
+        return seed;
+    }
+};
+
+struct desk_key_hash
+{
+    std::size_t operator()(const desk_key& key) const noexcept
+    {
+        std::size_t seed = 0;
+        hash_combine(seed, std::hash<int64_t>{}(key.instrument));
+        hash_combine(seed, std::hash<int32_t>{}(key.account));
+        hash_combine(seed, std::hash<int32_t>{}(key.book));
+        hash_combine(seed, std::hash<std::string>{}(key.desk));
+        return seed;
+    }
+};
+
+// looks the keys up in another order than they were inserted in, as a stream of trades would
+template <typename Key, typename Hash>
+result bench_lookups(const char* name, std::vector<Key> keys)
+{
+    std::unordered_map<Key, double, Hash> map;
+    map.reserve(keys.size());
+    for (const Key& key : keys)
+    {
+        map[key] = 1.0;
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937_64{42});
+    return measure(name, 10, [&map, &keys] {
+        double total = 0.0;
+        for (const Key& key : keys)
+        {
+            total += map.find(key)->second;
+        }
+        do_not_optimize(total);
+        return keys.size() * sizeof(Key);
+    });
+}
+
+} // namespace benchmarks
+
+int main()
+{
+    using namespace benchmarks;
+
+    constexpr std::size_t count = 1'000'000;
+    std::vector<risk_key> keys;
+    std::vector<desk_key> desk_keys;
+    keys.reserve(count);
+    desk_keys.reserve(count);
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        // clustered like real keys, a few accounts and books over many instruments
+        const risk_key key{static_cast<int64_t>(i / 64) * 4096, static_cast<int32_t>(i % 8), static_cast<int32_t>((i / 8) % 8)};
+        keys.push_back(key);
+        desk_keys.push_back({key.instrument, key.account, key.book, "desk " + std::to_string(i % 16)});
+    }
+
+    std::printf("-- hashing %zu keys\n", count);
+    const result combine = measure("hash_combine risk_key", 50, [&keys] {
+        std::size_t total = 0;
+        for (const risk_key& key : keys)
+        {
+            total += risk_key_hash{}(key);
+        }
+        do_not_optimize(total);
+        return keys.size() * sizeof(risk_key);
+    });
+    const result reflected = measure("reflect::hash risk_key", 50, [&keys] {
+        std::size_t total = 0;
+        for (const risk_key& key : keys)
+        {
+            total += ::krrs::reflect::hash<risk_key>{}(key);
+        }
+        do_not_optimize(total);
+        return keys.size() * sizeof(risk_key);
+    });
+    const result desk_combine = measure("hash_combine desk_key", 50, [&desk_keys] {
+        std::size_t total = 0;
+        for (const desk_key& key : desk_keys)
+        {
+            total += desk_key_hash{}(key);
+        }
+        do_not_optimize(total);
+        return desk_keys.size() * sizeof(desk_key);
+    });
+    const result desk_reflected = measure("reflect::hash desk_key", 50, [&desk_keys] {
+        std::size_t total = 0;
+        for (const desk_key& key : desk_keys)
+        {
+            total += ::krrs::reflect::hash<desk_key>{}(key);
+        }
+        do_not_optimize(total);
+        return desk_keys.size() * sizeof(desk_key);
+    });
+    std::printf("hash speedup: %.2fx risk_key, %.2fx desk_key\n", combine.ns_per_op / reflected.ns_per_op, desk_combine.ns_per_op / desk_reflected.ns_per_op);
+
+    std::printf("-- unordered_map lookups of %zu keys\n", count);
+    bench_lookups<risk_key, risk_key_hash>("hash_combine find risk_key", keys);
+    bench_lookups<risk_key, ::krrs::reflect::hash<risk_key>>("reflect::hash find risk_key", keys);
+    const result combine_map = bench_lookups<desk_key, desk_key_hash>("hash_combine find desk_key", desk_keys);
+    const result reflected_map = bench_lookups<desk_key, ::krrs::reflect::hash<desk_key>>("reflect::hash find desk_key", desk_keys);
+    std::printf("desk_key lookup speedup: %.2fx\n", combine_map.ns_per_op / reflected_map.ns_per_op);
+}
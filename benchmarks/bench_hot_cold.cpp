@@ -0,0 +1,70 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#include "../include/reflect/hot_cold.hpp"
+#include "bench_common.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace benchmarks {
+
+// the matching loop reads price and quantity, everything else is looked at when the order is amended or reported
+struct resting_order
+{
+    double price;
+    int64_t quantity;
+    int64_t order_id;
+    int64_t account;
+    std::string client_ref;
+    std::string notes;
+
+    REFLECT(resting_order, (), ((hot, price), (hot, quantity), (cold, order_id), (cold, account), (cold, client_ref), (cold, notes)));
+};
+
+} // namespace benchmarks
+
+int main()
+{
+    using namespace benchmarks;
+    using quantity_descriptor = ::krrs::reflect::detail::descriptor_for<resting_order, &resting_order::quantity>;
+
+    constexpr std::size_t count = 2'000'000;
+    std::vector<resting_order> aos;
+    ::krrs::reflect::hot_cold_vector<resting_order> split;
+    aos.reserve(count);
+    split.reserve(count);
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        const resting_order order{100.0 + static_cast<double>(i % 500) * 0.01, static_cast<int64_t>(i % 1000), static_cast<int64_t>(i), static_cast<int64_t>(i % 97),
+                                  "client", "no notes"};
+        aos.push_back(order);
+        split.push_back(order);
+    }
+    std::printf("-- %zu orders, %zu bytes whole, %zu bytes hot\n", count, sizeof(resting_order), split.hot_row_size);
+
+    // quantity resting at or better than a limit, the same code over both containers
+    const auto depth = [](const auto& book) {
+        int64_t total = 0;
+        for (auto&& order : book)
+        {
+            if (::krrs::reflect::get_member_variable<::krrs::reflect::detail::descriptor_for<resting_order, &resting_order::price>>(order) <= 102.5)
+            {
+                total += ::krrs::reflect::get_member_variable<quantity_descriptor>(order);
+            }
+        }
+        return total;
+    };
+
+    const result aos_depth = measure("std::vector<T> depth", 50, [&aos, &depth] {
+        do_not_optimize(depth(aos));
+        return aos.size() * 16;
+    });
+    const result split_depth = measure("hot_cold_vector<T> depth", 50, [&split, &depth] {
+        do_not_optimize(depth(split));
+        return split.size() * 16;
+    });
+    std::printf("hot/cold speedup: %.2fx\n", aos_depth.ns_per_op / split_depth.ns_per_op);
+}
@@ -0,0 +1,104 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#include "../include/json/parser.hpp"
+#include "bench_common.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace benchmarks {
+
+struct trade
+{
+    std::string venue;
+    std::string symbol;
+    int64_t sequence;
+    double price;
+    double quantity;
+
+    REFLECT(trade, (), (venue, symbol, sequence, price, quantity));
+};
+
+struct trade_batch
+{
+    std::vector<trade> trades;
+
+    REFLECT(trade_batch, (), (trades));
+};
+
+// only the sequence numbers, every other member has to be skipped
+struct sequence_only
+{
+    int64_t sequence;
+
+    REFLECT(sequence_only, (), (sequence));
+};
+
+struct sequence_batch
+{
+    std::vector<sequence_only> trades;
+
+    REFLECT(sequence_batch, (), (trades));
+};
+
+template <typename T>
+void run_suite(std::string_view label, const std::string& json, std::size_t iterations)
+{
+    std::printf("-- %.*s (%zu bytes)\n", static_cast<int>(label.size()), label.data(), json.size());
+
+    const auto decode_with = [&json](::krrs::reflect::simd::level level) {
+        return [&json, level] {
+            T obj{};
+            ::krrs::json::reader r{json, level};
+            ::krrs::json::convert_from_json(obj, r);
+            do_not_optimize(obj);
+            return json.size();
+        };
+    };
+
+    const result scalar = measure("structural index (scalar)", iterations, decode_with(::krrs::reflect::simd::level::scalar));
+    measure("structural index (sse2)", iterations, decode_with(::krrs::reflect::simd::level::sse2));
+    const result best = measure("structural index (detected)", iterations, decode_with(::krrs::reflect::simd::detected_level()));
+    std::printf("speedup (detected vs scalar): %.2fx\n\n", scalar.ns_per_op / best.ns_per_op);
+}
+
+} // namespace benchmarks
+
+int main()
+{
+    using namespace benchmarks;
+
+    trade_batch batch;
+    for (int64_t i = 0; i != 10'000; ++i)
+    {
+        batch.trades.push_back(trade{
+            .venue = "XNAS",
+            .symbol = "a fairly long instrument description, [with] {structural} characters: " + std::to_string(i),
+            .sequence = i,
+            .price = 101.25 + static_cast<double>(i) / 64.0,
+            .quantity = 1'000.5,
+        });
+    }
+    const std::string json = ::krrs::json::convert_to_json(batch);
+
+    run_suite<trade_batch>("full decode", json, 100);
+    run_suite<sequence_batch>("decode with skipped members", json, 100);
+
+    // a single message where only the leading members are of interest
+    const std::string message = ::krrs::json::convert_to_json(batch.trades.front());
+    std::printf("-- single message (%zu bytes)\n", message.size());
+    const result full = measure("convert_from_json (every member)", 1'000'000, [&message] {
+        trade obj{};
+        ::krrs::json::convert_from_json(obj, message);
+        do_not_optimize(obj);
+        return message.size();
+    });
+    const result projected = measure("decode_only<venue, sequence>", 1'000'000, [&message] {
+        const trade obj = ::krrs::json::decode_only<trade, &trade::venue, &trade::sequence>(message);
+        do_not_optimize(obj);
+        return message.size();
+    });
+    std::printf("speedup (decode_only vs full): %.2fx\n\n", full.ns_per_op / projected.ns_per_op);
+}
@@ -0,0 +1,255 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#include "../include/json/parser.hpp"
+#include "bench_common.hpp"
+
+#include <cstdint>
+#include <fcntl.h>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+namespace benchmarks {
+
+struct position_info
+{
+    double bod_position;
+    double position;
+    double buy_quantity;
+    double sell_quantity;
+
+    REFLECT(position_info, (), (bod_position, position, buy_quantity, sell_quantity));
+};
+
+struct book_snapshot
+{
+    std::string venue;
+    int64_t sequence;
+    position_info position;
+    std::vector<double> levels;
+    std::unordered_map<std::string, int> counters;
+
+    REFLECT(book_snapshot, (), (venue, sequence, position, levels, counters));
+};
+
+struct document
+{
+    std::string id;
+    std::vector<std::string> chunks;
+
+    REFLECT(document, (), (id, chunks));
+};
+
+namespace legacy {
+
+// the ostringstream based serializer the writer replaced, kept here as the baseline
+template <::krrs::reflect::concepts::reflectable T>
+std::string convert_to_json(const T& obj)
+{
+    std::ostringstream oss;
+    oss << '{';
+    ::krrs::reflect::for_each<T>([&oss, &obj, obj_delimiter = ""]<typename Descriptor>() mutable {
+        using member_type = typename Descriptor::member_type;
+        const auto& member = ::krrs::reflect::get_member_variable<Descriptor>(obj);
+        oss << std::exchange(obj_delimiter, ", ") << std::quoted(Descriptor::name) << ": ";
+
+        if constexpr (::krrs::reflect::concepts::reflectable<member_type>)
+        {
+            oss << convert_to_json<member_type>(member);
+        }
+        else if constexpr (::krrs::json::concepts::same_as_vector<member_type>)
+        {
+            oss << '[';
+            const char* delimiter = "";
+            for (const auto& elem : member)
+            {
+                oss << std::exchange(delimiter, ", ") << elem;
+            }
+            oss << ']';
+        }
+        else if constexpr (::krrs::json::concepts::same_as_unordered_map<member_type>)
+        {
+            oss << '{';
+            const char* delimiter = "";
+            for (const auto& [key, value] : member)
+            {
+                oss << std::exchange(delimiter, ", ") << '"' << key << "\": " << value;
+            }
+            oss << '}';
+        }
+        else if constexpr (std::same_as<member_type, std::string>)
+        {
+            oss << '"' << member << '"';
+        }
+        else
+        {
+            oss << member;
+        }
+    });
+    oss << '}';
+    return oss.str();
+}
+
+template <::krrs::reflect::concepts::reflectable T>
+std::string serialize(const T& obj)
+{
+    static constexpr std::string_view class_name = ::krrs::reflect::utility::get_short_name<T>();
+    std::ostringstream oss;
+    oss << '{' << std::quoted(class_name) << ": ";
+    oss << convert_to_json(obj);
+    oss << '}';
+    return oss.str();
+}
+
+} // namespace legacy
+
+template <typename T>
+void run_suite(std::string_view label, const T& obj, std::size_t iterations)
+{
+    std::printf("-- %.*s\n", static_cast<int>(label.size()), label.data());
+
+    const result before = measure("ostringstream (legacy)", iterations, [&obj] {
+        const std::string out = legacy::serialize(obj);
+        do_not_optimize(out.data());
+        return out.size();
+    });
+
+    measure("json::serialize (fresh string)", iterations, [&obj] {
+        const std::string out = ::krrs::json::serialize(obj);
+        do_not_optimize(out.data());
+        return out.size();
+    });
+
+    std::string buffer;
+    const result after = measure("json::serialize (reused buffer)", iterations, [&obj, &buffer] {
+        buffer.clear();
+        ::krrs::json::serialize(obj, buffer);
+        do_not_optimize(buffer.data());
+        return buffer.size();
+    });
+
+    std::printf("speedup (reused buffer vs legacy): %.2fx\n\n", before.ns_per_op / after.ns_per_op);
+}
+
+// byte at a time escaping, the straightforward alternative to the vectorized scan in writer::write_string
+void escape_bytewise(std::string& out, std::string_view str)
+{
+    out.push_back('"');
+    for (const char c : str)
+    {
+        if (::krrs::json::internal::needs_escape(c))
+        {
+            out.push_back('\\');
+            out.push_back(c == '\n' ? 'n' : c);
+            continue;
+        }
+        out.push_back(c);
+    }
+    out.push_back('"');
+}
+
+void run_escape_suite(std::string_view label, const std::vector<std::string>& strings, std::size_t iterations)
+{
+    std::printf("-- %.*s\n", static_cast<int>(label.size()), label.data());
+
+    std::string buffer;
+    const auto bytes = [&strings] {
+        std::size_t total = 0;
+        for (const std::string& str : strings)
+        {
+            total += str.size();
+        }
+        return total;
+    }();
+
+    const result before = measure("byte at a time", iterations, [&strings, &buffer, bytes] {
+        buffer.clear();
+        for (const std::string& str : strings)
+        {
+            escape_bytewise(buffer, str);
+        }
+        do_not_optimize(buffer.data());
+        return bytes;
+    });
+
+    const result after = measure("writer::write_string", iterations, [&strings, &buffer, bytes] {
+        buffer.clear();
+        ::krrs::json::writer w{buffer};
+        for (const std::string& str : strings)
+        {
+            w.write_string(str);
+        }
+        do_not_optimize(buffer.data());
+        return bytes;
+    });
+
+    std::printf("speedup: %.2fx\n\n", before.ns_per_op / after.ns_per_op);
+}
+
+// large records to a file descriptor: rendered into a string and written, or streamed through an fd_sink
+void run_sink_suite(std::string_view label, const document& doc, std::size_t iterations)
+{
+    std::printf("-- %.*s\n", static_cast<int>(label.size()), label.data());
+
+    const int fd = ::open("/dev/null", O_WRONLY);
+    std::string buffer;
+    const result before = measure("serialize to string + write", iterations, [&doc, &buffer, fd] {
+        buffer.clear();
+        ::krrs::json::serialize(doc, buffer);
+        do_not_optimize(::write(fd, buffer.data(), buffer.size()));
+        return buffer.size();
+    });
+
+    const std::size_t size = buffer.size();
+    ::krrs::io::fd_sink sink{fd};
+    const result after = measure("serialize to io::fd_sink", iterations, [&doc, &sink, size] {
+        ::krrs::json::serialize(doc, sink);
+        return size;
+    });
+    sink.flush();
+    ::close(fd);
+
+    std::printf("speedup: %.2fx\n\n", before.ns_per_op / after.ns_per_op);
+}
+
+} // namespace benchmarks
+
+int main()
+{
+    using namespace benchmarks;
+
+    constexpr std::size_t iterations = 1'000'000;
+
+    const position_info position{1.0, 3.25, 4'000'000.5, 2.125};
+    run_suite("position_info", position, iterations);
+
+    const book_snapshot snapshot{
+        .venue = "XNAS",
+        .sequence = 9'223'372'036'854'775,
+        .position = position,
+        .levels = {101.25, 101.5, 101.75, 102.0, 102.25, 102.5, 102.75, 103.0},
+        .counters = {{"orders", 1200}, {"cancels", 311}, {"fills", 87}},
+    };
+    run_suite("book_snapshot", snapshot, iterations / 4);
+
+    std::vector<std::string> descriptions;
+    std::vector<std::string> quoted;
+    for (int i = 0; i != 64; ++i)
+    {
+        descriptions.push_back("NASDAQ listed common stock, class A shares, instrument " + std::to_string(i));
+        quoted.push_back("listed as \"class A\" on XNAS\nroot\\" + std::to_string(i));
+    }
+    run_escape_suite("escaping clean descriptions", descriptions, iterations / 16);
+    run_escape_suite("escaping strings with escape sites", quoted, iterations / 16);
+
+    const document doc{
+        .id = "snapshot-0001",
+        .chunks = std::vector<std::string>(16, std::string(16 * 1024, 'x')),
+    };
+    run_sink_suite("256 KiB document", doc, iterations / 1'000);
+}
@@ -0,0 +1,82 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#include "../include/binary/convert.hpp"
+#include "../include/storage/mapped_vector.hpp"
+#include "bench_common.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace benchmarks {
+
+struct position_info
+{
+    double bod_position;
+    double position;
+    double buy_quantity;
+    double sell_quantity;
+
+    REFLECT(position_info, (), (bod_position, position, buy_quantity, sell_quantity));
+};
+
+struct position_book
+{
+    std::vector<position_info> positions;
+
+    REFLECT(position_book, (), (positions));
+};
+
+} // namespace benchmarks
+
+int main()
+{
+    using namespace benchmarks;
+
+    constexpr std::size_t count = 1'000'000;
+    const std::string dir = std::filesystem::temp_directory_path().string() + "/bench_mapped_vector_" + std::to_string(::getpid());
+    const std::string mapped_path = dir + ".mvec";
+    const std::string binary_path = dir + ".bin";
+
+    position_book book;
+    {
+        ::krrs::storage::mapped_vector<position_info> positions{mapped_path};
+        positions.reserve(count);
+        for (std::size_t i = 0; i != count; ++i)
+        {
+            const auto value = static_cast<double>(i);
+            const position_info pos{value, value + 1.0, value * 2.0, value / 2.0};
+            positions.push_back(pos);
+            book.positions.push_back(pos);
+        }
+    }
+    {
+        std::ofstream out{binary_path, std::ios::binary};
+        out << ::krrs::binary::encode(book);
+    }
+    std::printf("-- %zu end-of-day positions (%.1f MB)\n", count, static_cast<double>(std::filesystem::file_size(mapped_path)) / (1024.0 * 1024.0));
+
+    // reopening the snapshot and reading one position back: parse the whole file, or map it
+    const result decode = measure("read file + binary::decode", 20, [&binary_path] {
+        std::ifstream in{binary_path, std::ios::binary};
+        const std::string bytes{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+        const auto decoded = ::krrs::binary::decode<position_book>(bytes);
+        do_not_optimize(decoded.positions[count / 2].position);
+        return bytes.size();
+    });
+    const result reopen = measure("mapped_vector read_only open", 2'000, [&mapped_path] {
+        const ::krrs::storage::mapped_vector<position_info> positions{mapped_path, ::krrs::storage::open_mode::read_only};
+        do_not_optimize(positions[count / 2].position);
+        return positions.size() * sizeof(position_info);
+    });
+    std::printf("reopen speedup: %.0fx\n", decode.ns_per_op / reopen.ns_per_op);
+
+    std::filesystem::remove(mapped_path);
+    std::filesystem::remove(binary_path);
+}
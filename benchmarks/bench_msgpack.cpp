@@ -0,0 +1,102 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#include "../include/json/parser.hpp"
+#include "../include/msgpack/parser.hpp"
+#include "bench_common.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace benchmarks {
+
+struct quote
+{
+    std::string symbol;
+    int64_t sequence;
+    double bid;
+    double ask;
+    int32_t bid_size;
+    int32_t ask_size;
+
+    REFLECT(quote, (), (symbol, sequence, bid, ask, bid_size, ask_size));
+};
+
+struct depth_snapshot
+{
+    std::string venue;
+    int64_t sequence;
+    std::vector<double> bids;
+    std::vector<double> asks;
+    std::vector<quote> quotes;
+
+    REFLECT(depth_snapshot, (), (venue, sequence, bids, asks, quotes));
+};
+
+template <::krrs::msgpack::layout Layout, typename T>
+void run_msgpack(std::string_view label, const T& obj, std::size_t iterations, const result& json_encode, const result& json_decode)
+{
+    const std::string bytes = ::krrs::msgpack::serialize<Layout>(obj);
+
+    std::string buffer;
+    const result encode = measure(std::string{label} + " encode", iterations, [&obj, &buffer] {
+        buffer.clear();
+        ::krrs::msgpack::serialize<Layout>(obj, buffer);
+        do_not_optimize(buffer.data());
+        return buffer.size();
+    });
+    const result decode = measure(std::string{label} + " decode", iterations, [&bytes] {
+        T decoded{};
+        ::krrs::msgpack::reader r{bytes};
+        ::krrs::msgpack::convert_from_msgpack<Layout>(decoded, r);
+        do_not_optimize(decoded);
+        return bytes.size();
+    });
+    std::printf("%zu bytes, encode speedup: %.2fx, decode speedup: %.2fx\n", bytes.size(), json_encode.ns_per_op / encode.ns_per_op,
+                json_decode.ns_per_op / decode.ns_per_op);
+}
+
+template <typename T>
+void run_suite(std::string_view label, const T& obj, std::size_t iterations)
+{
+    const std::string json = ::krrs::json::convert_to_json(obj);
+    std::printf("-- %.*s (json %zu bytes)\n", static_cast<int>(label.size()), label.data(), json.size());
+
+    std::string buffer;
+    const result json_encode = measure("json::convert_to_json", iterations, [&obj, &buffer] {
+        buffer.clear();
+        ::krrs::json::convert_to_json(obj, buffer);
+        do_not_optimize(buffer.data());
+        return buffer.size();
+    });
+    const result json_decode = measure("json::convert_from_json", iterations, [&json] {
+        T decoded{};
+        ::krrs::json::convert_from_json(decoded, json);
+        do_not_optimize(decoded);
+        return json.size();
+    });
+
+    run_msgpack<::krrs::msgpack::layout::map>("msgpack map layout", obj, iterations, json_encode, json_decode);
+    run_msgpack<::krrs::msgpack::layout::array>("msgpack array layout", obj, iterations, json_encode, json_decode);
+    std::printf("\n");
+}
+
+} // namespace benchmarks
+
+int main()
+{
+    using namespace benchmarks;
+
+    const quote single{"AAPL", 9'223'372'036'854, 189.25, 189.27, 300, 1'200};
+    run_suite("single quote", single, 1'000'000);
+
+    depth_snapshot snapshot{.venue = "XNAS", .sequence = 77, .bids = {}, .asks = {}, .quotes = {}};
+    for (int i = 0; i != 50; ++i)
+    {
+        snapshot.bids.push_back(189.25 - static_cast<double>(i) / 100.0);
+        snapshot.asks.push_back(189.27 + static_cast<double>(i) / 100.0);
+        snapshot.quotes.push_back(quote{"SYM" + std::to_string(i), i, 100.0 + i / 8.0, 100.5 + i / 8.0, 100 * i, 50 * i});
+    }
+    run_suite("depth snapshot", snapshot, 20'000);
+}
@@ -0,0 +1,134 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#include "../include/reflect/numeric.hpp"
+#include "bench_common.hpp"
+
+#include <cstdint>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace benchmarks {
+
+template <typename T>
+std::vector<T> make_values(std::size_t count)
+{
+    std::vector<T> values;
+    values.reserve(count);
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        if constexpr (std::floating_point<T>)
+        {
+            // prices with a varying number of decimals
+            values.push_back(static_cast<T>(100.0 + static_cast<double>(i % 5'000) / 64.0 + static_cast<double>(i) * 1e-9));
+        }
+        else
+        {
+            values.push_back(static_cast<T>(i * 2'654'435'761u));
+        }
+    }
+    return values;
+}
+
+// every measured op formats (or parses) the whole batch, the reported figure is per value
+template <typename T>
+void run_suite(std::string_view label, std::size_t iterations)
+{
+    constexpr std::size_t batch = 1'000;
+    const std::vector<T> values = make_values<T>(batch);
+    std::printf("-- %.*s (ns/op is per %zu values)\n", static_cast<int>(label.size()), label.data(), batch);
+
+    std::ostringstream oss;
+    const result ostream_default = measure("ostringstream (default precision)", iterations, [&values, &oss] {
+        oss.str({});
+        for (const T value : values)
+        {
+            oss << value << ' ';
+        }
+        do_not_optimize(oss);
+        return values.size() * sizeof(T);
+    });
+
+    if constexpr (std::floating_point<T>)
+    {
+        measure("ostringstream (fixed, precision 3)", iterations, [&values, &oss] {
+            oss.str({});
+            for (const T value : values)
+            {
+                oss << std::fixed << std::setprecision(3) << value << ' ';
+            }
+            do_not_optimize(oss);
+            return values.size() * sizeof(T);
+        });
+
+        std::string buffer;
+        measure("numeric::append (fixed, precision 3)", iterations, [&values, &buffer] {
+            buffer.clear();
+            for (const T value : values)
+            {
+                ::krrs::reflect::numeric::append(buffer, value, 3);
+                buffer.push_back(' ');
+            }
+            do_not_optimize(buffer.data());
+            return values.size() * sizeof(T);
+        });
+    }
+
+    std::string buffer;
+    const result shortest = measure("numeric::append (shortest round-trip)", iterations, [&values, &buffer] {
+        buffer.clear();
+        for (const T value : values)
+        {
+            ::krrs::reflect::numeric::append(buffer, value);
+            buffer.push_back(' ');
+        }
+        do_not_optimize(buffer.data());
+        return values.size() * sizeof(T);
+    });
+    std::printf("formatting: %.1f ns/value -> %.1f ns/value (%.2fx)\n", ostream_default.ns_per_op / batch, shortest.ns_per_op / batch,
+                ostream_default.ns_per_op / shortest.ns_per_op);
+
+    // parse back what was just formatted
+    std::vector<std::string> texts;
+    for (const T value : values)
+    {
+        texts.push_back(::krrs::reflect::numeric::to_string(value));
+    }
+
+    const result istream = measure("istringstream", iterations, [&texts] {
+        T sum{};
+        for (const std::string& text : texts)
+        {
+            T value{};
+            std::istringstream iss{text};
+            iss >> value;
+            sum += value;
+        }
+        do_not_optimize(sum);
+        return texts.size() * sizeof(T);
+    });
+
+    const result parsed = measure("numeric::parse", iterations, [&texts] {
+        T sum{};
+        for (const std::string& text : texts)
+        {
+            sum += ::krrs::reflect::numeric::parse<T>(text).value_or(T{});
+        }
+        do_not_optimize(sum);
+        return texts.size() * sizeof(T);
+    });
+    std::printf("parsing: %.1f ns/value -> %.1f ns/value (%.2fx)\n\n", istream.ns_per_op / batch, parsed.ns_per_op / batch, istream.ns_per_op / parsed.ns_per_op);
+}
+
+} // namespace benchmarks
+
+int main()
+{
+    using namespace benchmarks;
+
+    run_suite<double>("double", 2'000);
+    run_suite<float>("float", 2'000);
+    run_suite<int64_t>("int64_t", 2'000);
+}
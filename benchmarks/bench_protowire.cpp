@@ -0,0 +1,93 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#include "../include/json/parser.hpp"
+#include "../include/protowire/convert.hpp"
+#include "bench_common.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace benchmarks {
+
+struct quote
+{
+    std::string symbol;
+    int64_t sequence;
+    double bid;
+    double ask;
+    int32_t bid_size;
+    int32_t ask_size;
+
+    REFLECT(quote, (), (symbol, sequence, bid, ask, bid_size, ask_size));
+};
+
+struct depth_snapshot
+{
+    std::string venue;
+    int64_t sequence;
+    std::vector<double> bids;
+    std::vector<double> asks;
+    std::vector<quote> quotes;
+
+    REFLECT(depth_snapshot, (), (venue, sequence, bids, asks, quotes));
+};
+
+template <typename T>
+void run_suite(std::string_view label, const T& obj, std::size_t iterations)
+{
+    const std::string json = ::krrs::json::convert_to_json(obj);
+    const std::string bytes = ::krrs::protowire::encode(obj);
+    std::printf("-- %.*s (json %zu bytes, protobuf %zu bytes, %.2fx smaller)\n", static_cast<int>(label.size()), label.data(), json.size(), bytes.size(),
+                static_cast<double>(json.size()) / static_cast<double>(bytes.size()));
+
+    // the buffer keeps its capacity, so encode does not allocate after the first iteration
+    std::string buffer;
+    const result json_encode = measure("json::convert_to_json", iterations, [&obj, &buffer] {
+        buffer.clear();
+        ::krrs::json::convert_to_json(obj, buffer);
+        do_not_optimize(buffer.data());
+        return buffer.size();
+    });
+    const result proto_encode = measure("protowire::encode", iterations, [&obj, &buffer] {
+        buffer.clear();
+        ::krrs::protowire::encode(obj, buffer);
+        do_not_optimize(buffer.data());
+        return buffer.size();
+    });
+    std::printf("encode speedup: %.2fx\n", json_encode.ns_per_op / proto_encode.ns_per_op);
+
+    const result json_decode = measure("json::convert_from_json", iterations, [&json] {
+        T decoded{};
+        ::krrs::json::convert_from_json(decoded, json);
+        do_not_optimize(decoded);
+        return json.size();
+    });
+    const result proto_decode = measure("protowire::decode", iterations, [&bytes] {
+        T decoded{};
+        ::krrs::protowire::decode(decoded, bytes);
+        do_not_optimize(decoded);
+        return bytes.size();
+    });
+    std::printf("decode speedup: %.2fx\n\n", json_decode.ns_per_op / proto_decode.ns_per_op);
+}
+
+} // namespace benchmarks
+
+int main()
+{
+    using namespace benchmarks;
+
+    const quote single{"AAPL", 9'223'372'036'854, 189.25, 189.27, 300, 1'200};
+    run_suite("single quote", single, 1'000'000);
+
+    depth_snapshot snapshot{.venue = "XNAS", .sequence = 77, .bids = {}, .asks = {}, .quotes = {}};
+    for (int i = 0; i != 50; ++i)
+    {
+        snapshot.bids.push_back(189.25 - static_cast<double>(i) / 100.0);
+        snapshot.asks.push_back(189.27 + static_cast<double>(i) / 100.0);
+        snapshot.quotes.push_back(quote{"SYM" + std::to_string(i), i, 100.0 + i / 8.0, 100.5 + i / 8.0, 100 * i, 50 * i});
+    }
+    run_suite("depth snapshot", snapshot, 20'000);
+}
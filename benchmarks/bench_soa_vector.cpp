@@ -0,0 +1,68 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#include "../include/reflect/soa_vector.hpp"
+#include "bench_common.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace benchmarks {
+
+// 64 bytes, a cache line per position of which the loop below reads 8
+struct position_info
+{
+    int64_t account;
+    int64_t instrument;
+    double bod_position;
+    double position;
+    double buy_quantity;
+    double sell_quantity;
+    double average_price;
+    double realized_pnl;
+
+    REFLECT(position_info, (), (account, instrument, bod_position, position, buy_quantity, sell_quantity, average_price, realized_pnl));
+};
+
+} // namespace benchmarks
+
+int main()
+{
+    using namespace benchmarks;
+
+    constexpr std::size_t count = 4'000'000;
+    std::vector<position_info> aos;
+    ::krrs::reflect::soa_vector<position_info> soa;
+    aos.reserve(count);
+    soa.reserve(count);
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        const auto value = static_cast<double>(i % 1000);
+        const position_info pos{static_cast<int64_t>(i % 97), static_cast<int64_t>(i), value, value + 1.0, value * 2.0, value, 100.0 + value, value / 3.0};
+        aos.push_back(pos);
+        soa.push_back(pos);
+    }
+    std::printf("-- %zu positions of %zu bytes\n", count, sizeof(position_info));
+
+    // net position across the book
+    const result aos_sum = measure("std::vector<T> sum position", 50, [&aos] {
+        double total = 0.0;
+        for (const position_info& pos : aos)
+        {
+            total += pos.position;
+        }
+        do_not_optimize(total);
+        return aos.size() * sizeof(double);
+    });
+    const result soa_sum = measure("soa_vector<T> sum column<position>", 50, [&soa] {
+        double total = 0.0;
+        for (const double position : soa.column<&position_info::position>())
+        {
+            total += position;
+        }
+        do_not_optimize(total);
+        return soa.size() * sizeof(double);
+    });
+    std::printf("soa speedup: %.2fx\n", aos_sum.ns_per_op / soa_sum.ns_per_op);
+}
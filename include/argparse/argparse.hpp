@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "../reflect/perfect_hash.hpp"
 #include "../reflect/reflect.hpp"
 #include "concepts.hpp"
 #include "convertors.hpp"
@@ -81,26 +82,46 @@ constexpr T parse_args(int argc, const char* argv[])
 
     const std::vector<std::string_view> vectorized_args{argv, argv + argc};
 
+    static constexpr auto& lookup = ::krrs::reflect::member_lookup<T>;
+    static constexpr std::size_t member_count = ::krrs::reflect::generate_meta_info<T>().size();
+
+    // single pass over the arguments, each flag is resolved to its member through the perfect hash.
+    // only the first occurrence of a flag is considered, 0 (the program name) marks a flag that was not found.
+    // duplicated names resolve to the first member with that name
+    std::array<std::size_t, member_count> flag_positions{};
+    for (std::size_t pos = 1; pos != vectorized_args.size(); ++pos)
+    {
+        // TODO: Support for short form? (e.g. -c for --config)
+        if (!vectorized_args[pos].starts_with("--"))
+        {
+            continue;
+        }
+
+        if (const std::size_t index = lookup.find(vectorized_args[pos].substr(2)); index != lookup.npos && flag_positions[index] == 0)
+        {
+            flag_positions[index] = pos;
+        }
+    }
+
     // TODO: use inplace_vector from C++26
-    std::array<detail::arg_supplied_info, ::krrs::reflect::generate_meta_info<T>().size()> args_supplied;
+    std::array<detail::arg_supplied_info, member_count> args_supplied;
 
     T parsed{};
 
-    ::krrs::reflect::for_each<T>([&parsed, &vectorized_args, &args_supplied, i = 0]<typename Descriptor>() mutable {
+    ::krrs::reflect::for_each<T>([&parsed, &vectorized_args, &args_supplied, &flag_positions, i = 0]<typename Descriptor>() mutable {
         using member_type = Descriptor::member_type;
         auto& member_variable = ::krrs::reflect::get_member_variable<Descriptor>(parsed);
 
         detail::arg_supplied_info info{Descriptor::name, detail::has_default_value(member_variable)};
 
-        auto iter = std::ranges::find_if(vectorized_args, [](std::string_view arg) {
-            // TODO: Support for short form? (e.g. -c for --config)
-            return arg.starts_with("--") && arg.substr(2) == Descriptor::name;
-        });
+        // a member hiding a base class member shares its flag, and both take the value as before
+        constexpr std::size_t flag_index = ::krrs::reflect::member_lookup<T>.find(Descriptor::name);
+        const std::size_t pos = flag_positions[flag_index];
 
         // conditional check here ensures that the corresponding value is legitimate
-        if (iter != vectorized_args.end() && iter + 1 != vectorized_args.end() && !(iter + 1)->starts_with("--"))
+        if (pos != 0 && pos + 1 != vectorized_args.size() && !vectorized_args[pos + 1].starts_with("--"))
         {
-            const std::string_view value = *(iter + 1);
+            const std::string_view value = vectorized_args[pos + 1];
 
             if (const auto result = convertors::parse_value<member_type>(value); result.has_value())
             {
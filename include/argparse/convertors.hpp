@@ -4,6 +4,7 @@
 #pragma once
 
 #include "../reflect/concepts.hpp"
+#include "../reflect/numeric.hpp"
 #include "concepts.hpp"
 
 #include <optional>
@@ -25,14 +26,26 @@ template <typename T>
     requires(std::integral<T> || std::floating_point<T>)
 constexpr std::optional<T> parse_value(std::string_view value)
 {
-    T val{};
-    std::istringstream iss{std::string{value}}; // C++26 allows for implicit conversion
-    // TODO: float / int are compatible, do we want to restrict this?
-    if (!(iss >> val))
+    if constexpr (::krrs::reflect::numeric::number<T>)
     {
-        return std::nullopt;
+        // the whole argument has to be a number of type T, i.e. "3.5" is no longer truncated into an int
+        const std::size_t first = value.find_first_not_of(' ');
+        if (first == std::string_view::npos)
+        {
+            return std::nullopt;
+        }
+        return ::krrs::reflect::numeric::parse<T>(value.substr(first, value.find_last_not_of(' ') + 1 - first));
+    }
+    else
+    {
+        T val{};
+        std::istringstream iss{std::string{value}}; // C++26 allows for implicit conversion
+        if (!(iss >> val))
+        {
+            return std::nullopt;
+        }
+        return val;
     }
-    return val;
 }
 
 template <>
@@ -0,0 +1,68 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <bit>
+#include <concepts>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace krrs::binary::concepts {
+
+namespace detail {
+
+template <typename T>
+struct is_optional : std::false_type
+{
+};
+
+template <typename... Args>
+struct is_optional<std::optional<Args...>> : std::true_type
+{
+};
+
+template <typename>
+struct is_vector : std::false_type
+{
+};
+
+template <typename... Args>
+struct is_vector<std::vector<Args...>> : std::true_type
+{
+};
+
+template <typename>
+struct is_unordered_map : std::false_type
+{
+};
+
+template <typename... Args>
+struct is_unordered_map<std::unordered_map<Args...>> : std::true_type
+{
+};
+
+} // namespace detail
+
+template <typename T>
+concept same_as_vector = detail::is_vector<std::remove_cvref_t<T>>::value;
+
+template <typename T>
+concept same_as_unordered_map = detail::is_unordered_map<std::remove_cvref_t<T>>::value;
+
+template <typename T>
+concept same_as_optional = detail::is_optional<std::remove_cvref_t<T>>::value;
+
+// written as fixed-width little-endian bytes
+template <typename T>
+concept scalar = std::is_arithmetic_v<T> && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+// elements whose wire form is exactly their in-memory form, so a whole array of them is copied with one memcpy.
+// bool is left out, any byte other than 0 / 1 would have to be rejected on the way in
+template <typename T>
+concept bulk_copyable = std::endian::native == std::endian::little
+                        && ((scalar<T> && !std::same_as<T, bool>) || (std::is_enum_v<T> && scalar<std::underlying_type_t<T>> && !std::same_as<std::underlying_type_t<T>, bool>));
+
+} // namespace krrs::binary::concepts
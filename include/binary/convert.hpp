@@ -0,0 +1,261 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "../../include/reflect/reflect.hpp"
+#include "concepts.hpp"
+#include "decoder.hpp"
+#include "encoder.hpp"
+#include "size.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace krrs::binary {
+
+template <::krrs::reflect::concepts::reflectable T, typename Sink>
+void encode(const T& obj, basic_encoder<Sink>& e);
+
+template <::krrs::reflect::concepts::reflectable T>
+void decode(T& obj, decoder& d);
+
+namespace internal {
+
+template <typename Sink, typename T>
+void write_value(basic_encoder<Sink>& e, const T& value)
+{
+    if constexpr (::krrs::reflect::concepts::reflectable<T>)
+    {
+        encode(value, e);
+    }
+    else if constexpr (concepts::same_as_vector<T> || ::krrs::reflect::concepts::same_as_array_type<T>)
+    {
+        // std::array has its length in the type, only vectors carry a prefix
+        if constexpr (concepts::same_as_vector<T>)
+        {
+            e.write_varint(value.size());
+        }
+
+        if constexpr (concepts::bulk_copyable<typename T::value_type>)
+        {
+            e.write_borrowed_bytes(reinterpret_cast<const char*>(value.data()), value.size() * sizeof(typename T::value_type));
+        }
+        else
+        {
+            for (const auto& elem : value)
+            {
+                write_value(e, elem);
+            }
+        }
+    }
+    else if constexpr (concepts::same_as_unordered_map<T>)
+    {
+        e.write_varint(value.size());
+        for (const auto& [key, elem] : value)
+        {
+            write_value(e, key);
+            write_value(e, elem);
+        }
+    }
+    else if constexpr (concepts::same_as_optional<T>)
+    {
+        e.write_scalar(value.has_value());
+        if (value.has_value())
+        {
+            write_value(e, *value);
+        }
+    }
+    else if constexpr (std::is_enum_v<T>)
+    {
+        e.write_scalar(std::to_underlying(value));
+    }
+    else if constexpr (concepts::scalar<T>)
+    {
+        e.write_scalar(value);
+    }
+    else
+    {
+        static_assert(std::convertible_to<const T&, std::string_view>, "binary::encode: type is not binary serializable!");
+        // borrowed, see io::write_borrowed
+        const std::string_view str{value};
+        e.write_varint(str.size());
+        e.write_borrowed_bytes(str.data(), str.size());
+    }
+}
+
+template <typename T>
+void read_value(decoder& d, T& value)
+{
+    if constexpr (::krrs::reflect::concepts::reflectable<T>)
+    {
+        decode(value, d);
+    }
+    else if constexpr (concepts::same_as_vector<T>)
+    {
+        using value_type = typename T::value_type;
+        const std::size_t size = d.read_length(min_encoded_size<value_type>());
+        if constexpr (concepts::bulk_copyable<value_type>)
+        {
+            value.resize(size);
+            std::memcpy(value.data(), d.read_bytes(size * sizeof(value_type)).data(), size * sizeof(value_type));
+        }
+        else if constexpr (std::same_as<value_type, bool>)
+        {
+            // std::vector<bool> hands out proxies, not bool&
+            value.clear();
+            value.resize(size);
+            for (std::size_t i = 0; i != size; ++i)
+            {
+                bool elem = false;
+                read_value(d, elem);
+                value[i] = elem;
+            }
+        }
+        else
+        {
+            value.clear();
+            value.resize(size);
+            for (auto& elem : value)
+            {
+                read_value(d, elem);
+            }
+        }
+    }
+    else if constexpr (::krrs::reflect::concepts::same_as_array_type<T>)
+    {
+        if constexpr (concepts::bulk_copyable<typename T::value_type>)
+        {
+            std::memcpy(value.data(), d.read_bytes(sizeof(value)).data(), sizeof(value));
+        }
+        else
+        {
+            for (auto& elem : value)
+            {
+                read_value(d, elem);
+            }
+        }
+    }
+    else if constexpr (concepts::same_as_unordered_map<T>)
+    {
+        using key_type = typename T::key_type;
+        using mapped_type = typename T::mapped_type;
+
+        value.clear();
+        const std::size_t size = d.read_length(min_encoded_size<key_type>() + min_encoded_size<mapped_type>());
+        value.reserve(size);
+        for (std::size_t i = 0; i != size; ++i)
+        {
+            key_type key{};
+            read_value(d, key);
+            mapped_type elem{};
+            read_value(d, elem);
+            value.insert_or_assign(std::move(key), std::move(elem));
+        }
+    }
+    else if constexpr (concepts::same_as_optional<T>)
+    {
+        if (d.read_scalar<bool>())
+        {
+            read_value(d, value.emplace());
+        }
+        else
+        {
+            value.reset();
+        }
+    }
+    else if constexpr (std::is_enum_v<T>)
+    {
+        value = static_cast<T>(d.read_scalar<std::underlying_type_t<T>>());
+    }
+    else if constexpr (concepts::scalar<T>)
+    {
+        value = d.read_scalar<T>();
+    }
+    else
+    {
+        static_assert(std::same_as<T, std::string>, "binary::decode: type is not binary deserializable, non-owning strings would dangle!");
+        value.assign(d.read_bytes(d.read_length()));
+    }
+}
+
+} // namespace internal
+
+// members are written back to back in for_each order, with no keys or tags in between
+template <::krrs::reflect::concepts::reflectable T, typename Sink>
+void encode(const T& obj, basic_encoder<Sink>& e)
+{
+    ::krrs::reflect::for_each<T>([&e, &obj]<typename Descriptor>() {
+        if constexpr (!std::is_function_v<typename Descriptor::member_type>)
+        {
+            internal::write_value(e, ::krrs::reflect::get_member_variable<Descriptor>(obj));
+        }
+    });
+}
+
+// writes straight to out, e.g. an io::fd_sink. large strings and arrays of obj may be handed to the sink without
+// being copied, they are released before this returns
+template <::krrs::reflect::concepts::reflectable T, io::sink Sink>
+void encode(const T& obj, Sink& out)
+{
+    basic_encoder e{out};
+    e.reserve(encoded_size(obj));
+    encode(obj, e);
+    io::release_borrowed(out);
+}
+
+// appends the encoded object to the end of out, reserving exactly once
+template <::krrs::reflect::concepts::reflectable T>
+void encode(const T& obj, std::string& out)
+{
+    io::string_sink sink{out};
+    encode(obj, sink);
+}
+
+template <::krrs::reflect::concepts::reflectable T>
+std::string encode(const T& obj)
+{
+    std::string out;
+    encode(obj, out);
+    return out;
+}
+
+// every member is overwritten, the wire form has no way to leave one out
+template <::krrs::reflect::concepts::reflectable T>
+void decode(T& obj, decoder& d)
+{
+    ::krrs::reflect::for_each<T>([&d, &obj]<typename Descriptor>() {
+        if constexpr (!std::is_function_v<typename Descriptor::member_type>)
+        {
+            internal::read_value(d, ::krrs::reflect::get_member_variable<Descriptor>(obj));
+        }
+    });
+}
+
+// bytes has to hold exactly one encoded T
+template <::krrs::reflect::concepts::reflectable T>
+void decode(T& obj, std::string_view bytes)
+{
+    decoder d{bytes};
+    decode(obj, d);
+    if (!d.at_end())
+    {
+        throw std::runtime_error{"unexpected trailing bytes at offset " + std::to_string(d.position())};
+    }
+}
+
+template <::krrs::reflect::concepts::reflectable T>
+T decode(std::string_view bytes)
+{
+    T obj{};
+    decode(obj, bytes);
+    return obj;
+}
+
+} // namespace krrs::binary
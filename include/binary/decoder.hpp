@@ -0,0 +1,108 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "encoder.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace krrs::binary {
+
+// forward-only cursor over the binary wire form. the input is never copied, every read is bounds checked
+// and running out of input throws std::runtime_error
+class decoder
+{
+public:
+    explicit decoder(std::string_view input) noexcept
+        : input_{input}
+    {
+    }
+
+    template <concepts::scalar T>
+    T read_scalar()
+    {
+        if constexpr (std::same_as<T, bool>)
+        {
+            const char byte = read_bytes(1)[0];
+            if (byte != '\0' && byte != '\1')
+            {
+                throw std::runtime_error{"invalid bool at offset " + std::to_string(pos_ - 1)};
+            }
+            return byte == '\1';
+        }
+        else
+        {
+            T wire;
+            std::memcpy(&wire, read_bytes(sizeof(T)).data(), sizeof(T));
+            return internal::swap_to_little_endian(wire);
+        }
+    }
+
+    std::uint64_t read_varint()
+    {
+        const std::size_t start = pos_;
+        std::uint64_t value = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7)
+        {
+            const auto byte = static_cast<unsigned char>(read_bytes(1)[0]);
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+            {
+                return value;
+            }
+        }
+        throw std::runtime_error{"varint longer than 10 bytes at offset " + std::to_string(start)};
+    }
+
+    // a length prefix, checked against what is left of the input so a corrupt length fails here rather than
+    // in an allocation. element_size is the fewest bytes each of the counted elements can take
+    std::size_t read_length(std::size_t element_size = 1)
+    {
+        const std::size_t start = pos_;
+        const std::uint64_t length = read_varint();
+        if (element_size != 0 && length > remaining() / element_size)
+        {
+            throw std::runtime_error{"length " + std::to_string(length) + " at offset " + std::to_string(start) + " runs past the end of the input"};
+        }
+        return static_cast<std::size_t>(length);
+    }
+
+    // the next size bytes, pointing into the input
+    std::string_view read_bytes(std::size_t size)
+    {
+        if (size > remaining())
+        {
+            throw std::runtime_error{"unexpected end of input at offset " + std::to_string(pos_) + ", " + std::to_string(size) + " more bytes expected"};
+        }
+        const std::string_view bytes = input_.substr(pos_, size);
+        pos_ += size;
+        return bytes;
+    }
+
+    std::size_t remaining() const noexcept
+    {
+        return input_.size() - pos_;
+    }
+
+    bool at_end() const noexcept
+    {
+        return pos_ == input_.size();
+    }
+
+    std::size_t position() const noexcept
+    {
+        return pos_;
+    }
+
+private:
+    std::string_view input_;
+    std::size_t pos_ = 0;
+};
+
+} // namespace krrs::binary
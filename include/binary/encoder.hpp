@@ -0,0 +1,153 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "../../include/io/sink.hpp"
+#include "concepts.hpp"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace krrs::binary {
+
+namespace internal {
+
+template <std::size_t Size>
+struct unsigned_of_size;
+
+template <>
+struct unsigned_of_size<1>
+{
+    using type = std::uint8_t;
+};
+
+template <>
+struct unsigned_of_size<2>
+{
+    using type = std::uint16_t;
+};
+
+template <>
+struct unsigned_of_size<4>
+{
+    using type = std::uint32_t;
+};
+
+template <>
+struct unsigned_of_size<8>
+{
+    using type = std::uint64_t;
+};
+
+// the same bits with the byte order flipped on big-endian hosts, i.e. the bytes of the little-endian wire form
+template <concepts::scalar T>
+T swap_to_little_endian(T value) noexcept
+{
+    if constexpr (std::endian::native == std::endian::little || sizeof(T) == 1)
+    {
+        return value;
+    }
+    else
+    {
+        using bits_type = typename unsigned_of_size<sizeof(T)>::type;
+        return std::bit_cast<T>(std::byteswap(std::bit_cast<bits_type>(value)));
+    }
+}
+
+// an unsigned leb128 varint never takes more than 10 bytes
+inline constexpr std::size_t max_varint_size = 10;
+
+constexpr std::size_t varint_size(std::uint64_t value) noexcept
+{
+    std::size_t size = 1;
+    while (value >= 0x80)
+    {
+        value >>= 7;
+        ++size;
+    }
+    return size;
+}
+
+} // namespace internal
+
+// writes the binary wire form to an io::sink: fixed-width little-endian scalars and leb128 varint lengths.
+// Sink is held by value, see io::sink
+template <typename Sink>
+    requires io::sink<std::remove_reference_t<Sink>>
+class basic_encoder
+{
+public:
+    explicit basic_encoder(Sink sink) noexcept(std::is_nothrow_move_constructible_v<Sink>)
+        : sink_{std::forward<Sink>(sink)}
+    {
+    }
+
+    template <concepts::scalar T>
+    void write_scalar(T value)
+    {
+        if constexpr (std::same_as<T, bool>)
+        {
+            sink_.put(value ? '\1' : '\0');
+        }
+        else
+        {
+            const T wire = internal::swap_to_little_endian(value);
+            char bytes[sizeof(T)];
+            std::memcpy(bytes, &wire, sizeof(T));
+            sink_.write(bytes, sizeof(T));
+        }
+    }
+
+    void write_varint(std::uint64_t value)
+    {
+        std::array<char, internal::max_varint_size> bytes;
+        std::size_t size = 0;
+        while (value >= 0x80)
+        {
+            bytes[size++] = static_cast<char>((value & 0x7F) | 0x80);
+            value >>= 7;
+        }
+        bytes[size++] = static_cast<char>(value);
+        sink_.write(bytes.data(), size);
+    }
+
+    void write_bytes(const char* data, std::size_t size)
+    {
+        sink_.write(data, size);
+    }
+
+    // the sink may keep pointing into data instead of copying it (see io::write_borrowed), so data has to outlive
+    // the encode. used for strings and bulk arrays of the object being encoded
+    void write_borrowed_bytes(const char* data, std::size_t size)
+    {
+        io::write_borrowed(sink_, data, size);
+    }
+
+    void reserve(std::size_t additional)
+    {
+        io::reserve(sink_, additional);
+    }
+
+    std::remove_reference_t<Sink>& sink() noexcept
+    {
+        return sink_;
+    }
+
+private:
+    Sink sink_;
+};
+
+template <typename Sink>
+basic_encoder(Sink&) -> basic_encoder<Sink&>;
+
+// appends in place to a caller-owned std::string
+using encoder = basic_encoder<io::string_sink>;
+
+} // namespace krrs::binary
@@ -0,0 +1,495 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "../../include/reflect/perfect_hash.hpp"
+#include "../../include/reflect/reflect.hpp"
+#include "convert.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace krrs::binary {
+
+// the shape of an encoded value, written once per stream so a reader built against another version of the type
+// can still find its way through the untagged records
+enum class schema_kind : std::uint8_t
+{
+    boolean,
+    character,
+    signed_integer,
+    unsigned_integer,
+    floating_point,
+    string,
+    sequence,
+    array,
+    optional,
+    map,
+    record,
+};
+
+// one node of a schema read back from a stream. scalars carry their width, arrays their length, records the name
+// of every field. children holds the element type(s), or one node per record field
+struct schema_node
+{
+    schema_kind kind = schema_kind::record;
+    std::uint8_t size = 0;
+    std::uint64_t count = 0;
+    std::vector<std::string> names;
+    std::vector<schema_node> children;
+};
+
+namespace internal {
+
+template <typename T>
+consteval schema_kind kind_of()
+{
+    if constexpr (std::is_enum_v<T>)
+    {
+        return kind_of<std::underlying_type_t<T>>();
+    }
+    else if constexpr (std::same_as<T, bool>)
+    {
+        return schema_kind::boolean;
+    }
+    else if constexpr (std::same_as<T, char>)
+    {
+        return schema_kind::character;
+    }
+    else if constexpr (std::floating_point<T>)
+    {
+        return schema_kind::floating_point;
+    }
+    else
+    {
+        return std::is_signed_v<T> ? schema_kind::signed_integer : schema_kind::unsigned_integer;
+    }
+}
+
+// writes the schema of T, in the same order encode writes its values
+template <typename T, typename Sink>
+void describe(basic_encoder<Sink>& e)
+{
+    const auto write_kind = [&e](schema_kind kind) { e.write_scalar(static_cast<std::uint8_t>(kind)); };
+
+    if constexpr (::krrs::reflect::concepts::reflectable<T>)
+    {
+        std::size_t count = 0;
+        ::krrs::reflect::for_each<T>([&count]<typename Descriptor>() { count += std::is_function_v<typename Descriptor::member_type> ? 0 : 1; });
+
+        write_kind(schema_kind::record);
+        e.write_varint(count);
+        ::krrs::reflect::for_each<T>([&e]<typename Descriptor>() {
+            if constexpr (!std::is_function_v<typename Descriptor::member_type>)
+            {
+                e.write_varint(Descriptor::name.size());
+                e.write_bytes(Descriptor::name.data(), Descriptor::name.size());
+                describe<typename Descriptor::member_type>(e);
+            }
+        });
+    }
+    else if constexpr (concepts::same_as_vector<T>)
+    {
+        write_kind(schema_kind::sequence);
+        describe<typename T::value_type>(e);
+    }
+    else if constexpr (::krrs::reflect::concepts::same_as_array_type<T>)
+    {
+        write_kind(schema_kind::array);
+        e.write_varint(std::tuple_size_v<T>);
+        describe<typename T::value_type>(e);
+    }
+    else if constexpr (concepts::same_as_optional<T>)
+    {
+        write_kind(schema_kind::optional);
+        describe<typename T::value_type>(e);
+    }
+    else if constexpr (concepts::same_as_unordered_map<T>)
+    {
+        write_kind(schema_kind::map);
+        describe<typename T::key_type>(e);
+        describe<typename T::mapped_type>(e);
+    }
+    else if constexpr (concepts::scalar<T> || std::is_enum_v<T>)
+    {
+        write_kind(kind_of<T>());
+        e.write_scalar(static_cast<std::uint8_t>(sizeof(T)));
+    }
+    else
+    {
+        static_assert(std::convertible_to<const T&, std::string_view>, "binary::describe: type is not binary serializable!");
+        write_kind(schema_kind::string);
+    }
+}
+
+// nested deeper than this is treated as corrupt input rather than risking the stack
+inline constexpr std::size_t max_schema_depth = 64;
+
+inline schema_node parse_schema(decoder& d, std::size_t depth = 0)
+{
+    if (depth == max_schema_depth)
+    {
+        throw std::runtime_error{"schema nested deeper than " + std::to_string(max_schema_depth) + " levels"};
+    }
+
+    schema_node node;
+    const auto kind = d.read_scalar<std::uint8_t>();
+    if (kind > static_cast<std::uint8_t>(schema_kind::record))
+    {
+        throw std::runtime_error{"unknown schema kind " + std::to_string(kind) + " at offset " + std::to_string(d.position() - 1)};
+    }
+    node.kind = static_cast<schema_kind>(kind);
+
+    switch (node.kind)
+    {
+    case schema_kind::boolean:
+    case schema_kind::character:
+    case schema_kind::signed_integer:
+    case schema_kind::unsigned_integer:
+    case schema_kind::floating_point:
+        node.size = d.read_scalar<std::uint8_t>();
+        if (node.size != 1 && node.size != 2 && node.size != 4 && node.size != 8)
+        {
+            throw std::runtime_error{"invalid scalar width " + std::to_string(node.size) + " at offset " + std::to_string(d.position() - 1)};
+        }
+        break;
+    case schema_kind::string:
+        break;
+    case schema_kind::array:
+        node.count = d.read_varint();
+        [[fallthrough]];
+    case schema_kind::sequence:
+    case schema_kind::optional:
+        node.children.push_back(parse_schema(d, depth + 1));
+        break;
+    case schema_kind::map:
+        node.children.push_back(parse_schema(d, depth + 1));
+        node.children.push_back(parse_schema(d, depth + 1));
+        break;
+    case schema_kind::record:
+    {
+        // a field takes at least a name length and a kind
+        const std::size_t count = d.read_length(2);
+        node.names.reserve(count);
+        node.children.reserve(count);
+        for (std::size_t i = 0; i != count; ++i)
+        {
+            node.names.emplace_back(d.read_bytes(d.read_length()));
+            node.children.push_back(parse_schema(d, depth + 1));
+        }
+        break;
+    }
+    }
+    return node;
+}
+
+// the fewest bytes a value with the schema of node takes, see internal::min_encoded_size
+inline std::size_t min_encoded_size(const schema_node& node) noexcept
+{
+    switch (node.kind)
+    {
+    case schema_kind::boolean:
+    case schema_kind::character:
+    case schema_kind::signed_integer:
+    case schema_kind::unsigned_integer:
+    case schema_kind::floating_point:
+        return node.size;
+    case schema_kind::array:
+        // the count comes from the stream as well, one byte is a safe lower bound that cannot overflow
+        return node.count > 0 && min_encoded_size(node.children[0]) > 0 ? 1 : 0;
+    case schema_kind::record:
+    {
+        std::size_t size = 0;
+        for (const schema_node& field : node.children)
+        {
+            size += min_encoded_size(field);
+        }
+        return size;
+    }
+    default:
+        return 1;
+    }
+}
+
+// steps over a value written with the schema of node
+inline void skip_value(decoder& d, const schema_node& node)
+{
+    switch (node.kind)
+    {
+    case schema_kind::boolean:
+    case schema_kind::character:
+    case schema_kind::signed_integer:
+    case schema_kind::unsigned_integer:
+    case schema_kind::floating_point:
+        d.read_bytes(node.size);
+        break;
+    case schema_kind::string:
+        d.read_bytes(d.read_length());
+        break;
+    case schema_kind::sequence:
+    case schema_kind::array:
+    {
+        const std::size_t element_size = min_encoded_size(node.children[0]);
+        const std::size_t count = node.kind == schema_kind::array ? static_cast<std::size_t>(node.count) : d.read_length(element_size);
+        // elements that take no bytes leave nothing to skip
+        for (std::size_t i = 0; element_size != 0 && i != count; ++i)
+        {
+            skip_value(d, node.children[0]);
+        }
+        break;
+    }
+    case schema_kind::optional:
+        if (d.read_scalar<bool>())
+        {
+            skip_value(d, node.children[0]);
+        }
+        break;
+    case schema_kind::map:
+    {
+        const std::size_t count = d.read_length(min_encoded_size(node.children[0]) + min_encoded_size(node.children[1]));
+        for (std::size_t i = 0; i != count; ++i)
+        {
+            skip_value(d, node.children[0]);
+            skip_value(d, node.children[1]);
+        }
+        break;
+    }
+    case schema_kind::record:
+        for (const schema_node& field : node.children)
+        {
+            skip_value(d, field);
+        }
+        break;
+    }
+}
+
+[[noreturn]] inline void schema_mismatch(std::string_view expected, const schema_node& node)
+{
+    throw std::runtime_error{"schema mismatch: expected " + std::string{expected} + ", stream has schema kind " + std::to_string(static_cast<int>(node.kind))};
+}
+
+inline std::int64_t read_signed(decoder& d, std::uint8_t size)
+{
+    switch (size)
+    {
+    case 1:
+        return d.read_scalar<std::int8_t>();
+    case 2:
+        return d.read_scalar<std::int16_t>();
+    case 4:
+        return d.read_scalar<std::int32_t>();
+    default:
+        return d.read_scalar<std::int64_t>();
+    }
+}
+
+inline std::uint64_t read_unsigned(decoder& d, std::uint8_t size)
+{
+    switch (size)
+    {
+    case 1:
+        return d.read_scalar<std::uint8_t>();
+    case 2:
+        return d.read_scalar<std::uint16_t>();
+    case 4:
+        return d.read_scalar<std::uint32_t>();
+    default:
+        return d.read_scalar<std::uint64_t>();
+    }
+}
+
+template <typename T, typename V>
+T narrow(V value)
+{
+    if constexpr (std::integral<T>)
+    {
+        if (!std::in_range<T>(value))
+        {
+            throw std::runtime_error{"schema mismatch: " + std::to_string(value) + " does not fit the member's integer type"};
+        }
+    }
+    return static_cast<T>(value);
+}
+
+// a scalar written with the schema of node, converted to T. integers may change width as long as the value fits,
+// and integers may be read into floating point members, anything else is a mismatch
+template <typename T>
+T read_scalar_as(decoder& d, const schema_node& node)
+{
+    if constexpr (std::same_as<T, bool> || std::same_as<T, char>)
+    {
+        if (node.kind != kind_of<T>())
+        {
+            schema_mismatch(std::same_as<T, bool> ? "bool" : "char", node);
+        }
+        return d.read_scalar<T>();
+    }
+    else
+    {
+        switch (node.kind)
+        {
+        case schema_kind::signed_integer:
+            return narrow<T>(read_signed(d, node.size));
+        case schema_kind::unsigned_integer:
+            return narrow<T>(read_unsigned(d, node.size));
+        case schema_kind::floating_point:
+            if constexpr (std::floating_point<T>)
+            {
+                return node.size == 4 ? static_cast<T>(d.read_scalar<float>()) : static_cast<T>(d.read_scalar<double>());
+            }
+            else
+            {
+                schema_mismatch("an integer", node);
+            }
+        default:
+            schema_mismatch("a number", node);
+        }
+    }
+}
+
+template <typename T>
+void read_tagged(decoder& d, const schema_node& node, T& value);
+
+// jump table entry, reads the next field into the member described by Descriptor
+template <typename T>
+struct tagged_member_reader
+{
+    template <typename Descriptor>
+    static void invoke(T& obj, decoder& d, const schema_node& node)
+    {
+        if constexpr (std::is_function_v<typename Descriptor::member_type>)
+        {
+            skip_value(d, node);
+        }
+        else
+        {
+            read_tagged(d, node, ::krrs::reflect::get_member_variable<Descriptor>(obj));
+        }
+    }
+};
+
+// reads a value written with the schema of node into value. record fields are matched by name, fields the reader
+// does not know are skipped and members the writer did not have keep their value
+template <typename T>
+void read_tagged(decoder& d, const schema_node& node, T& value)
+{
+    if constexpr (::krrs::reflect::concepts::reflectable<T>)
+    {
+        static constexpr auto& lookup = ::krrs::reflect::member_lookup<T>;
+        static constexpr auto readers = ::krrs::reflect::make_jump_table<T, void(T&, decoder&, const schema_node&), tagged_member_reader<T>>();
+
+        if (node.kind != schema_kind::record)
+        {
+            schema_mismatch("a record", node);
+        }
+        for (std::size_t i = 0; i != node.children.size(); ++i)
+        {
+            if (const std::size_t index = lookup.find(node.names[i]); index != lookup.npos)
+            {
+                readers[index](value, d, node.children[i]);
+            }
+            else
+            {
+                skip_value(d, node.children[i]);
+            }
+        }
+    }
+    else if constexpr (concepts::same_as_vector<T>)
+    {
+        if (node.kind != schema_kind::sequence)
+        {
+            schema_mismatch("a sequence", node);
+        }
+        value.clear();
+        value.resize(d.read_length(min_encoded_size(node.children[0])));
+        if constexpr (std::same_as<typename T::value_type, bool>)
+        {
+            // std::vector<bool> hands out proxies, not bool&
+            for (std::size_t i = 0; i != value.size(); ++i)
+            {
+                bool elem = false;
+                read_tagged(d, node.children[0], elem);
+                value[i] = elem;
+            }
+        }
+        else
+        {
+            for (auto& elem : value)
+            {
+                read_tagged(d, node.children[0], elem);
+            }
+        }
+    }
+    else if constexpr (::krrs::reflect::concepts::same_as_array_type<T>)
+    {
+        if (node.kind != schema_kind::array || node.count != std::tuple_size_v<T>)
+        {
+            schema_mismatch("an array of " + std::to_string(std::tuple_size_v<T>), node);
+        }
+        for (auto& elem : value)
+        {
+            read_tagged(d, node.children[0], elem);
+        }
+    }
+    else if constexpr (concepts::same_as_optional<T>)
+    {
+        if (node.kind != schema_kind::optional)
+        {
+            schema_mismatch("an optional", node);
+        }
+        if (d.read_scalar<bool>())
+        {
+            read_tagged(d, node.children[0], value.emplace());
+        }
+        else
+        {
+            value.reset();
+        }
+    }
+    else if constexpr (concepts::same_as_unordered_map<T>)
+    {
+        if (node.kind != schema_kind::map)
+        {
+            schema_mismatch("a map", node);
+        }
+        value.clear();
+        const std::size_t count = d.read_length(min_encoded_size(node.children[0]) + min_encoded_size(node.children[1]));
+        for (std::size_t i = 0; i != count; ++i)
+        {
+            typename T::key_type key{};
+            read_tagged(d, node.children[0], key);
+            typename T::mapped_type elem{};
+            read_tagged(d, node.children[1], elem);
+            value.insert_or_assign(std::move(key), std::move(elem));
+        }
+    }
+    else if constexpr (std::is_enum_v<T>)
+    {
+        value = static_cast<T>(read_scalar_as<std::underlying_type_t<T>>(d, node));
+    }
+    else if constexpr (concepts::scalar<T>)
+    {
+        value = read_scalar_as<T>(d, node);
+    }
+    else
+    {
+        static_assert(std::same_as<T, std::string>, "binary::decode: type is not binary deserializable, non-owning strings would dangle!");
+        if (node.kind != schema_kind::string)
+        {
+            schema_mismatch("a string", node);
+        }
+        value.assign(d.read_bytes(d.read_length()));
+    }
+}
+
+} // namespace internal
+
+} // namespace krrs::binary
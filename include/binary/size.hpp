@@ -0,0 +1,200 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "../../include/reflect/reflect.hpp"
+#include "concepts.hpp"
+#include "encoder.hpp"
+
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace krrs::binary {
+
+namespace internal {
+
+template <typename T>
+consteval bool has_fixed_size();
+
+template <::krrs::reflect::concepts::reflectable T>
+consteval bool has_fixed_size_members()
+{
+    return []<std::size_t... Is>(std::index_sequence<Is...>) {
+        return (has_fixed_size<typename ::krrs::reflect::detail::meta_type_underlying_type<::krrs::reflect::generate_meta_info<T>()[Is]>::member_type>()
+                && ...);
+    }(std::make_index_sequence<::krrs::reflect::generate_meta_info<T>().size()>{});
+}
+
+template <typename T>
+consteval bool has_fixed_size()
+{
+    if constexpr (std::is_function_v<T>)
+    {
+        // member functions are not encoded
+        return true;
+    }
+    else if constexpr (::krrs::reflect::concepts::reflectable<T>)
+    {
+        return has_fixed_size_members<T>();
+    }
+    else if constexpr (::krrs::reflect::concepts::same_as_array_type<T> || concepts::same_as_optional<T>)
+    {
+        return has_fixed_size<typename T::value_type>();
+    }
+    else
+    {
+        return concepts::scalar<T> || std::is_enum_v<T>;
+    }
+}
+
+// the fewest bytes any value of T encodes to, lets the decoder reject impossible lengths up front
+template <typename T>
+consteval std::size_t min_encoded_size()
+{
+    if constexpr (std::is_function_v<T>)
+    {
+        return 0;
+    }
+    else if constexpr (::krrs::reflect::concepts::reflectable<T>)
+    {
+        return []<std::size_t... Is>(std::index_sequence<Is...>) {
+            return (std::size_t{0} + ... +
+                    min_encoded_size<typename ::krrs::reflect::detail::meta_type_underlying_type<::krrs::reflect::generate_meta_info<T>()[Is]>::member_type>());
+        }(std::make_index_sequence<::krrs::reflect::generate_meta_info<T>().size()>{});
+    }
+    else if constexpr (::krrs::reflect::concepts::same_as_array_type<T>)
+    {
+        return std::tuple_size_v<T> * min_encoded_size<typename T::value_type>();
+    }
+    else if constexpr (std::is_enum_v<T>)
+    {
+        return sizeof(T);
+    }
+    else if constexpr (concepts::scalar<T>)
+    {
+        return sizeof(T);
+    }
+    else
+    {
+        // a presence flag, or a length prefix
+        return 1;
+    }
+}
+
+} // namespace internal
+
+namespace concepts {
+
+// types whose encoded size has an upper bound known at compile time: scalars, enums, std::array and
+// std::optional of those, and reflected types made only of such members
+template <typename T>
+concept fixed_size = internal::has_fixed_size<std::remove_cvref_t<T>>();
+
+} // namespace concepts
+
+// the most bytes encode can produce for any value of T
+template <concepts::fixed_size T>
+consteval std::size_t max_encoded_size()
+{
+    if constexpr (std::is_function_v<T>)
+    {
+        return 0;
+    }
+    else if constexpr (::krrs::reflect::concepts::reflectable<T>)
+    {
+        std::size_t size = 0;
+        ::krrs::reflect::for_each<T>([&size]<typename Descriptor>() { size += max_encoded_size<typename Descriptor::member_type>(); });
+        return size;
+    }
+    else if constexpr (::krrs::reflect::concepts::same_as_array_type<T>)
+    {
+        return std::tuple_size_v<T> * max_encoded_size<typename T::value_type>();
+    }
+    else if constexpr (concepts::same_as_optional<T>)
+    {
+        return 1 + max_encoded_size<typename T::value_type>();
+    }
+    else
+    {
+        return sizeof(T);
+    }
+}
+
+namespace internal {
+
+// every value of T encodes to the same number of bytes
+template <typename T>
+consteval bool has_constant_size()
+{
+    if constexpr (concepts::fixed_size<T>)
+    {
+        return min_encoded_size<T>() == max_encoded_size<T>();
+    }
+    else
+    {
+        return false;
+    }
+}
+
+} // namespace internal
+
+// the exact number of bytes encode produces for value, one walk over its containers without encoding anything
+template <typename T>
+std::size_t encoded_size(const T& value)
+{
+    if constexpr (internal::has_constant_size<T>())
+    {
+        return max_encoded_size<T>();
+    }
+    else if constexpr (::krrs::reflect::concepts::reflectable<T>)
+    {
+        std::size_t size = 0;
+        ::krrs::reflect::for_each<T>([&size, &value]<typename Descriptor>() {
+            if constexpr (!std::is_function_v<typename Descriptor::member_type>)
+            {
+                size += encoded_size(::krrs::reflect::get_member_variable<Descriptor>(value));
+            }
+        });
+        return size;
+    }
+    else if constexpr (concepts::same_as_vector<T> || ::krrs::reflect::concepts::same_as_array_type<T>)
+    {
+        std::size_t size = concepts::same_as_vector<T> ? internal::varint_size(value.size()) : 0;
+        if constexpr (internal::has_constant_size<typename T::value_type>())
+        {
+            return size + value.size() * max_encoded_size<typename T::value_type>();
+        }
+        else
+        {
+            for (const auto& elem : value)
+            {
+                size += encoded_size(elem);
+            }
+            return size;
+        }
+    }
+    else if constexpr (concepts::same_as_unordered_map<T>)
+    {
+        std::size_t size = internal::varint_size(value.size());
+        for (const auto& [key, elem] : value)
+        {
+            size += encoded_size(key) + encoded_size(elem);
+        }
+        return size;
+    }
+    else if constexpr (concepts::same_as_optional<T>)
+    {
+        return 1 + (value.has_value() ? encoded_size(*value) : 0);
+    }
+    else
+    {
+        static_assert(std::convertible_to<const T&, std::string_view>, "encoded_size: type is not binary serializable!");
+        const std::string_view str{value};
+        return internal::varint_size(str.size()) + str.size();
+    }
+}
+
+} // namespace krrs::binary
@@ -0,0 +1,117 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "../../include/reflect/schema.hpp"
+#include "schema.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace krrs::binary {
+
+// a stream starts with a header, followed by records encoded back to back:
+//   8 bytes   reflect::schema_hash<T>() of the writer, little-endian
+//   varint    size of the schema description
+//   ...       the writer's schema, see internal::describe
+// a reader with the same fingerprint skips the description and decodes the records as is. any other reader
+// falls back to matching fields by name against the description
+template <::krrs::reflect::concepts::reflectable T, typename Sink>
+void write_stream_header(basic_encoder<Sink>& e)
+{
+    static const std::string description = [] {
+        std::string out;
+        encoder schema{out};
+        internal::describe<T>(schema);
+        return out;
+    }();
+
+    e.write_scalar(::krrs::reflect::schema_hash<T>());
+    e.write_varint(description.size());
+    e.write_bytes(description.data(), description.size());
+}
+
+// writes the stream header on construction, then one record per write. the sink is not owned
+template <::krrs::reflect::concepts::reflectable T, io::sink Sink>
+class stream_writer
+{
+public:
+    explicit stream_writer(Sink& out)
+        : encoder_{out}
+    {
+        write_stream_header<T>(encoder_);
+    }
+
+    void write(const T& record)
+    {
+        encode(record, encoder_);
+        io::release_borrowed(encoder_.sink());
+    }
+
+private:
+    basic_encoder<Sink&> encoder_;
+};
+
+// reads the records of a stream written by stream_writer<T> (of this or any other version of T).
+// the input is not copied and has to outlive the reader
+template <::krrs::reflect::concepts::reflectable T>
+class stream_reader
+{
+public:
+    explicit stream_reader(std::string_view bytes)
+        : decoder_{bytes}
+    {
+        writer_hash_ = decoder_.read_scalar<std::uint64_t>();
+        const std::string_view description = decoder_.read_bytes(decoder_.read_length());
+        if (!schema_matches())
+        {
+            decoder parser{description};
+            writer_schema_ = internal::parse_schema(parser);
+            if (writer_schema_.kind != schema_kind::record)
+            {
+                throw std::runtime_error{"stream does not hold records"};
+            }
+        }
+    }
+
+    // whether the stream was written with the same layout of T, i.e. records decode without any per-field checks
+    bool schema_matches() const noexcept
+    {
+        return writer_hash_ == ::krrs::reflect::schema_hash<T>();
+    }
+
+    std::uint64_t writer_schema_hash() const noexcept
+    {
+        return writer_hash_;
+    }
+
+    // decodes the next record into record, false once the stream is exhausted. on a schema mismatch, members
+    // the writer did not have keep their value
+    bool read(T& record)
+    {
+        if (decoder_.at_end())
+        {
+            return false;
+        }
+
+        if (schema_matches())
+        {
+            decode(record, decoder_);
+        }
+        else
+        {
+            internal::read_tagged(decoder_, writer_schema_, record);
+        }
+        return true;
+    }
+
+private:
+    decoder decoder_;
+    std::uint64_t writer_hash_ = 0;
+    schema_node writer_schema_;
+};
+
+} // namespace krrs::binary
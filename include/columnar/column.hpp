@@ -0,0 +1,345 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "../../include/binary/concepts.hpp"
+#include "../../include/binary/decoder.hpp"
+#include "../../include/binary/encoder.hpp"
+#include "../../include/reflect/reflect.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace krrs::columnar {
+
+// a columnar file is a header, the row groups and a footer indexing them:
+//   8 bytes   magic, little-endian
+//   8 bytes   reflect::schema_hash<T>() of the writer, little-endian
+//   ...       one chunk per stored member per row group, in generate_meta_info<T>() order
+//   ...       footer: varint row group count, then per row group its varint row count and, per chunk, its varint offset,
+//             varint size, min and max
+//   8 bytes   offset of the footer, little-endian
+//   8 bytes   magic, little-endian
+// the footer sits at the end so row groups can be streamed out before it is known
+inline constexpr std::uint64_t magic = 0x314C4F435352524BULL; // "KRRSCOL1"
+inline constexpr std::size_t header_size = 16;
+inline constexpr std::size_t trailer_size = 16;
+
+inline constexpr std::size_t default_row_group_size = 64 * 1024;
+
+// how a column chunk stores its values, picked from the member type
+enum class encoding : std::uint8_t
+{
+    // fixed-width little-endian values, for floats and bools
+    plain,
+    // zigzag varints of the difference to the previous value, for integers. sorted or slowly moving columns (ids,
+    // timestamps, sequence numbers) shrink to a byte or two per row
+    delta_varint,
+    // the distinct values once, then a varint index per row, for enums and strings
+    dictionary,
+};
+
+namespace concepts {
+
+template <typename T>
+concept string_like = std::convertible_to<const T&, std::string_view> && std::constructible_from<T, std::string_view>;
+
+template <typename T>
+concept integer = std::integral<T> && !std::same_as<T, bool>;
+
+// a member type that gets a column of its own
+template <typename T>
+concept column_value = integer<T> || std::floating_point<T> || std::same_as<T, bool> || std::is_enum_v<T> || string_like<T>;
+
+} // namespace concepts
+
+template <typename T>
+consteval encoding encoding_of()
+{
+    static_assert(concepts::column_value<T>, "columnar: only integers, floats, bools, enums and strings have a column form!");
+    if constexpr (concepts::integer<T>)
+    {
+        return encoding::delta_varint;
+    }
+    else if constexpr (std::is_enum_v<T> || concepts::string_like<T>)
+    {
+        return encoding::dictionary;
+    }
+    else
+    {
+        return encoding::plain;
+    }
+}
+
+// what a column of T reads back as. strings point into the file
+template <typename T>
+using value_view_t = std::conditional_t<concepts::string_like<T>, std::string_view, T>;
+
+// smallest and largest value of a column chunk, so a scan can skip row groups without decoding them
+template <typename T>
+struct column_stats
+{
+    value_view_t<T> min;
+    value_view_t<T> max;
+};
+
+namespace internal {
+
+template <typename Descriptor>
+consteval bool is_stored()
+{
+    return !std::is_function_v<typename Descriptor::member_type>;
+}
+
+template <concepts::integer T>
+constexpr std::uint64_t to_bits(T value) noexcept
+{
+    if constexpr (std::is_signed_v<T>)
+    {
+        return static_cast<std::uint64_t>(std::int64_t{value});
+    }
+    else
+    {
+        return std::uint64_t{value};
+    }
+}
+
+// truncates back to T. the bits always came from a T, so nothing is lost
+template <concepts::integer T>
+constexpr T from_bits(std::uint64_t bits) noexcept
+{
+    if constexpr (std::same_as<T, std::uint64_t>)
+    {
+        return bits;
+    }
+    else
+    {
+        return static_cast<T>(bits);
+    }
+}
+
+constexpr std::uint64_t zigzag(std::uint64_t bits) noexcept
+{
+    return (bits << 1) ^ (0 - (bits >> 63));
+}
+
+constexpr std::uint64_t unzigzag(std::uint64_t value) noexcept
+{
+    return (value >> 1) ^ (0 - (value & 1));
+}
+
+// a single value in its self-contained form, used for stats and dictionary entries
+template <typename T, typename Encoder>
+void write_value(Encoder& enc, const value_view_t<T>& value)
+{
+    if constexpr (std::is_enum_v<T>)
+    {
+        write_value<std::underlying_type_t<T>>(enc, std::to_underlying(value));
+    }
+    else if constexpr (concepts::integer<T>)
+    {
+        enc.write_varint(std::is_signed_v<T> ? zigzag(to_bits(value)) : to_bits(value));
+    }
+    else if constexpr (concepts::string_like<T>)
+    {
+        const std::string_view str{value};
+        enc.write_varint(str.size());
+        enc.write_bytes(str.data(), str.size());
+    }
+    else
+    {
+        enc.write_scalar(value);
+    }
+}
+
+template <typename T>
+value_view_t<T> read_value(binary::decoder& dec)
+{
+    if constexpr (std::is_enum_v<T>)
+    {
+        return static_cast<T>(read_value<std::underlying_type_t<T>>(dec));
+    }
+    else if constexpr (concepts::integer<T>)
+    {
+        const std::uint64_t value = dec.read_varint();
+        return from_bits<T>(std::is_signed_v<T> ? unzigzag(value) : value);
+    }
+    else if constexpr (concepts::string_like<T>)
+    {
+        return dec.read_bytes(dec.read_length());
+    }
+    else
+    {
+        return dec.read_scalar<T>();
+    }
+}
+
+// the key a dictionary is built on
+template <typename T>
+struct dictionary_key_type
+{
+    using type = std::string_view;
+};
+
+template <typename T>
+    requires std::is_enum_v<T>
+struct dictionary_key_type<T>
+{
+    using type = std::underlying_type_t<T>;
+};
+
+template <typename T>
+using dictionary_key_t = typename dictionary_key_type<T>::type;
+
+template <typename T>
+dictionary_key_t<T> dictionary_key(const T& value) noexcept
+{
+    if constexpr (std::is_enum_v<T>)
+    {
+        return std::to_underlying(value);
+    }
+    else
+    {
+        return std::string_view{value};
+    }
+}
+
+// the member of rows[first, last) behind Descriptor, encoded into enc. stats receives the smallest and largest value
+template <typename Descriptor, typename Row, typename Encoder>
+column_stats<typename Descriptor::member_type> encode_chunk(Encoder& enc, const std::vector<Row>& rows, std::size_t first, std::size_t last)
+{
+    using T = typename Descriptor::member_type;
+    constexpr encoding enc_kind = encoding_of<T>();
+
+    const auto member = [&rows](std::size_t i) -> const T& { return ::krrs::reflect::get_member_variable<Descriptor>(rows[i]); };
+
+    column_stats<T> stats{member(first), member(first)};
+    for (std::size_t i = first; i != last; ++i)
+    {
+        const value_view_t<T> value{member(i)};
+        if (value < stats.min)
+        {
+            stats.min = value;
+        }
+        if (stats.max < value)
+        {
+            stats.max = value;
+        }
+    }
+
+    if constexpr (enc_kind == encoding::delta_varint)
+    {
+        std::uint64_t previous = 0;
+        for (std::size_t i = first; i != last; ++i)
+        {
+            const std::uint64_t bits = to_bits(member(i));
+            enc.write_varint(zigzag(bits - previous));
+            previous = bits;
+        }
+    }
+    else if constexpr (enc_kind == encoding::dictionary)
+    {
+        std::unordered_map<dictionary_key_t<T>, std::uint32_t> index;
+        std::vector<std::uint32_t> ids;
+        std::vector<std::size_t> entries;
+        ids.reserve(last - first);
+        for (std::size_t i = first; i != last; ++i)
+        {
+            const auto [it, inserted] = index.try_emplace(dictionary_key(member(i)), static_cast<std::uint32_t>(entries.size()));
+            if (inserted)
+            {
+                entries.push_back(i);
+            }
+            ids.push_back(it->second);
+        }
+
+        enc.write_varint(entries.size());
+        for (const std::size_t i : entries)
+        {
+            write_value<T>(enc, member(i));
+        }
+        for (const std::uint32_t id : ids)
+        {
+            enc.write_varint(id);
+        }
+    }
+    else
+    {
+        for (std::size_t i = first; i != last; ++i)
+        {
+            enc.write_scalar(member(i));
+        }
+    }
+    return stats;
+}
+
+// calls fn with each of the rows values of a chunk of T, in order
+template <typename T, typename Functor>
+void decode_chunk(std::string_view bytes, std::size_t rows, Functor&& func)
+{
+    constexpr encoding enc_kind = encoding_of<T>();
+    binary::decoder dec{bytes};
+
+    if constexpr (enc_kind == encoding::delta_varint)
+    {
+        std::uint64_t previous = 0;
+        for (std::size_t i = 0; i != rows; ++i)
+        {
+            previous += unzigzag(dec.read_varint());
+            func(from_bits<T>(previous));
+        }
+    }
+    else if constexpr (enc_kind == encoding::dictionary)
+    {
+        std::vector<value_view_t<T>> dictionary(dec.read_length());
+        for (auto& entry : dictionary)
+        {
+            entry = read_value<T>(dec);
+        }
+        for (std::size_t i = 0; i != rows; ++i)
+        {
+            const std::uint64_t id = dec.read_varint();
+            if (id >= dictionary.size())
+            {
+                throw std::runtime_error{"columnar chunk is corrupt, dictionary index " + std::to_string(id) + " is out of range"};
+            }
+            func(dictionary[static_cast<std::size_t>(id)]);
+        }
+    }
+    else if constexpr (binary::concepts::bulk_copyable<T>)
+    {
+        const std::string_view values = dec.read_bytes(rows * sizeof(T));
+        for (std::size_t i = 0; i != rows; ++i)
+        {
+            T value;
+            std::memcpy(&value, values.data() + i * sizeof(T), sizeof(T));
+            func(value);
+        }
+    }
+    else
+    {
+        for (std::size_t i = 0; i != rows; ++i)
+        {
+            func(dec.read_scalar<T>());
+        }
+    }
+
+    if (!dec.at_end())
+    {
+        throw std::runtime_error{"columnar chunk is corrupt, " + std::to_string(dec.remaining()) + " bytes left after its values"};
+    }
+}
+
+} // namespace internal
+
+} // namespace krrs::columnar
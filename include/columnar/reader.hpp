@@ -0,0 +1,224 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "../../include/reflect/schema.hpp"
+#include "column.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace krrs::columnar {
+
+// reads a file written by columnar::write for the same layout of T. opening parses only the footer, every read then
+// decodes just the chunks of the members it names. the bytes, e.g. an mmap'd file, are not copied and have to
+// outlive the reader and every string_view read from it
+template <::krrs::reflect::concepts::reflectable T>
+class reader
+{
+public:
+    // MemberPtr may name a member of a base class
+    template <auto MemberPtr>
+    using member_type_of = typename ::krrs::reflect::detail::descriptor_for<T, MemberPtr>::member_type;
+
+    explicit reader(std::string_view bytes)
+        : bytes_{bytes}
+    {
+        if (bytes_.size() < header_size + trailer_size || load<std::uint64_t>(0) != magic || load<std::uint64_t>(bytes_.size() - 8) != magic)
+        {
+            throw std::runtime_error{"columnar file of " + std::to_string(bytes_.size()) + " bytes is truncated or not a columnar file"};
+        }
+        if (load<std::uint64_t>(8) != ::krrs::reflect::schema_hash<T>())
+        {
+            throw std::runtime_error{"columnar file was written for another layout of " + std::string{::krrs::reflect::utility::get_short_name<T>()}};
+        }
+
+        const std::size_t footer_start = load<std::uint64_t>(bytes_.size() - trailer_size);
+        const std::size_t footer_end = bytes_.size() - trailer_size;
+        if (footer_start < header_size || footer_start > footer_end)
+        {
+            throw std::runtime_error{"columnar file is corrupt, its footer offset " + std::to_string(footer_start) + " is out of range"};
+        }
+        read_footer(bytes_.substr(footer_start, footer_end - footer_start), footer_start);
+    }
+
+    // number of rows in the file
+    std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    std::size_t row_group_count() const noexcept
+    {
+        return group_rows_.size();
+    }
+
+    std::size_t row_group_size(std::size_t group) const
+    {
+        return group_rows_.at(group);
+    }
+
+    // min and max of a member within a row group, read from the footer without touching the chunk
+    template <auto MemberPtr>
+    column_stats<member_type_of<MemberPtr>> stats(std::size_t group) const
+    {
+        using member_type = member_type_of<MemberPtr>;
+        binary::decoder dec{chunk_at<MemberPtr>(group).stats};
+        column_stats<member_type> out{};
+        out.min = internal::read_value<member_type>(dec);
+        out.max = internal::read_value<member_type>(dec);
+        return out;
+    }
+
+    // calls fn with the member of every row of a row group, in order. strings are passed as string_views into the file
+    template <auto MemberPtr, typename Functor>
+    void scan(std::size_t group, Functor&& func) const
+    {
+        const chunk& c = chunk_at<MemberPtr>(group);
+        internal::decode_chunk<member_type_of<MemberPtr>>(bytes_.substr(c.offset, c.size), group_rows_[group], func);
+    }
+
+    // as above, over every row group
+    template <auto MemberPtr, typename Functor>
+    void scan(Functor&& func) const
+    {
+        for (std::size_t group = 0; group != row_group_count(); ++group)
+        {
+            scan<MemberPtr>(group, func);
+        }
+    }
+
+    // one member of every row
+    template <auto MemberPtr>
+    std::vector<member_type_of<MemberPtr>> column() const
+    {
+        using member_type = member_type_of<MemberPtr>;
+        std::vector<member_type> out;
+        out.reserve(size_);
+        scan<MemberPtr>([&out](const value_view_t<member_type>& value) { out.emplace_back(value); });
+        return out;
+    }
+
+    // every row with only the named members read, the rest are value-initialized. with no member named, the rows are
+    // read whole, e.g. read<&trade::price, &trade::quantity>() or read<>()
+    template <auto... MemberPtrs>
+    std::vector<T> read() const
+    {
+        std::vector<T> out(size_);
+        if constexpr (sizeof...(MemberPtrs) == 0)
+        {
+            ::krrs::reflect::for_each<T>([this, &out]<typename Descriptor>() {
+                if constexpr (internal::is_stored<Descriptor>())
+                {
+                    read_into<Descriptor>(out);
+                }
+            });
+        }
+        else
+        {
+            (read_into<::krrs::reflect::detail::descriptor_for<T, MemberPtrs>>(out), ...);
+        }
+        return out;
+    }
+
+private:
+    struct chunk
+    {
+        std::size_t offset = 0;
+        std::size_t size = 0;
+        std::string_view stats;
+    };
+
+    static constexpr std::size_t member_count = ::krrs::reflect::generate_meta_info<T>().size();
+
+    template <typename U>
+    U load(std::size_t pos) const noexcept
+    {
+        U value;
+        std::memcpy(&value, bytes_.data() + pos, sizeof(U));
+        return binary::internal::swap_to_little_endian(value);
+    }
+
+    void read_footer(std::string_view footer, std::size_t footer_start)
+    {
+        binary::decoder dec{footer};
+        // every row group takes at least one byte of footer
+        const std::size_t groups = dec.read_length();
+        group_rows_.reserve(groups);
+        chunks_.resize(groups * member_count);
+
+        for (std::size_t group = 0; group != groups; ++group)
+        {
+            const std::size_t rows = dec.read_length(0);
+            group_rows_.push_back(rows);
+            size_ += rows;
+
+            ::krrs::reflect::for_each<T>([this, &dec, footer, group, rows, footer_start]<typename Descriptor>() {
+                if constexpr (internal::is_stored<Descriptor>())
+                {
+                    using member_type = typename Descriptor::member_type;
+                    chunk& c = chunks_[group * member_count + ::krrs::reflect::descriptor_index<T, Descriptor>()];
+                    c.offset = dec.read_length(0);
+                    c.size = dec.read_length(0);
+                    // every encoding spends at least a byte per row
+                    if (c.offset < header_size || c.offset > footer_start || c.size > footer_start - c.offset || rows > c.size)
+                    {
+                        throw std::runtime_error{"columnar file is corrupt, the chunk of " + std::string{Descriptor::name} + " in row group "
+                                                 + std::to_string(group) + " is out of range"};
+                    }
+
+                    const std::size_t stats_start = dec.position();
+                    internal::read_value<member_type>(dec);
+                    internal::read_value<member_type>(dec);
+                    c.stats = footer.substr(stats_start, dec.position() - stats_start);
+                }
+            });
+        }
+
+        if (!dec.at_end())
+        {
+            throw std::runtime_error{"columnar file is corrupt, " + std::to_string(dec.remaining()) + " bytes left after its footer"};
+        }
+    }
+
+    template <auto MemberPtr>
+    const chunk& chunk_at(std::size_t group) const
+    {
+        using descriptor = ::krrs::reflect::detail::descriptor_for<T, MemberPtr>;
+        static_assert(internal::is_stored<descriptor>(), "member functions are not part of the columnar file!");
+        if (group >= row_group_count())
+        {
+            throw std::out_of_range{"row group " + std::to_string(group) + " of " + std::to_string(row_group_count())};
+        }
+        return chunks_[group * member_count + ::krrs::reflect::descriptor_index<T, descriptor>()];
+    }
+
+    template <typename Descriptor>
+    void read_into(std::vector<T>& out) const
+    {
+        using member_type = typename Descriptor::member_type;
+        std::size_t row = 0;
+        scan<Descriptor::mem_ptr>([&out, &row](const value_view_t<member_type>& value) {
+            ::krrs::reflect::get_member_variable<Descriptor>(out[row++]) = member_type{value};
+        });
+    }
+
+    std::string_view bytes_;
+    std::size_t size_ = 0;
+    std::vector<std::size_t> group_rows_;
+    // one per member per row group, member functions included so a descriptor index finds its chunk directly
+    std::vector<chunk> chunks_;
+};
+
+} // namespace krrs::columnar
@@ -0,0 +1,85 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "../../include/io/sink.hpp"
+#include "../../include/reflect/schema.hpp"
+#include "column.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace krrs::columnar {
+
+// writes rows to out column by column, in row groups of up to row_group_size rows. every stored member of T has to be
+// a columnar::concepts::column_value, nested structs and containers have no column form
+template <::krrs::reflect::concepts::reflectable T, io::sink Sink>
+void write(const std::vector<T>& rows, Sink& out, std::size_t row_group_size = default_row_group_size)
+{
+    if (row_group_size == 0)
+    {
+        throw std::invalid_argument{"columnar: row_group_size has to be positive"};
+    }
+
+    binary::basic_encoder file{out};
+    file.write_scalar(magic);
+    file.write_scalar(::krrs::reflect::schema_hash<T>());
+    std::size_t offset = header_size;
+
+    // each chunk is encoded into scratch first, its size goes into the footer
+    std::string scratch;
+    binary::encoder chunk{io::string_sink{scratch}};
+    std::string footer_bytes;
+    binary::encoder footer{io::string_sink{footer_bytes}};
+
+    const std::size_t groups = (rows.size() + row_group_size - 1) / row_group_size;
+    footer.write_varint(groups);
+    for (std::size_t first = 0; first < rows.size(); first += row_group_size)
+    {
+        const std::size_t last = std::min(rows.size(), first + row_group_size);
+        footer.write_varint(last - first);
+
+        ::krrs::reflect::for_each<T>([&]<typename Descriptor>() {
+            if constexpr (internal::is_stored<Descriptor>())
+            {
+                using member_type = typename Descriptor::member_type;
+                scratch.clear();
+                const column_stats<member_type> stats = internal::encode_chunk<Descriptor>(chunk, rows, first, last);
+                file.write_bytes(scratch.data(), scratch.size());
+
+                footer.write_varint(offset);
+                footer.write_varint(scratch.size());
+                internal::write_value<member_type>(footer, stats.min);
+                internal::write_value<member_type>(footer, stats.max);
+                offset += scratch.size();
+            }
+        });
+    }
+
+    file.write_bytes(footer_bytes.data(), footer_bytes.size());
+    file.write_scalar(std::uint64_t{offset});
+    file.write_scalar(magic);
+}
+
+// appends the file to the end of out
+template <::krrs::reflect::concepts::reflectable T>
+void write(const std::vector<T>& rows, std::string& out, std::size_t row_group_size = default_row_group_size)
+{
+    io::string_sink sink{out};
+    write(rows, sink, row_group_size);
+}
+
+template <::krrs::reflect::concepts::reflectable T>
+std::string write(const std::vector<T>& rows, std::size_t row_group_size = default_row_group_size)
+{
+    std::string out;
+    write(rows, out, row_group_size);
+    return out;
+}
+
+} // namespace krrs::columnar
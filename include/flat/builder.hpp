@@ -0,0 +1,138 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "layout.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace krrs::flat {
+
+namespace internal {
+
+// lays value out into the slot at pos, appending its out-of-line data at tail. with Write false nothing is touched
+// and only tail advances, so the same walk sizes the buffer before it is written
+template <bool Write, typename T>
+void lay_out(char* base, std::size_t pos, const T& value, std::size_t& tail)
+{
+    if constexpr (::krrs::reflect::concepts::reflectable<T>)
+    {
+        ::krrs::reflect::for_each<T>([base, pos, &value, &tail]<typename Descriptor>() {
+            if constexpr (is_stored<Descriptor>())
+            {
+                lay_out<Write>(base, pos + table_layout<T>::template offset<Descriptor>, ::krrs::reflect::get_member_variable<Descriptor>(value), tail);
+            }
+        });
+    }
+    else if constexpr (concepts::scalar<T>)
+    {
+        if constexpr (Write)
+        {
+            store_scalar(base + pos, value);
+        }
+    }
+    else if constexpr (::krrs::reflect::concepts::same_as_array_type<T>)
+    {
+        if constexpr (Write)
+        {
+            for (std::size_t i = 0; i != value.size(); ++i)
+            {
+                store_scalar(base + pos + i * sizeof(typename T::value_type), value[i]);
+            }
+        }
+    }
+    else if constexpr (concepts::vector_like<T>)
+    {
+        using value_type = typename T::value_type;
+        constexpr std::size_t stride = slot_size<value_type>();
+
+        const std::size_t start = align_up(tail, slot_align<value_type>());
+        tail = start + value.size() * stride;
+        if constexpr (Write)
+        {
+            store_span(base + pos, start, value.size());
+        }
+
+        if constexpr (binary::concepts::bulk_copyable<value_type>)
+        {
+            if constexpr (Write)
+            {
+                std::memcpy(base + start, value.data(), value.size() * stride);
+            }
+        }
+        else
+        {
+            std::size_t elem_pos = start;
+            for (const auto& elem : value)
+            {
+                lay_out<Write>(base, elem_pos, elem, tail);
+                elem_pos += stride;
+            }
+        }
+    }
+    else
+    {
+        const std::string_view str{value};
+        const std::size_t start = tail;
+        tail += str.size();
+        if constexpr (Write)
+        {
+            std::memcpy(base + start, str.data(), str.size());
+            store_span(base + pos, start, str.size());
+        }
+    }
+}
+
+} // namespace internal
+
+// lays reflected objects out into one contiguous buffer that flat::view reads in place. the buffer is reused, so
+// building many objects of the same shape allocates only while it grows
+template <::krrs::reflect::concepts::reflectable T>
+class builder
+{
+public:
+    // the returned bytes stay valid until the next build
+    std::string_view build(const T& obj)
+    {
+        constexpr std::size_t root = header_size + internal::table_layout<T>::size;
+
+        std::size_t size = root;
+        internal::lay_out<false>(nullptr, header_size, obj, size);
+        if (size > std::numeric_limits<std::uint32_t>::max())
+        {
+            throw std::runtime_error{"flat buffer of " + std::to_string(size) + " bytes does not fit 32-bit offsets"};
+        }
+
+        // zero filled, so padding is deterministic
+        buffer_.assign(size, '\0');
+        internal::store_scalar(buffer_.data(), ::krrs::reflect::schema_hash<T>());
+        std::size_t tail = root;
+        internal::lay_out<true>(buffer_.data(), header_size, obj, tail);
+        return buffer_;
+    }
+
+    const std::string& buffer() const noexcept
+    {
+        return buffer_;
+    }
+
+private:
+    std::string buffer_;
+};
+
+template <::krrs::reflect::concepts::reflectable T>
+std::string build(const T& obj)
+{
+    builder<T> b;
+    b.build(obj);
+    return b.buffer();
+}
+
+} // namespace krrs::flat
@@ -0,0 +1,188 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "../../include/binary/concepts.hpp"
+#include "../../include/binary/encoder.hpp"
+#include "../../include/reflect/reflect.hpp"
+#include "../../include/reflect/schema.hpp"
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+namespace krrs::flat {
+
+// a flat buffer is a small header followed by the root table:
+//   8 bytes   reflect::schema_hash<T>() of the builder, little-endian
+//   ...       the table of T, then the out-of-line data of every string and vector it references
+// a table holds one slot per member at an offset fixed at compile time. scalars and nested tables are stored inline,
+// strings and vectors as a (offset, length) pair of uint32 pointing into the same buffer
+inline constexpr std::size_t header_size = 8;
+
+namespace concepts {
+
+// stored inline as little-endian bytes
+template <typename T>
+concept scalar = binary::concepts::scalar<T> || (std::is_enum_v<T> && binary::concepts::scalar<std::underlying_type_t<T>>);
+
+// stored out of line, as a (offset, length) slot
+template <typename T>
+concept string_like = std::convertible_to<const T&, std::string_view>;
+
+template <typename T>
+concept vector_like = binary::concepts::same_as_vector<T>;
+
+} // namespace concepts
+
+namespace internal {
+
+// the (offset, length) pair of an out-of-line string or vector
+inline constexpr std::size_t span_slot_size = 8;
+inline constexpr std::size_t span_slot_align = 4;
+
+template <::krrs::reflect::concepts::reflectable T>
+struct table_layout;
+
+template <typename T>
+consteval std::size_t slot_size()
+{
+    if constexpr (::krrs::reflect::concepts::reflectable<T>)
+    {
+        return table_layout<T>::size;
+    }
+    else if constexpr (concepts::scalar<T>)
+    {
+        return sizeof(T);
+    }
+    else if constexpr (::krrs::reflect::concepts::same_as_array_type<T>)
+    {
+        static_assert(concepts::scalar<typename T::value_type>, "flat: std::array members hold scalars only!");
+        return std::tuple_size_v<T> * sizeof(typename T::value_type);
+    }
+    else
+    {
+        static_assert(concepts::string_like<T> || concepts::vector_like<T>, "flat: type has no flat layout!");
+        return span_slot_size;
+    }
+}
+
+template <typename T>
+consteval std::size_t slot_align()
+{
+    if constexpr (::krrs::reflect::concepts::reflectable<T>)
+    {
+        return table_layout<T>::align;
+    }
+    else if constexpr (concepts::scalar<T>)
+    {
+        return alignof(T);
+    }
+    else if constexpr (::krrs::reflect::concepts::same_as_array_type<T>)
+    {
+        return alignof(typename T::value_type);
+    }
+    else
+    {
+        return span_slot_align;
+    }
+}
+
+constexpr std::size_t align_up(std::size_t value, std::size_t align) noexcept
+{
+    return (value + align - 1) / align * align;
+}
+
+template <typename Descriptor>
+consteval bool is_stored()
+{
+    return !std::is_function_v<typename Descriptor::member_type>;
+}
+
+// offset of every member within the table of T, in generate_meta_info<T>() order. members are laid out in order,
+// each aligned to its natural alignment
+template <::krrs::reflect::concepts::reflectable T>
+struct table_layout
+{
+    static constexpr auto compute()
+    {
+        struct result
+        {
+            std::array<std::size_t, ::krrs::reflect::generate_meta_info<T>().size()> offsets{};
+            std::size_t size = 0;
+            std::size_t align = 1;
+        } out;
+
+        std::size_t index = 0;
+        ::krrs::reflect::for_each<T>([&out, &index]<typename Descriptor>() {
+            if constexpr (is_stored<Descriptor>())
+            {
+                using member_type = typename Descriptor::member_type;
+                out.offsets[index] = align_up(out.size, slot_align<member_type>());
+                out.size = out.offsets[index] + slot_size<member_type>();
+                out.align = std::max(out.align, slot_align<member_type>());
+            }
+            ++index;
+        });
+        out.size = align_up(out.size, out.align);
+        return out;
+    }
+
+    static constexpr auto layout = compute();
+    static constexpr std::size_t size = layout.size;
+    static constexpr std::size_t align = layout.align;
+
+    template <typename Descriptor>
+    static constexpr std::size_t offset = layout.offsets[::krrs::reflect::descriptor_index<T, Descriptor>()];
+};
+
+// the bytes of a scalar as stored in a table
+template <concepts::scalar T>
+void store_scalar(char* out, T value) noexcept
+{
+    if constexpr (std::is_enum_v<T>)
+    {
+        store_scalar(out, std::to_underlying(value));
+    }
+    else
+    {
+        const T wire = binary::internal::swap_to_little_endian(value);
+        std::memcpy(out, &wire, sizeof(T));
+    }
+}
+
+template <concepts::scalar T>
+T load_scalar(const char* in) noexcept
+{
+    if constexpr (std::is_enum_v<T>)
+    {
+        return static_cast<T>(load_scalar<std::underlying_type_t<T>>(in));
+    }
+    else if constexpr (std::same_as<T, bool>)
+    {
+        return *in != '\0';
+    }
+    else
+    {
+        T wire;
+        std::memcpy(&wire, in, sizeof(T));
+        return binary::internal::swap_to_little_endian(wire);
+    }
+}
+
+// the (offset, length) slot of an out-of-line string or vector
+inline void store_span(char* out, std::size_t offset, std::size_t length) noexcept
+{
+    store_scalar(out, static_cast<std::uint32_t>(offset));
+    store_scalar(out + 4, static_cast<std::uint32_t>(length));
+}
+
+} // namespace internal
+
+} // namespace krrs::flat
@@ -0,0 +1,222 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "layout.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace krrs::flat {
+
+template <::krrs::reflect::concepts::reflectable T>
+class view;
+
+template <typename T>
+class vector_view;
+
+namespace internal {
+
+// what a slot holding a T reads back as: scalars by value, strings as std::string_view, vectors as
+// flat::vector_view and nested tables as flat::view, all pointing into the buffer
+struct slot_reader
+{
+    template <typename T>
+    static auto read(std::string_view buffer, std::size_t pos)
+    {
+        if constexpr (::krrs::reflect::concepts::reflectable<T>)
+        {
+            return view<T>{buffer, pos};
+        }
+        else if constexpr (concepts::scalar<T>)
+        {
+            return load_scalar<T>(buffer.data() + pos);
+        }
+        else if constexpr (::krrs::reflect::concepts::same_as_array_type<T>)
+        {
+            T out;
+            for (std::size_t i = 0; i != out.size(); ++i)
+            {
+                out[i] = load_scalar<typename T::value_type>(buffer.data() + pos + i * sizeof(typename T::value_type));
+            }
+            return out;
+        }
+        else if constexpr (concepts::vector_like<T>)
+        {
+            const auto [start, count] = read_span(buffer, pos, slot_size<typename T::value_type>());
+            return vector_view<typename T::value_type>{buffer, start, count};
+        }
+        else
+        {
+            const auto [start, count] = read_span(buffer, pos, 1);
+            return buffer.substr(start, count);
+        }
+    }
+
+    // the (offset, length) slot at pos, checked to stay inside the buffer
+    static std::pair<std::size_t, std::size_t> read_span(std::string_view buffer, std::size_t pos, std::size_t stride)
+    {
+        const std::size_t start = load_scalar<std::uint32_t>(buffer.data() + pos);
+        const std::size_t count = load_scalar<std::uint32_t>(buffer.data() + pos + 4);
+        if (start > buffer.size() || count * stride > buffer.size() - start)
+        {
+            throw std::runtime_error{"flat buffer is corrupt, the slot at offset " + std::to_string(pos) + " points past its end"};
+        }
+        return {start, count};
+    }
+};
+
+} // namespace internal
+
+// read-only access to the elements of a vector member, straight out of the buffer
+template <typename T>
+class vector_view
+{
+public:
+    using value_type = decltype(internal::slot_reader::read<T>(std::string_view{}, 0));
+
+    class iterator
+    {
+    public:
+        using value_type = vector_view::value_type;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+
+        iterator(const vector_view* parent, std::size_t index) noexcept
+            : parent_{parent}
+            , index_{index}
+        {
+        }
+
+        value_type operator*() const
+        {
+            return (*parent_)[index_];
+        }
+
+        iterator& operator++() noexcept
+        {
+            ++index_;
+            return *this;
+        }
+
+        iterator operator++(int) noexcept
+        {
+            iterator copy = *this;
+            ++index_;
+            return copy;
+        }
+
+        bool operator==(const iterator& other) const noexcept
+        {
+            return index_ == other.index_;
+        }
+
+    private:
+        const vector_view* parent_ = nullptr;
+        std::size_t index_ = 0;
+    };
+
+    vector_view(std::string_view buffer, std::size_t start, std::size_t count) noexcept
+        : buffer_{buffer}
+        , start_{start}
+        , count_{count}
+    {
+    }
+
+    value_type operator[](std::size_t index) const
+    {
+        return internal::slot_reader::read<T>(buffer_, start_ + index * stride);
+    }
+
+    std::size_t size() const noexcept
+    {
+        return count_;
+    }
+
+    bool empty() const noexcept
+    {
+        return count_ == 0;
+    }
+
+    iterator begin() const noexcept
+    {
+        return {this, 0};
+    }
+
+    iterator end() const noexcept
+    {
+        return {this, count_};
+    }
+
+private:
+    static constexpr std::size_t stride = internal::slot_size<T>();
+
+    std::string_view buffer_;
+    std::size_t start_;
+    std::size_t count_;
+};
+
+// reads the members of a T laid out by flat::builder straight out of the bytes, e.g. a network buffer or an mmap'd
+// file, with no decode step. the bytes are not copied and have to outlive the view and everything read from it
+template <::krrs::reflect::concepts::reflectable T>
+class view
+{
+public:
+    // checks that bytes were built for this layout of T and hold its root table
+    explicit view(std::string_view bytes)
+        : view{bytes, header_size}
+    {
+        if (bytes.size() < header_size + internal::table_layout<T>::size)
+        {
+            throw std::runtime_error{"flat buffer of " + std::to_string(bytes.size()) + " bytes is too small for "
+                                     + std::string{::krrs::reflect::utility::get_short_name<T>()}};
+        }
+        if (internal::load_scalar<std::uint64_t>(bytes.data()) != ::krrs::reflect::schema_hash<T>())
+        {
+            throw std::runtime_error{"flat buffer was built for another layout of " + std::string{::krrs::reflect::utility::get_short_name<T>()}};
+        }
+    }
+
+    // e.g. view.get<&position_info::position>(). MemberPtr may name a member of a base class
+    template <auto MemberPtr>
+    auto get() const
+    {
+        return get<::krrs::reflect::detail::descriptor_for<T, MemberPtr>>();
+    }
+
+    template <::krrs::reflect::concepts::descriptor_like Descriptor>
+    auto get() const
+    {
+        static_assert(internal::is_stored<Descriptor>(), "member functions are not part of the flat buffer!");
+        return internal::slot_reader::read<typename Descriptor::member_type>(buffer_, pos_ + internal::table_layout<T>::template offset<Descriptor>);
+    }
+
+    // the whole buffer, header included
+    std::string_view bytes() const noexcept
+    {
+        return buffer_;
+    }
+
+private:
+    friend struct internal::slot_reader;
+
+    // a nested table at pos, already known to lie inside buffer
+    view(std::string_view buffer, std::size_t pos) noexcept
+        : buffer_{buffer}
+        , pos_{pos}
+    {
+    }
+
+    std::string_view buffer_;
+    std::size_t pos_;
+};
+
+} // namespace krrs::flat
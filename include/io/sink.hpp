@@ -0,0 +1,392 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <concepts>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <vector>
+
+namespace krrs::io {
+
+// where the serializers write to. write() copies, the data can be reused as soon as it returns.
+// optional members:
+//  - reserve(n): size hint for the bytes about to be written
+//  - write_borrowed(data, size): same as write(), but the sink may keep a pointer to data instead of copying it,
+//    data must stay valid until release_borrowed() is called
+//  - release_borrowed(): the sink is done with every borrowed pointer once this returns
+// the writers / encoders of each codec hold their Sink by value. a sink that cannot be copied is used through a reference
+// type (e.g. json::basic_writer<io::fd_sink&>), which is what the deduction guides pick for a sink passed as an lvalue
+template <typename S>
+concept sink = requires(S& s, const char* data, std::size_t size, char c) {
+    s.write(data, size);
+    s.put(c);
+};
+
+template <sink S>
+void reserve(S& s, std::size_t size)
+{
+    if constexpr (requires { s.reserve(size); })
+    {
+        s.reserve(size);
+    }
+}
+
+// the codecs borrow the characters of string members: they are part of the object being encoded, which outlives the
+// call that encodes it, and the top-level serialize / encode calls release_borrowed() before returning.
+// anything shorter lived goes through write()
+template <sink S>
+void write_borrowed(S& s, const char* data, std::size_t size)
+{
+    if constexpr (requires { s.write_borrowed(data, size); })
+    {
+        s.write_borrowed(data, size);
+    }
+    else
+    {
+        s.write(data, size);
+    }
+}
+
+template <sink S>
+void release_borrowed(S& s)
+{
+    if constexpr (requires { s.release_borrowed(); })
+    {
+        s.release_borrowed();
+    }
+}
+
+// appends to a caller-owned std::string
+class string_sink
+{
+public:
+    string_sink(std::string& str) noexcept
+        : str_{&str}
+    {
+    }
+
+    void write(const char* data, std::size_t size)
+    {
+        str_->append(data, size);
+    }
+
+    void put(char c)
+    {
+        str_->push_back(c);
+    }
+
+    void reserve(std::size_t size)
+    {
+        str_->reserve(str_->size() + size);
+    }
+
+    std::string& str() const noexcept
+    {
+        return *str_;
+    }
+
+private:
+    std::string* str_;
+};
+
+// writes into a caller-owned fixed buffer, never allocates. running out of space throws
+class buffer_sink
+{
+public:
+    buffer_sink(char* data, std::size_t capacity) noexcept
+        : data_{data}
+        , capacity_{capacity}
+    {
+    }
+
+    void write(const char* data, std::size_t size)
+    {
+        if (size > capacity_ - size_)
+        {
+            throw std::runtime_error{"buffer_sink overflow: " + std::to_string(size_ + size) + " bytes do not fit in " + std::to_string(capacity_)};
+        }
+        std::memcpy(data_ + size_, data, size);
+        size_ += size;
+    }
+
+    void put(char c)
+    {
+        write(&c, 1);
+    }
+
+    std::string_view view() const noexcept
+    {
+        return {data_, size_};
+    }
+
+    std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    void clear() noexcept
+    {
+        size_ = 0;
+    }
+
+private:
+    char* data_;
+    std::size_t capacity_;
+    std::size_t size_ = 0;
+};
+
+// writes to a stdio stream, which does its own buffering. the stream is not owned
+class file_sink
+{
+public:
+    explicit file_sink(std::FILE* file)
+        : file_{file}
+    {
+        if (file == nullptr)
+        {
+            throw std::invalid_argument{"file must not be null"};
+        }
+    }
+
+    void write(const char* data, std::size_t size)
+    {
+        if (std::fwrite(data, 1, size, file_) != size)
+        {
+            throw std::runtime_error{"failed to write to file: " + std::string{std::strerror(errno)}};
+        }
+    }
+
+    void put(char c)
+    {
+        if (std::fputc(c, file_) == EOF)
+        {
+            throw std::runtime_error{"failed to write to file: " + std::string{std::strerror(errno)}};
+        }
+    }
+
+    void flush()
+    {
+        if (std::fflush(file_) != 0)
+        {
+            throw std::runtime_error{"failed to flush file: " + std::string{std::strerror(errno)}};
+        }
+    }
+
+private:
+    std::FILE* file_;
+};
+
+// writes to a posix file descriptor with writev. small writes are copied into a staging buffer, large borrowed
+// chunks (e.g. the contents of a big string or vector) are queued as their own iovec and never copied. everything
+// queued goes out in a single writev once the buffer or the iovec list is full, on release_borrowed() if anything
+// was borrowed, and on flush(). the descriptor is not owned, pending data is flushed on destruction
+class fd_sink
+{
+public:
+    static constexpr std::size_t default_capacity = 64 * 1024;
+    // shorter chunks are cheaper to copy than to give their own iovec
+    static constexpr std::size_t borrow_threshold = 512;
+    static constexpr std::size_t max_iovecs = 64;
+
+    explicit fd_sink(int fd, std::size_t capacity = default_capacity)
+        : fd_{fd}
+        , capacity_{capacity}
+    {
+        if (fd < 0)
+        {
+            throw std::invalid_argument{"invalid file descriptor: " + std::to_string(fd)};
+        }
+        if (capacity == 0)
+        {
+            throw std::invalid_argument{"fd_sink needs a non-zero buffer capacity"};
+        }
+        staging_ = std::make_unique_for_overwrite<char[]>(capacity);
+        iovecs_.reserve(max_iovecs);
+    }
+
+    fd_sink(const fd_sink&) = delete;
+    fd_sink& operator=(const fd_sink&) = delete;
+
+    ~fd_sink()
+    {
+        try
+        {
+            flush();
+        }
+        catch (const std::exception&)
+        {
+            // destructors cannot report, the error is only visible through an explicit flush()
+        }
+    }
+
+    void write(const char* data, std::size_t size)
+    {
+        // too big to stage, data is valid for the duration of the call so it can go out as is
+        if (size >= capacity_)
+        {
+            queue(data, size);
+            flush();
+            return;
+        }
+
+        while (size != 0)
+        {
+            if (used_ == capacity_)
+            {
+                flush();
+            }
+            const std::size_t copied = std::min(size, capacity_ - used_);
+            stage(data, copied);
+            data += copied;
+            size -= copied;
+        }
+    }
+
+    void put(char c)
+    {
+        if (used_ == capacity_)
+        {
+            flush();
+        }
+        stage(&c, 1);
+    }
+
+    void write_borrowed(const char* data, std::size_t size)
+    {
+        if (size < borrow_threshold)
+        {
+            write(data, size);
+            return;
+        }
+        queue(data, size);
+        borrowed_ = true;
+    }
+
+    void release_borrowed()
+    {
+        if (borrowed_)
+        {
+            flush();
+        }
+    }
+
+    // hands everything queued to the descriptor
+    void flush()
+    {
+        std::size_t first = 0;
+        while (first != iovecs_.size())
+        {
+            const int count = static_cast<int>(std::min(iovecs_.size() - first, max_iovecs));
+            const ssize_t written = ::writev(fd_, iovecs_.data() + first, count);
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                throw std::runtime_error{"failed to write to file descriptor: " + std::string{std::strerror(errno)}};
+            }
+
+            // skip what went out, a partial write resumes in the middle of an iovec
+            auto remaining = static_cast<std::size_t>(written);
+            while (first != iovecs_.size() && remaining >= iovecs_[first].iov_len)
+            {
+                remaining -= iovecs_[first++].iov_len;
+            }
+            if (remaining != 0)
+            {
+                iovecs_[first].iov_base = static_cast<char*>(iovecs_[first].iov_base) + remaining;
+                iovecs_[first].iov_len -= remaining;
+            }
+        }
+
+        iovecs_.clear();
+        used_ = 0;
+        borrowed_ = false;
+    }
+
+private:
+    void stage(const char* data, std::size_t size)
+    {
+        // grow the last iovec while it still ends at the staging cursor
+        char* at = staging_.get() + used_;
+        const bool extends = !iovecs_.empty() && static_cast<char*>(iovecs_.back().iov_base) + iovecs_.back().iov_len == at;
+        if (!extends && iovecs_.size() == max_iovecs)
+        {
+            flush();
+            at = staging_.get();
+        }
+
+        std::memcpy(at, data, size);
+        used_ += size;
+        if (extends)
+        {
+            iovecs_.back().iov_len += size;
+        }
+        else
+        {
+            iovecs_.push_back({at, size});
+        }
+    }
+
+    void queue(const char* data, std::size_t size)
+    {
+        if (iovecs_.size() == max_iovecs)
+        {
+            flush();
+        }
+        // writev never writes through iov_base
+        iovecs_.push_back({const_cast<char*>(data), size});
+    }
+
+    int fd_;
+    std::size_t capacity_;
+    std::unique_ptr<char[]> staging_;
+    std::size_t used_ = 0;
+    std::vector<::iovec> iovecs_;
+    bool borrowed_ = false;
+};
+
+// std::streambuf over a sink, for encoders that only know how to write to a std::ostream
+template <sink S>
+class sink_streambuf : public std::streambuf
+{
+public:
+    explicit sink_streambuf(S& s) noexcept
+        : sink_{s}
+    {
+    }
+
+protected:
+    int_type overflow(int_type c) override
+    {
+        if (!traits_type::eq_int_type(c, traits_type::eof()))
+        {
+            sink_.put(traits_type::to_char_type(c));
+        }
+        return traits_type::not_eof(c);
+    }
+
+    std::streamsize xsputn(const char* data, std::streamsize size) override
+    {
+        sink_.write(data, static_cast<std::size_t>(size));
+        return size;
+    }
+
+private:
+    S& sink_;
+};
+
+} // namespace krrs::io
@@ -0,0 +1,70 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "convert.hpp"
+#include "internal/arena.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace krrs::json {
+
+// owns a json document, and everything that std::string_view members decoded from it point into.
+// strings are borrowed straight from the document, only the ones that had to be unescaped are copied (into an arena).
+// decoded views stay valid until the document is destroyed or assign() is called. the document can be neither copied
+// nor moved, a moved short string would take the borrowed characters with it.
+class borrowed_document
+{
+public:
+    borrowed_document() = default;
+
+    explicit borrowed_document(std::string json) noexcept
+        : json_{std::move(json)}
+    {
+    }
+
+    borrowed_document(const borrowed_document&) = delete;
+    borrowed_document& operator=(const borrowed_document&) = delete;
+
+    // replaces the document, reusing both the buffer and the arena. views decoded before are invalidated
+    void assign(std::string_view json)
+    {
+        json_.assign(json);
+        arena_.clear();
+    }
+
+    std::string_view json() const noexcept
+    {
+        return json_;
+    }
+
+    // decodes the document (a bare object, as written by convert_to_json) into obj. members missing from json are left untouched
+    template <::krrs::reflect::concepts::reflectable T>
+    void decode(T& obj)
+    {
+        reader r{json_, arena_};
+        convert_from_json(obj, r);
+        if (!r.at_end())
+        {
+            throw std::runtime_error{"unexpected trailing characters at offset " + std::to_string(r.position())};
+        }
+    }
+
+    template <::krrs::reflect::concepts::reflectable T>
+    T decode()
+    {
+        T obj{};
+        decode(obj);
+        return obj;
+    }
+
+private:
+    std::string json_;
+    internal::string_arena arena_;
+};
+
+} // namespace krrs::json
@@ -3,75 +3,470 @@
 
 #pragma once
 
+#include "../../include/reflect/key_table.hpp"
+#include "../../include/reflect/perfect_hash.hpp"
 #include "../../include/reflect/reflect.hpp"
 #include "concepts.hpp"
+#include "internal/from_json.hpp"
 #include "internal/to_json.hpp"
+#include "reader.hpp"
+#include "size.hpp"
+#include "writer.hpp"
 
-#include <iomanip>
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 
 namespace krrs::json {
 
+template <::krrs::reflect::concepts::reflectable T, typename Sink>
+void convert_to_json(const T& obj, basic_writer<Sink>& w);
+
 template <::krrs::reflect::concepts::reflectable T>
-std::string convert_to_json(const T& obj)
+void convert_from_json(T& obj, reader& r);
+
+namespace internal {
+
+template <typename Sink, typename T>
+void write_value(basic_writer<Sink>& w, const T& value)
 {
-    std::ostringstream oss;
-    oss << '{';
-    ::krrs::reflect::for_each<T>([&oss, &obj, obj_delimiter = ""]<typename Descriptor>() mutable {
-        using member_type = typename Descriptor::member_type;
-        const auto& member = ::krrs::reflect::get_member_variable<Descriptor>(obj);
-        oss << std::exchange(obj_delimiter, ", ") << std::quoted(Descriptor::name) << ": ";
+    if constexpr (::krrs::reflect::concepts::reflectable<T>)
+    {
+        convert_to_json(value, w);
+    }
+    else if constexpr (concepts::same_as_vector<T> || ::krrs::reflect::concepts::same_as_array_type<T>)
+    {
+        w.write('[');
+        std::string_view delimiter = "";
+        for (const auto& elem : value)
+        {
+            w.write(std::exchange(delimiter, ", "));
+            write_value(w, elem);
+        }
+        w.write(']');
+    }
+    else if constexpr (concepts::same_as_unordered_map<T>)
+    {
+        using key_type = typename T::key_type;
+        static_assert(std::convertible_to<key_type, std::string>, "json serialization for unordered_map needs a string type for the key!");
 
-        if constexpr (::krrs::reflect::concepts::reflectable<member_type>)
+        w.write('{');
+        std::string_view delimiter = "";
+        for (const auto& [key, elem] : value)
         {
-            oss << convert_to_json<member_type>(member);
+            w.write(std::exchange(delimiter, ", "));
+            to_json(w, key);
+            w.write(": ");
+            write_value(w, elem);
         }
-        else if constexpr (concepts::same_as_vector<member_type>)
+        w.write('}');
+    }
+    else if constexpr (concepts::same_as_optional<T>)
+    {
+        if (!value.has_value())
         {
-            oss << '[';
-            const char* delimiter = "";
-            for (const auto& elem : member)
-            {
-                oss << std::exchange(delimiter, ", ") << internal::to_json(elem);
-            }
-            oss << ']';
+            w.write("null");
         }
-        else if constexpr (concepts::same_as_unordered_map<member_type>)
+        else
+        {
+            write_value(w, value.value());
+        }
+    }
+    else if constexpr (std::is_enum_v<T>)
+    {
+        // by name for ENUM_PRINTABLE enums, as the underlying value otherwise
+        if constexpr (requires { enum_to_string(value); })
         {
-            using key_type = typename member_type::key_type;
-            static_assert(std::convertible_to<key_type, std::string>, "json serialization for unordered_map needs a string type for the key!");
+            w.write_string(enum_to_string(value));
+        }
+        else
+        {
+            to_json(w, std::to_underlying(value));
+        }
+    }
+    else
+    {
+        to_json(w, value);
+    }
+}
 
-            oss << '{';
-            const char* delimiter = "";
-            for (const auto& [key, value] : member)
-            {
-                oss << std::exchange(delimiter, ", ") << internal::to_json(key) << ": " << internal::to_json(value);
-            }
-            oss << '}';
+template <typename T>
+void read_value(reader& r, T& value)
+{
+    if constexpr (::krrs::reflect::concepts::reflectable<T>)
+    {
+        convert_from_json(value, r);
+    }
+    else if constexpr (concepts::same_as_vector<T>)
+    {
+        value.clear();
+        r.expect('[');
+        if (r.consume(']'))
+        {
+            return;
         }
-        else if constexpr (concepts::same_as_optional<member_type>)
+
+        do
         {
-            if (!member.has_value())
+            if constexpr (std::same_as<typename T::value_type, bool>)
             {
-                oss << "null";
+                // std::vector<bool> hands out proxies, not bool&
+                bool elem = false;
+                read_value(r, elem);
+                value.push_back(elem);
             }
             else
             {
-                oss << internal::to_json(member.value());
+                read_value(r, value.emplace_back());
             }
+        } while (r.consume(','));
+        r.expect(']');
+    }
+    else if constexpr (::krrs::reflect::concepts::same_as_array_type<T>)
+    {
+        r.expect('[');
+        for (std::size_t i = 0; i != value.size(); ++i)
+        {
+            if (i != 0)
+            {
+                r.expect(',');
+            }
+            read_value(r, value[i]);
+        }
+        r.expect(']');
+    }
+    else if constexpr (concepts::same_as_unordered_map<T>)
+    {
+        using key_type = typename T::key_type;
+        static_assert(std::same_as<key_type, std::string>, "json deserialization for unordered_map needs a std::string key!");
+
+        value.clear();
+        r.expect('{');
+        if (r.consume('}'))
+        {
+            return;
+        }
+
+        key_type key;
+        do
+        {
+            from_json(r, key);
+            r.expect(':');
+            read_value(r, value[key]);
+        } while (r.consume(','));
+        r.expect('}');
+    }
+    else if constexpr (concepts::same_as_optional<T>)
+    {
+        if (r.consume_literal("null"))
+        {
+            value.reset();
+        }
+        else
+        {
+            read_value(r, value.emplace());
+        }
+    }
+    else if constexpr (std::is_enum_v<T>)
+    {
+        if constexpr (requires { string_to_enum(T{}, std::string_view{}); })
+        {
+            value = string_to_enum(T{}, r.read_raw_string());
         }
         else
         {
-            oss << internal::to_json(member);
+            std::underlying_type_t<T> underlying{};
+            from_json(r, underlying);
+            value = static_cast<T>(underlying);
+        }
+    }
+    else if constexpr (std::same_as<T, std::string_view>)
+    {
+        value = r.read_borrowed_string();
+    }
+    else
+    {
+        static_assert(!std::same_as<T, const char*>, "const char* members cannot be decoded into, use std::string or std::string_view instead!");
+        from_json(r, value);
+    }
+}
+
+// jump table entry, decodes the next value into the member described by Descriptor
+template <typename T>
+struct member_reader
+{
+    template <typename Descriptor>
+    static void invoke(T& obj, reader& r)
+    {
+        if constexpr (std::is_function_v<typename Descriptor::member_type>)
+        {
+            r.skip_value();
+        }
+        else
+        {
+            read_value(r, ::krrs::reflect::get_member_variable<Descriptor>(obj));
+        }
+    }
+};
+
+// reads an object key, only unescaping into scratch when the key contains escape sequences
+inline std::string_view read_key(reader& r, std::string& scratch)
+{
+    std::string_view key = r.read_raw_string();
+    if (key.find('\\') != std::string_view::npos)
+    {
+        scratch.clear();
+        reader::unescape(key, scratch);
+        key = scratch;
+    }
+    r.expect(':');
+    return key;
+}
+
+// members that share a name, e.g. a member hiding a base class member, share a key. the writer emits one key per
+// member in for_each order, so the n-th occurrence of such a key belongs to the n-th member with that name
+template <::krrs::reflect::concepts::reflectable T>
+class key_occurrences
+{
+    static constexpr auto names = ::krrs::reflect::generate_member_names<T>();
+
+    // the next member with the same name, or the member itself when it is the last one
+    static constexpr auto next_same_name = [] {
+        std::array<std::size_t, names.size()> next{};
+        for (std::size_t i = 0; i != names.size(); ++i)
+        {
+            const auto found = std::ranges::find(names.begin() + static_cast<std::ptrdiff_t>(i) + 1, names.end(), names[i]);
+            next[i] = found == names.end() ? i : static_cast<std::size_t>(found - names.begin());
+        }
+        return next;
+    }();
+
+    static constexpr bool has_shared_names = !std::ranges::equal(next_same_name, std::views::iota(std::size_t{0}, names.size()));
+
+public:
+    // the member the key that member_lookup resolved to first stands for this time
+    std::size_t resolve(std::size_t first) noexcept
+    {
+        if constexpr (has_shared_names)
+        {
+            std::size_t index = first;
+            for (std::size_t n = seen_[first]++; n != 0 && next_same_name[index] != index; --n)
+            {
+                index = next_same_name[index];
+            }
+            return index;
         }
+        else
+        {
+            return first;
+        }
+    }
+
+private:
+    struct no_counts
+    {
+    };
+
+    [[no_unique_address]] std::conditional_t<has_shared_names, std::array<std::size_t, names.size()>, no_counts> seen_{};
+};
+
+// the members selected by MemberPtrs, flagged by their index in for_each order. MemberPtrs may name members of a
+// base class
+template <::krrs::reflect::concepts::reflectable T, auto... MemberPtrs>
+struct projection
+{
+    static constexpr std::size_t member_count = ::krrs::reflect::generate_meta_info<T>().size();
+
+    static constexpr std::array<bool, member_count> requested = [] {
+        std::array<bool, member_count> flags{};
+        ((flags[::krrs::reflect::descriptor_index<T, ::krrs::reflect::detail::descriptor_for<T, MemberPtrs>>()] = true), ...);
+        return flags;
+    }();
+
+    // the same, by the index member_lookup resolves their key to
+    static constexpr std::array<bool, member_count> requested_keys = [] {
+        std::array<bool, member_count> flags{};
+        ((flags[::krrs::reflect::member_lookup<T>.find(::krrs::reflect::detail::descriptor_for<T, MemberPtrs>::name)] = true), ...);
+        return flags;
+    }();
+
+    // repeated member pointers only count once
+    static constexpr std::size_t requested_count = static_cast<std::size_t>(std::ranges::count(requested, true));
+};
+
+// whether decoding T stores std::string_view anywhere, which only json::borrowed_document can back
+template <typename T>
+consteval bool has_borrowed_strings()
+{
+    if constexpr (::krrs::reflect::concepts::reflectable<T>)
+    {
+        return []<std::size_t... Is>(std::index_sequence<Is...>) {
+            return (has_borrowed_strings<typename ::krrs::reflect::detail::meta_type_underlying_type<::krrs::reflect::generate_meta_info<T>()[Is]>::member_type>()
+                    || ...);
+        }(std::make_index_sequence<::krrs::reflect::generate_meta_info<T>().size()>{});
+    }
+    else if constexpr (concepts::same_as_vector<T> || ::krrs::reflect::concepts::same_as_array_type<T> || concepts::same_as_optional<T>)
+    {
+        return has_borrowed_strings<typename T::value_type>();
+    }
+    else if constexpr (concepts::same_as_unordered_map<T>)
+    {
+        return has_borrowed_strings<typename T::mapped_type>();
+    }
+    else
+    {
+        return std::same_as<T, std::string_view>;
+    }
+}
+
+} // namespace internal
+
+template <::krrs::reflect::concepts::reflectable T, typename Sink>
+void convert_to_json(const T& obj, basic_writer<Sink>& w)
+{
+    w.write('{');
+    ::krrs::reflect::for_each<T>([&w, &obj]<typename Descriptor>() {
+        // pre-rendered `, "name": ` token, the separator is already part of it
+        w.write(::krrs::reflect::key_table<T, internal::key_format>::template token<Descriptor>());
+        internal::write_value(w, ::krrs::reflect::get_member_variable<Descriptor>(obj));
     });
-    oss << '}';
-    return oss.str();
+    w.write('}');
+}
+
+// writes straight to out, e.g. an io::fd_sink, without materializing the json first. large strings of obj may be
+// handed to the sink without being copied, they are released before this returns
+template <::krrs::reflect::concepts::reflectable T, io::sink Sink>
+void convert_to_json(const T& obj, Sink& out)
+{
+    basic_writer w{out};
+    w.reserve(estimated_size(obj));
+    convert_to_json(obj, w);
+    io::release_borrowed(out);
+}
+
+// reserves once up front (exactly max_serialized_size<T>() for fixed-size types), so out is never regrown while writing
+template <::krrs::reflect::concepts::reflectable T>
+void convert_to_json(const T& obj, std::string& out)
+{
+    io::string_sink sink{out};
+    convert_to_json(obj, sink);
+}
+
+template <::krrs::reflect::concepts::reflectable T>
+std::string convert_to_json(const T& obj)
+{
+    std::string out;
+    convert_to_json(obj, out);
+    return out;
+}
+
+template <::krrs::reflect::concepts::reflectable T>
+void convert_from_json(T& obj, reader& r)
+{
+    static constexpr auto& lookup = ::krrs::reflect::member_lookup<T>;
+    static constexpr auto readers = ::krrs::reflect::make_jump_table<T, void(T&, reader&), internal::member_reader<T>>();
+
+    r.expect('{');
+    if (r.consume('}'))
+    {
+        return;
+    }
+
+    internal::key_occurrences<T> occurrences;
+    std::string unescaped_key;
+    do
+    {
+        const std::string_view key = internal::read_key(r, unescaped_key);
+
+        // members are written straight from the input, keys that are not reflected are skipped over
+        if (const std::size_t index = lookup.find(key); index != lookup.npos)
+        {
+            readers[occurrences.resolve(index)](obj, r);
+        }
+        else
+        {
+            r.skip_value();
+        }
+    } while (r.consume(','));
+    r.expect('}');
 }
 
+// members missing from json are left untouched, unknown keys are ignored
 template <::krrs::reflect::concepts::reflectable T>
-void convert_from_json(T&, const std::string&)
+void convert_from_json(T& obj, std::string_view json)
+{
+    static_assert(!internal::has_borrowed_strings<T>(), "std::string_view members would dangle once json goes away, decode through json::borrowed_document!");
+    reader r{json};
+    convert_from_json(obj, r);
+    if (!r.at_end())
+    {
+        throw std::runtime_error{"unexpected trailing characters at offset " + std::to_string(r.position())};
+    }
+}
+
+// decodes only the members selected by MemberPtrs, every other value is skipped without being converted.
+// decoding stops as soon as all of the selected members have been read, so the rest of the object is never
+// looked at (nor validated) and the reader is left in the middle of it.
+template <::krrs::reflect::concepts::reflectable T, auto... MemberPtrs>
+    requires(sizeof...(MemberPtrs) > 0)
+void decode_only(T& obj, reader& r)
+{
+    using projection = internal::projection<T, MemberPtrs...>;
+    static constexpr auto& lookup = ::krrs::reflect::member_lookup<T>;
+    static constexpr auto readers = ::krrs::reflect::make_jump_table<T, void(T&, reader&), internal::member_reader<T>>();
+
+    r.expect('{');
+    if (r.consume('}'))
+    {
+        return;
+    }
+
+    std::array<bool, projection::member_count> seen{};
+    std::size_t remaining = projection::requested_count;
+    internal::key_occurrences<T> occurrences;
+    std::string unescaped_key;
+    do
+    {
+        const std::string_view key = internal::read_key(r, unescaped_key);
+        const std::size_t first = lookup.find(key);
+        if (first == lookup.npos || !projection::requested_keys[first])
+        {
+            r.skip_value();
+            continue;
+        }
+
+        if (const std::size_t index = occurrences.resolve(first); projection::requested[index])
+        {
+            readers[index](obj, r);
+            if (!std::exchange(seen[index], true) && --remaining == 0)
+            {
+                return;
+            }
+        }
+        else
+        {
+            r.skip_value();
+        }
+    } while (r.consume(','));
+    r.expect('}');
+}
+
+// e.g. decode_only<trade, &trade::price, &trade::qty>(json), members that are not selected are value initialized
+template <::krrs::reflect::concepts::reflectable T, auto... MemberPtrs>
+    requires(sizeof...(MemberPtrs) > 0)
+T decode_only(std::string_view json)
 {
-    // TODO: Implement me?
+    static_assert(!internal::has_borrowed_strings<T>(), "std::string_view members would dangle once json goes away, decode through json::borrowed_document!");
+    T obj{};
+    reader r{json};
+    decode_only<T, MemberPtrs...>(obj, r);
+    return obj;
 }
 
 } // namespace krrs::json
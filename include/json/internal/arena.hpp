@@ -0,0 +1,82 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace krrs::json::internal {
+
+// bump allocator for strings that cannot be borrowed straight from the input (i.e. they had to be unescaped).
+// stored strings never move, and clear() keeps the memory around for the next document
+class string_arena
+{
+public:
+    static constexpr std::size_t chunk_size = 4096;
+
+    // copies str into the arena, the returned view stays valid until clear() or the arena is destroyed
+    std::string_view store(std::string_view str)
+    {
+        if (str.size() > remaining_)
+        {
+            grow(str.size());
+        }
+
+        char* stored = chunks_[current_].get() + (chunk_capacity(current_) - remaining_);
+        std::memcpy(stored, str.data(), str.size());
+        remaining_ -= str.size();
+        return {stored, str.size()};
+    }
+
+    // reusable buffer to unescape into before storing
+    std::string& scratch() noexcept
+    {
+        return scratch_;
+    }
+
+    void clear() noexcept
+    {
+        current_ = 0;
+        remaining_ = chunks_.empty() ? 0 : chunk_capacity(0);
+    }
+
+private:
+    std::size_t chunk_capacity(std::size_t index) const noexcept
+    {
+        return capacities_[index];
+    }
+
+    void grow(std::size_t at_least)
+    {
+        // reuse the chunks kept by clear() before allocating new ones
+        while (current_ + 1 < chunks_.size())
+        {
+            ++current_;
+            remaining_ = chunk_capacity(current_);
+            if (remaining_ >= at_least)
+            {
+                return;
+            }
+        }
+
+        const std::size_t capacity = std::max(chunk_size, at_least);
+        chunks_.push_back(std::make_unique_for_overwrite<char[]>(capacity));
+        capacities_.push_back(capacity);
+        current_ = chunks_.size() - 1;
+        remaining_ = capacity;
+    }
+
+    std::vector<std::unique_ptr<char[]>> chunks_;
+    std::vector<std::size_t> capacities_;
+    std::size_t current_ = 0;
+    std::size_t remaining_ = 0;
+    std::string scratch_;
+};
+
+} // namespace krrs::json::internal
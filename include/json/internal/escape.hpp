@@ -0,0 +1,102 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "../../reflect/simd.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace krrs::json::internal {
+
+// quotes, backslashes and control characters have to be escaped in a json string, everything else (utf-8 included) is copied as is
+constexpr bool needs_escape(char c) noexcept
+{
+    return c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20;
+}
+
+inline std::size_t find_escape_scalar(const char* data, std::size_t size) noexcept
+{
+    std::size_t i = 0;
+    while (i != size && !needs_escape(data[i]))
+    {
+        ++i;
+    }
+    return i;
+}
+
+#if KRRS_SIMD_X86
+
+// c < 0x20 (unsigned) is spelled as min(c, 0x1F) == c, there is no unsigned byte compare
+inline std::size_t find_escape_sse2(const char* data, std::size_t size) noexcept
+{
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control = _mm_set1_epi8(0x1F);
+
+    std::size_t i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const __m128i escapes = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+                                             _mm_cmpeq_epi8(_mm_min_epu8(chunk, control), chunk));
+        if (const int mask = _mm_movemask_epi8(escapes); mask != 0)
+        {
+            return i + static_cast<std::size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+        }
+    }
+    return i + find_escape_scalar(data + i, size - i);
+}
+
+KRRS_TARGET_AVX2 inline std::size_t find_escape_avx2(const char* data, std::size_t size) noexcept
+{
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i control = _mm256_set1_epi8(0x1F);
+
+    std::size_t i = 0;
+    for (; i + 32 <= size; i += 32)
+    {
+        const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        const __m256i escapes = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote), _mm256_cmpeq_epi8(chunk, backslash)),
+                                                _mm256_cmpeq_epi8(_mm256_min_epu8(chunk, control), chunk));
+        if (const int mask = _mm256_movemask_epi8(escapes); mask != 0)
+        {
+            return i + static_cast<std::size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+        }
+    }
+    // the remainder is shorter than a register, let the sse2 kernel take at most one more step
+    return i + find_escape_sse2(data + i, size - i);
+}
+
+#endif
+
+using find_escape_fn = std::size_t (*)(const char*, std::size_t) noexcept;
+
+inline find_escape_fn select_find_escape(reflect::simd::level level) noexcept
+{
+#if KRRS_SIMD_X86
+    switch (reflect::simd::supported_level(level))
+    {
+    case reflect::simd::level::avx2:
+        return &find_escape_avx2;
+    case reflect::simd::level::sse2:
+        return &find_escape_sse2;
+    default:
+        break;
+    }
+#else
+    static_cast<void>(level);
+#endif
+    return &find_escape_scalar;
+}
+
+// index of the first character in [data, data + size) that needs escaping, size if the whole run can be copied as is
+inline std::size_t find_escape(const char* data, std::size_t size) noexcept
+{
+    static const find_escape_fn find = select_find_escape(reflect::simd::detected_level());
+    return find(data, size);
+}
+
+} // namespace krrs::json::internal
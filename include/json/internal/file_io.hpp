@@ -0,0 +1,72 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+namespace krrs::json::internal {
+
+// the input of ndjson_reader, either a posix file descriptor or a stdio stream, never owned. output goes through
+// io::fd_sink and io::file_sink
+class file_handle
+{
+public:
+    explicit file_handle(int fd)
+        : fd_{fd}
+    {
+        if (fd < 0)
+        {
+            throw std::invalid_argument{"invalid file descriptor: " + std::to_string(fd)};
+        }
+    }
+
+    explicit file_handle(std::FILE* file)
+        : file_{file}
+    {
+        if (file == nullptr)
+        {
+            throw std::invalid_argument{"file must not be null"};
+        }
+    }
+
+    // reads up to size bytes, returns 0 once the end of the input is reached
+    std::size_t read_some(char* data, std::size_t size) const
+    {
+        if (file_ != nullptr)
+        {
+            const std::size_t read = std::fread(data, 1, size, file_);
+            if (read == 0 && std::ferror(file_) != 0)
+            {
+                throw std::runtime_error{"failed to read from file: " + std::string{std::strerror(errno)}};
+            }
+            return read;
+        }
+
+        while (true)
+        {
+            const ssize_t read = ::read(fd_, data, size);
+            if (read >= 0)
+            {
+                return static_cast<std::size_t>(read);
+            }
+
+            if (errno != EINTR)
+            {
+                throw std::runtime_error{"failed to read from file descriptor: " + std::string{std::strerror(errno)}};
+            }
+        }
+    }
+
+private:
+    int fd_ = -1;
+    std::FILE* file_ = nullptr;
+};
+
+} // namespace krrs::json::internal
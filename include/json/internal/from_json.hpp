@@ -3,39 +3,55 @@
 
 #pragma once
 
-#include <sstream>
+#include "../reader.hpp"
 
-namespace krrs::json::internal {
+#include <concepts>
+#include <limits>
+#include <stdexcept>
+#include <string>
 
-inline void skip_whitespace(std::istringstream& iss)
-{
-    iss >> std::ws;
-}
+namespace krrs::json::internal {
 
-inline void expect(std::istringstream& iss, char expected)
+template <typename T>
+    requires(std::integral<T> || std::floating_point<T>)
+void from_json(reader& r, T& value)
 {
-    skip_whitespace(iss);
-
-    const int c = iss.peek();
-    if (c == std::char_traits<char>::eof())
+    if constexpr (std::same_as<T, bool>)
     {
-        throw std::runtime_error{"unexpected end of input. Expected: '" + std::string{expected} + "'"};
+        value = r.read_bool();
     }
-
-    if (static_cast<char>(c) != expected)
+    else if constexpr (std::same_as<T, char>)
     {
-        throw std::runtime_error{"expected: '" + std::string{expected} + "', got: '" + static_cast<char>(c) + "'"};
+        // chars are written as single character strings, control characters / quotes as an escape sequence
+        const std::string_view raw = r.read_raw_string();
+        std::string unescaped;
+        std::string_view text = raw;
+        if (raw.find('\\') != std::string_view::npos)
+        {
+            reader::unescape(raw, unescaped);
+            text = unescaped;
+        }
+        if (text.size() != 1)
+        {
+            throw std::runtime_error{"expected a single character string, got: \"" + std::string{raw} + '"'};
+        }
+        value = text.front();
+    }
+    else if constexpr (std::floating_point<T>)
+    {
+        // non-finite values are written as null
+        value = r.consume_literal("null") ? std::numeric_limits<T>::quiet_NaN() : r.read_number<T>();
+    }
+    else
+    {
+        value = r.read_number<T>();
     }
-
-    iss.ignore();
 }
 
-inline std::string parse_string(std::istringstream& iss)
+inline void from_json(reader& r, std::string& value)
 {
-    // e.g. "key"
-    skip_whitespace(iss);
-    // TODO: Implement me!
-    return {};
+    value.clear();
+    r.read_string(value);
 }
 
 } // namespace krrs::json::internal
@@ -0,0 +1,241 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "../../reflect/simd.hpp"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace krrs::json::internal {
+
+// raw character classes of one 64 byte block, bit i describes block[i]
+struct block_classes
+{
+    std::uint64_t quotes = 0;
+    std::uint64_t backslashes = 0;
+    // { } [ ] : ,
+    std::uint64_t operators = 0;
+};
+
+inline constexpr std::size_t block_size = 64;
+
+inline block_classes classify_block_scalar(const char* block) noexcept
+{
+    block_classes classes{};
+    for (std::size_t i = 0; i != block_size; ++i)
+    {
+        const std::uint64_t bit = std::uint64_t{1} << i;
+        switch (block[i])
+        {
+        case '"':
+            classes.quotes |= bit;
+            break;
+        case '\\':
+            classes.backslashes |= bit;
+            break;
+        case '{':
+        case '}':
+        case '[':
+        case ']':
+        case ':':
+        case ',':
+            classes.operators |= bit;
+            break;
+        default:
+            break;
+        }
+    }
+    return classes;
+}
+
+#if KRRS_SIMD_X86
+
+// {, [ and }, ] only differ by 0x20, so or-ing that bit in folds the four brackets into two compares
+inline block_classes classify_block_sse2(const char* block) noexcept
+{
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i open = _mm_set1_epi8('{');
+    const __m128i close = _mm_set1_epi8('}');
+    const __m128i colon = _mm_set1_epi8(':');
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i fold = _mm_set1_epi8(0x20);
+
+    block_classes classes{};
+    for (std::size_t i = 0; i != block_size; i += 16)
+    {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i));
+        const __m128i folded = _mm_or_si128(chunk, fold);
+        const __m128i operators = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(folded, open), _mm_cmpeq_epi8(folded, close)),
+                                               _mm_or_si128(_mm_cmpeq_epi8(chunk, colon), _mm_cmpeq_epi8(chunk, comma)));
+
+        classes.quotes |= std::uint64_t{static_cast<std::uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, quote)))} << i;
+        classes.backslashes |= std::uint64_t{static_cast<std::uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, backslash)))} << i;
+        classes.operators |= std::uint64_t{static_cast<std::uint16_t>(_mm_movemask_epi8(operators))} << i;
+    }
+    return classes;
+}
+
+KRRS_TARGET_AVX2 inline block_classes classify_block_avx2(const char* block) noexcept
+{
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i open = _mm256_set1_epi8('{');
+    const __m256i close = _mm256_set1_epi8('}');
+    const __m256i colon = _mm256_set1_epi8(':');
+    const __m256i comma = _mm256_set1_epi8(',');
+    const __m256i fold = _mm256_set1_epi8(0x20);
+
+    block_classes classes{};
+    for (std::size_t i = 0; i != block_size; i += 32)
+    {
+        const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + i));
+        const __m256i folded = _mm256_or_si256(chunk, fold);
+        const __m256i operators = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(folded, open), _mm256_cmpeq_epi8(folded, close)),
+                                                  _mm256_or_si256(_mm256_cmpeq_epi8(chunk, colon), _mm256_cmpeq_epi8(chunk, comma)));
+
+        // lambdas do not inherit the target attribute, so the movemasks are spelled out
+        classes.quotes |= std::uint64_t{static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, quote)))} << i;
+        classes.backslashes |= std::uint64_t{static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, backslash)))} << i;
+        classes.operators |= std::uint64_t{static_cast<std::uint32_t>(_mm256_movemask_epi8(operators))} << i;
+    }
+    return classes;
+}
+
+#endif
+
+using classify_block_fn = block_classes (*)(const char*) noexcept;
+
+inline classify_block_fn select_classifier(reflect::simd::level level) noexcept
+{
+#if KRRS_SIMD_X86
+    switch (reflect::simd::supported_level(level))
+    {
+    case reflect::simd::level::avx2:
+        return &classify_block_avx2;
+    case reflect::simd::level::sse2:
+        return &classify_block_sse2;
+    default:
+        break;
+    }
+#else
+    static_cast<void>(level);
+#endif
+    return &classify_block_scalar;
+}
+
+// bits of every character preceded by an odd run of backslashes. carry holds whether the first character of the
+// next block is escaped by a run ending this block
+constexpr std::uint64_t find_escaped(std::uint64_t backslashes, std::uint64_t& carry) noexcept
+{
+    constexpr std::uint64_t even_bits = 0x5555555555555555ull;
+
+    // a backslash escaped by the previous block does not start a run
+    backslashes &= ~carry;
+    const std::uint64_t follows_escape = (backslashes << 1) | carry;
+
+    // adding the run starts on odd bits to the backslashes carries them to the end of the run, flipping the parity of those runs
+    const std::uint64_t odd_starts = backslashes & ~even_bits & ~follows_escape;
+    const std::uint64_t runs = odd_starts + backslashes;
+    carry = runs < backslashes ? 1 : 0;
+
+    const std::uint64_t invert = runs << 1;
+    return (even_bits ^ invert) & follows_escape;
+}
+
+// bit i is the xor of bits [0, i], i.e. set for every position between an opening quote and its closing quote
+constexpr std::uint64_t prefix_xor(std::uint64_t bits) noexcept
+{
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+    return bits;
+}
+
+// incremental stage 1: classifies the input 64 bytes at a time and yields the positions of every structural character
+// outside of strings, as well as every unescaped quote. blocks are only indexed when the reader asks past the ones it
+// already has, so a reader that stops early never pays for the rest of the input.
+class structural_index
+{
+public:
+    static constexpr std::size_t npos = std::string_view::npos;
+
+    explicit structural_index(std::string_view input, reflect::simd::level level = reflect::simd::detected_level()) noexcept
+        : input_{input}
+        , classify_{select_classifier(level)}
+    {
+    }
+
+    // position of the first structural character or unescaped quote at or after pos, npos if there is none
+    std::size_t next(std::size_t pos) noexcept
+    {
+        while (true)
+        {
+            if (pos < block_end_)
+            {
+                const std::uint64_t mask = pos < block_start_ ? structurals_ : structurals_ & (~std::uint64_t{0} << (pos - block_start_));
+                if (mask != 0)
+                {
+                    return block_start_ + static_cast<std::size_t>(std::countr_zero(mask));
+                }
+            }
+
+            if (block_end_ >= input_.size())
+            {
+                return npos;
+            }
+            index_block(block_end_);
+        }
+    }
+
+    // whether the input ended inside a string, only meaningful once next() has returned npos
+    bool in_string() const noexcept
+    {
+        return in_string_ != 0;
+    }
+
+private:
+    void index_block(std::size_t start) noexcept
+    {
+        block_classes classes{};
+        if (input_.size() - start >= block_size)
+        {
+            classes = classify_(input_.data() + start);
+        }
+        else
+        {
+            // pad the tail with spaces, they are never structural
+            char tail[block_size];
+            std::memset(tail, ' ', block_size);
+            std::memcpy(tail, input_.data() + start, input_.size() - start);
+            classes = classify_(tail);
+        }
+
+        const std::uint64_t quotes = classes.quotes & ~find_escaped(classes.backslashes, escape_carry_);
+        const std::uint64_t string_mask = prefix_xor(quotes) ^ in_string_;
+        // broadcast the last bit, it tells whether the next block starts inside a string
+        in_string_ = std::uint64_t{0} - (string_mask >> 63);
+
+        block_start_ = start;
+        block_end_ = start + block_size;
+        structurals_ = (classes.operators & ~string_mask) | quotes;
+    }
+
+    std::string_view input_;
+    classify_block_fn classify_;
+    std::size_t block_start_ = 0;
+    std::size_t block_end_ = 0;
+    std::uint64_t structurals_ = 0;
+    std::uint64_t in_string_ = 0;
+    std::uint64_t escape_carry_ = 0;
+};
+
+} // namespace krrs::json::internal
@@ -3,39 +3,63 @@
 
 #pragma once
 
+#include "../writer.hpp"
+
+#include <algorithm>
 #include <concepts>
+#include <cstddef>
 #include <string>
+#include <string_view>
 
 namespace krrs::json::internal {
 
-template <typename T>
+// key format for ::krrs::reflect::key_table, renders `"name": ` for the first member and `, "name": ` for the rest
+struct key_format
+{
+    static constexpr std::size_t token_size(std::string_view name, std::size_t index)
+    {
+        return (index == 0 ? 0 : 2) + name.size() + 4;
+    }
+
+    static constexpr char* write_token(char* out, std::string_view name, std::size_t index)
+    {
+        if (index != 0)
+        {
+            *out++ = ',';
+            *out++ = ' ';
+        }
+        *out++ = '"';
+        out = std::ranges::copy(name, out).out;
+        *out++ = '"';
+        *out++ = ':';
+        *out++ = ' ';
+        return out;
+    }
+};
+
+template <typename Sink, typename T>
     requires(std::integral<T> || std::floating_point<T>)
-auto to_json(T value)
+void to_json(basic_writer<Sink>& w, T value)
 {
     if constexpr (std::same_as<T, bool>)
     {
-        return value ? "true" : "false";
+        w.write(value ? std::string_view{"true"} : std::string_view{"false"});
     }
     else if constexpr (std::same_as<T, char>)
     {
-        return std::string{'"'} + value + '"';
+        w.write_string(std::string_view{&value, 1});
     }
     else
     {
-        return value;
+        w.write_number(value);
     }
 }
 
-template <std::convertible_to<std::string> T>
-std::string to_json(const T& value)
-{
-    return std::string{'"'} + value + '"';
-}
-
-template <std::same_as<std::string_view> T>
-std::string_view to_json(T value)
+// string members are borrowed, see io::write_borrowed
+template <typename Sink, std::convertible_to<std::string_view> T>
+void to_json(basic_writer<Sink>& w, const T& value)
 {
-    return to_json(std::string{value});
+    w.write_borrowed_string(std::string_view{value});
 }
 
 } // namespace krrs::json::internal
@@ -0,0 +1,268 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "../../include/io/sink.hpp"
+#include "convert.hpp"
+#include "internal/file_io.hpp"
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace krrs::json {
+
+// streams reflected records as newline-delimited json. records are rendered into one reusable buffer that is
+// handed to an io::fd_sink or io::file_sink whenever it fills up, so memory use does not depend on how many records
+// are written. the file is not owned and is flushed on destruction, call flush() to observe write errors.
+template <::krrs::reflect::concepts::reflectable T>
+class ndjson_writer
+{
+public:
+    static constexpr std::size_t default_capacity = 64 * 1024;
+
+    // a full buffer is at least the capacity of the fd_sink, so it goes out with writev without being staged again
+    explicit ndjson_writer(int fd, std::size_t capacity = default_capacity)
+        : output_{std::in_place_type<io::fd_sink>, fd, checked_capacity(capacity)}
+        , capacity_{capacity}
+    {
+        buffer_.reserve(capacity);
+    }
+
+    explicit ndjson_writer(std::FILE* file, std::size_t capacity = default_capacity)
+        : output_{std::in_place_type<io::file_sink>, file}
+        , capacity_{checked_capacity(capacity)}
+    {
+        buffer_.reserve(capacity);
+    }
+
+    ndjson_writer(const ndjson_writer&) = delete;
+    ndjson_writer& operator=(const ndjson_writer&) = delete;
+
+    ~ndjson_writer()
+    {
+        try
+        {
+            flush();
+        }
+        catch (const std::exception&)
+        {
+            // destructors cannot report, the error is only visible through an explicit flush()
+        }
+    }
+
+    void write(const T& record)
+    {
+        writer w{buffer_};
+        convert_to_json(record, w);
+        w.write('\n');
+        if (buffer_.size() >= capacity_)
+        {
+            write_buffer();
+        }
+    }
+
+    template <std::ranges::input_range R>
+        requires std::convertible_to<std::ranges::range_reference_t<R>, const T&>
+    void write_all(R&& records)
+    {
+        for (const T& record : records)
+        {
+            write(record);
+        }
+    }
+
+    // hands every buffered record to the file
+    void flush()
+    {
+        write_buffer();
+        std::visit([](auto& sink) { sink.flush(); }, output_);
+    }
+
+private:
+    static std::size_t checked_capacity(std::size_t capacity)
+    {
+        if (capacity == 0)
+        {
+            throw std::invalid_argument{"ndjson_writer needs a non-zero buffer capacity"};
+        }
+        return capacity;
+    }
+
+    void write_buffer()
+    {
+        std::visit([this](auto& sink) { sink.write(buffer_.data(), buffer_.size()); }, output_);
+        buffer_.clear();
+    }
+
+    std::variant<io::fd_sink, io::file_sink> output_;
+    std::size_t capacity_;
+    std::string buffer_;
+};
+
+// reads newline-delimited json records one at a time through a fixed-size buffer. a line longer than the buffer
+// grows it to fit, so memory use is bounded by the longest record rather than the size of the file.
+// blank lines are skipped. the reader is an input range, e.g. for (const auto& record : reader)
+template <::krrs::reflect::concepts::reflectable T>
+class ndjson_reader
+{
+public:
+    static constexpr std::size_t default_capacity = 64 * 1024;
+
+    class iterator
+    {
+    public:
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+
+        explicit iterator(ndjson_reader& reader)
+            : reader_{&reader}
+        {
+            ++*this;
+        }
+
+        const T& operator*() const
+        {
+            return reader_->record_;
+        }
+
+        iterator& operator++()
+        {
+            if (!reader_->read(reader_->record_))
+            {
+                reader_ = nullptr;
+            }
+            return *this;
+        }
+
+        void operator++(int)
+        {
+            ++*this;
+        }
+
+        friend bool operator==(const iterator& it, std::default_sentinel_t) noexcept
+        {
+            return it.reader_ == nullptr;
+        }
+
+    private:
+        ndjson_reader* reader_ = nullptr;
+    };
+
+    explicit ndjson_reader(int fd, std::size_t capacity = default_capacity)
+        : ndjson_reader{internal::file_handle{fd}, capacity}
+    {
+    }
+
+    explicit ndjson_reader(std::FILE* file, std::size_t capacity = default_capacity)
+        : ndjson_reader{internal::file_handle{file}, capacity}
+    {
+    }
+
+    ndjson_reader(const ndjson_reader&) = delete;
+    ndjson_reader& operator=(const ndjson_reader&) = delete;
+
+    // decodes the next record into record, returns false once the input is exhausted
+    bool read(T& record)
+    {
+        std::string_view line;
+        while (next_line(line))
+        {
+            ++line_number_;
+            if (line.find_first_not_of(" \t\r") == std::string_view::npos)
+            {
+                continue;
+            }
+
+            record = T{};
+            try
+            {
+                convert_from_json(record, line);
+            }
+            catch (const std::runtime_error& e)
+            {
+                throw std::runtime_error{"ndjson line " + std::to_string(line_number_) + ": " + e.what()};
+            }
+            return true;
+        }
+        return false;
+    }
+
+    iterator begin()
+    {
+        return iterator{*this};
+    }
+
+    std::default_sentinel_t end() const noexcept
+    {
+        return std::default_sentinel;
+    }
+
+private:
+    ndjson_reader(internal::file_handle input, std::size_t capacity)
+        : input_{input}
+    {
+        if (capacity == 0)
+        {
+            throw std::invalid_argument{"ndjson_reader needs a non-zero buffer capacity"};
+        }
+        buffer_.resize(capacity);
+    }
+
+    bool next_line(std::string_view& line)
+    {
+        while (true)
+        {
+            const char* first = buffer_.data() + begin_;
+            if (const void* newline = std::memchr(first, '\n', end_ - begin_); newline != nullptr)
+            {
+                const std::size_t length = static_cast<std::size_t>(static_cast<const char*>(newline) - first);
+                line = std::string_view{first, length};
+                begin_ += length + 1;
+                return true;
+            }
+
+            if (eof_)
+            {
+                // the last line does not need a trailing newline
+                line = std::string_view{first, end_ - begin_};
+                begin_ = end_;
+                return !line.empty();
+            }
+
+            // keep the partial line, and only grow when it alone fills the buffer
+            std::memmove(buffer_.data(), first, end_ - begin_);
+            end_ -= begin_;
+            begin_ = 0;
+            if (end_ == buffer_.size())
+            {
+                buffer_.resize(buffer_.size() * 2);
+            }
+
+            const std::size_t read = input_.read_some(buffer_.data() + end_, buffer_.size() - end_);
+            eof_ = read == 0;
+            end_ += read;
+        }
+    }
+
+    internal::file_handle input_;
+    std::vector<char> buffer_;
+    std::size_t begin_ = 0;
+    std::size_t end_ = 0;
+    std::size_t line_number_ = 0;
+    bool eof_ = false;
+    T record_{};
+};
+
+} // namespace krrs::json
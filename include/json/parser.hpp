@@ -7,23 +7,59 @@
 
 namespace krrs::json {
 
+// expects the layout written by serialize, e.g. {"class_name": {...}}
 template <krrs::reflect::concepts::reflectable T>
-T deserialize(const std::string&)
+T deserialize(std::string_view json)
 {
+    static_assert(!internal::has_borrowed_strings<T>(), "std::string_view members would dangle once json goes away, decode through json::borrowed_document!");
     static constexpr std::string_view class_name = ::krrs::reflect::utility::get_short_name<T>();
+    reader r{json};
+    r.expect('{');
+    if (const std::string_view key = r.read_raw_string(); key != class_name)
+    {
+        throw std::runtime_error{"expected json for " + std::string{class_name} + ", got: " + std::string{key}};
+    }
+    r.expect(':');
+
     T obj{};
-    return {};
+    convert_from_json(obj, r);
+    r.expect('}');
+    if (!r.at_end())
+    {
+        throw std::runtime_error{"unexpected trailing characters at offset " + std::to_string(r.position())};
+    }
+    return obj;
+}
+
+// writes the serialized object to out, e.g. {"class_name": {...}}
+template <krrs::reflect::concepts::reflectable T, io::sink Sink>
+void serialize(const T& obj, Sink& out)
+{
+    static constexpr std::string_view class_name = ::krrs::reflect::utility::get_short_name<T>();
+    basic_writer w{out};
+    w.reserve(class_name.size() + 6 + estimated_size(obj));
+    w.write('{');
+    w.write_string(class_name);
+    w.write(": ");
+    convert_to_json(obj, w);
+    w.write('}');
+    io::release_borrowed(out);
+}
+
+// appends the serialized object to the end of out
+template <krrs::reflect::concepts::reflectable T>
+void serialize(const T& obj, std::string& out)
+{
+    io::string_sink sink{out};
+    serialize(obj, sink);
 }
 
 template <krrs::reflect::concepts::reflectable T>
 std::string serialize(const T& obj)
 {
-    static constexpr std::string_view class_name = ::krrs::reflect::utility::get_short_name<T>();
-    std::ostringstream oss;
-    oss << '{' << std::quoted(class_name) << ": ";
-    oss << convert_to_json(obj);
-    oss << '}';
-    return oss.str();
+    std::string out;
+    serialize(obj, out);
+    return out;
 }
 
 } // namespace krrs::json
@@ -0,0 +1,413 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "internal/arena.hpp"
+#include "internal/structural_index.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace krrs::json {
+
+// forward-only cursor over a json document. the input is never copied; every token is
+// read straight out of the caller's buffer, and strings are only copied when they are stored.
+// string, number and skipped value extents come from the structural index rather than a byte by byte scan.
+class reader
+{
+public:
+    explicit reader(std::string_view input, reflect::simd::level level = reflect::simd::detected_level()) noexcept
+        : input_{input}
+        , index_{input, level}
+    {
+    }
+
+    // strings read through read_borrowed_string point into input, or into arena when they had to be unescaped.
+    // both have to outlive whatever the strings are decoded into, json::borrowed_document ties the three together
+    reader(std::string_view input, internal::string_arena& arena, reflect::simd::level level = reflect::simd::detected_level()) noexcept
+        : input_{input}
+        , index_{input, level}
+        , arena_{&arena}
+    {
+    }
+
+    void skip_whitespace() noexcept
+    {
+        while (pos_ != input_.size() && is_whitespace(input_[pos_]))
+        {
+            ++pos_;
+        }
+    }
+
+    // returns the next non-whitespace character without consuming it
+    char peek()
+    {
+        skip_whitespace();
+        if (pos_ == input_.size())
+        {
+            throw std::runtime_error{"unexpected end of input"};
+        }
+        return input_[pos_];
+    }
+
+    void expect(char expected)
+    {
+        skip_whitespace();
+        if (pos_ == input_.size())
+        {
+            throw std::runtime_error{"unexpected end of input. Expected: '" + std::string{expected} + "'"};
+        }
+
+        if (input_[pos_] != expected)
+        {
+            throw std::runtime_error{"expected: '" + std::string{expected} + "', got: '" + input_[pos_] + "' at offset " + std::to_string(pos_)};
+        }
+        ++pos_;
+    }
+
+    // consumes the next non-whitespace character if it matches
+    bool consume(char c) noexcept
+    {
+        skip_whitespace();
+        if (pos_ != input_.size() && input_[pos_] == c)
+        {
+            ++pos_;
+            return true;
+        }
+        return false;
+    }
+
+    // consumes a bare literal (e.g. null) if it is next in the input
+    bool consume_literal(std::string_view literal) noexcept
+    {
+        skip_whitespace();
+        if (input_.substr(pos_).starts_with(literal))
+        {
+            pos_ += literal.size();
+            return true;
+        }
+        return false;
+    }
+
+    // returns the raw contents between the next pair of quotes, escape sequences are left untouched
+    std::string_view read_raw_string()
+    {
+        expect('"');
+        const std::size_t start = pos_;
+        // the index never reports anything inside a string, so the next entry is the closing quote
+        const std::size_t end = index_.next(start);
+        if (end == internal::structural_index::npos || input_[end] != '"')
+        {
+            throw std::runtime_error{"unterminated string starting at offset " + std::to_string(start)};
+        }
+
+        pos_ = end + 1;
+        return input_.substr(start, end - start);
+    }
+
+    // reads the next string and appends its unescaped contents to out
+    void read_string(std::string& out)
+    {
+        unescape(read_raw_string(), out);
+    }
+
+    // reads the next string without copying it, unless it has to be unescaped
+    std::string_view read_borrowed_string()
+    {
+        if (arena_ == nullptr)
+        {
+            throw std::runtime_error{"std::string_view members can only be decoded through json::borrowed_document"};
+        }
+
+        const std::string_view raw = read_raw_string();
+        if (raw.find('\\') == std::string_view::npos)
+        {
+            return raw;
+        }
+
+        std::string& unescaped = arena_->scratch();
+        unescaped.clear();
+        unescape(raw, unescaped);
+        return arena_->store(unescaped);
+    }
+
+    template <typename T>
+        requires(std::integral<T> || std::floating_point<T>)
+    T read_number()
+    {
+        skip_whitespace();
+        const std::size_t start = pos_;
+        skip_scalar();
+
+        const char* first = input_.data() + start;
+        const char* last = input_.data() + pos_;
+        // from_chars also takes nan, inf, 01, .5 and 5., none of which are json
+        T value{};
+        const auto [ptr, ec] = std::from_chars(first, last, value);
+        if (!is_number(input_.substr(start, pos_ - start)) || ec != std::errc{} || ptr != last)
+        {
+            throw std::runtime_error{"invalid number '" + std::string{first, last} + "' at offset " + std::to_string(start)};
+        }
+        return value;
+    }
+
+    bool read_bool()
+    {
+        if (consume_literal("true"))
+        {
+            return true;
+        }
+
+        if (consume_literal("false"))
+        {
+            return false;
+        }
+        throw std::runtime_error{"expected a boolean at offset " + std::to_string(pos_)};
+    }
+
+    // skips over the next value of any type without converting it
+    void skip_value()
+    {
+        const char c = peek();
+        if (c == '"')
+        {
+            read_raw_string();
+        }
+        else if (c == '{' || c == '[')
+        {
+            skip_container();
+        }
+        else
+        {
+            skip_scalar();
+        }
+    }
+
+    bool at_end() noexcept
+    {
+        skip_whitespace();
+        return pos_ == input_.size();
+    }
+
+    std::size_t position() const noexcept
+    {
+        return pos_;
+    }
+
+    static void unescape(std::string_view raw, std::string& out)
+    {
+        std::size_t pos = 0;
+        while (true)
+        {
+            const std::size_t escape = raw.find('\\', pos);
+            out.append(raw.substr(pos, escape - pos));
+            if (escape == std::string_view::npos)
+            {
+                return;
+            }
+
+            if (escape + 1 == raw.size())
+            {
+                throw std::runtime_error{"dangling escape character in string"};
+            }
+
+            pos = escape + 2;
+            switch (raw[escape + 1])
+            {
+            case '"':
+                out.push_back('"');
+                break;
+            case '\\':
+                out.push_back('\\');
+                break;
+            case '/':
+                out.push_back('/');
+                break;
+            case 'b':
+                out.push_back('\b');
+                break;
+            case 'f':
+                out.push_back('\f');
+                break;
+            case 'n':
+                out.push_back('\n');
+                break;
+            case 'r':
+                out.push_back('\r');
+                break;
+            case 't':
+                out.push_back('\t');
+                break;
+            case 'u':
+                pos = append_unicode_escape(raw, escape, out);
+                break;
+            default:
+                throw std::runtime_error{"invalid escape sequence '\\" + std::string{raw[escape + 1]} + "'"};
+            }
+        }
+    }
+
+private:
+    static constexpr bool is_whitespace(char c) noexcept
+    {
+        return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+    }
+
+    // -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+    static constexpr bool is_number(std::string_view str) noexcept
+    {
+        std::size_t i = 0;
+        const auto digits = [&str, &i] {
+            const std::size_t start = i;
+            while (i != str.size() && str[i] >= '0' && str[i] <= '9')
+            {
+                ++i;
+            }
+            return i - start;
+        };
+
+        if (i != str.size() && str[i] == '-')
+        {
+            ++i;
+        }
+        const bool leading_zero = i != str.size() && str[i] == '0';
+        const std::size_t integer_digits = digits();
+        if (integer_digits == 0 || (leading_zero && integer_digits != 1))
+        {
+            return false;
+        }
+        if (i != str.size() && str[i] == '.')
+        {
+            ++i;
+            if (digits() == 0)
+            {
+                return false;
+            }
+        }
+        if (i != str.size() && (str[i] == 'e' || str[i] == 'E'))
+        {
+            ++i;
+            if (i != str.size() && (str[i] == '+' || str[i] == '-'))
+            {
+                ++i;
+            }
+            if (digits() == 0)
+            {
+                return false;
+            }
+        }
+        return i == str.size();
+    }
+
+    // numbers and literals run until the next structural character, minus any whitespace in between
+    void skip_scalar() noexcept
+    {
+        std::size_t end = std::min(index_.next(pos_), input_.size());
+        while (end != pos_ && is_whitespace(input_[end - 1]))
+        {
+            --end;
+        }
+        pos_ = end;
+    }
+
+    void skip_container()
+    {
+        // brace / bracket balanced skip. quotes come in pairs and the index never reports anything between them,
+        // so strings need no special treatment
+        std::size_t depth = 0;
+        do
+        {
+            const std::size_t next = index_.next(pos_);
+            if (next == internal::structural_index::npos)
+            {
+                throw std::runtime_error{"unterminated object or array"};
+            }
+
+            pos_ = next + 1;
+            switch (input_[next])
+            {
+            case '{':
+            case '[':
+                ++depth;
+                break;
+            case '}':
+            case ']':
+                --depth;
+                break;
+            default:
+                break;
+            }
+        } while (depth != 0);
+    }
+
+    static std::uint32_t parse_hex4(std::string_view raw, std::size_t pos)
+    {
+        std::uint32_t value = 0;
+        const char* first = raw.data() + pos;
+        if (pos + 4 > raw.size() || std::from_chars(first, first + 4, value, 16).ptr != first + 4)
+        {
+            throw std::runtime_error{"invalid \\u escape sequence"};
+        }
+        return value;
+    }
+
+    // decodes \uXXXX (and surrogate pairs) at raw[escape] to utf-8, returns the position after the sequence
+    static std::size_t append_unicode_escape(std::string_view raw, std::size_t escape, std::string& out)
+    {
+        std::uint32_t code_point = parse_hex4(raw, escape + 2);
+        std::size_t next = escape + 6;
+
+        if (code_point >= 0xD800 && code_point <= 0xDBFF)
+        {
+            if (raw.substr(next, 2) != "\\u")
+            {
+                throw std::runtime_error{"unpaired utf-16 surrogate in \\u escape sequence"};
+            }
+            const std::uint32_t low = parse_hex4(raw, next + 2);
+            if (low < 0xDC00 || low > 0xDFFF)
+            {
+                throw std::runtime_error{"invalid utf-16 low surrogate in \\u escape sequence"};
+            }
+            code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+            next += 6;
+        }
+
+        if (code_point < 0x80)
+        {
+            out.push_back(static_cast<char>(code_point));
+        }
+        else if (code_point < 0x800)
+        {
+            out.push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+            out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+        }
+        else if (code_point < 0x10000)
+        {
+            out.push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+        }
+        else
+        {
+            out.push_back(static_cast<char>(0xF0 | (code_point >> 18)));
+            out.push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+        }
+        return next;
+    }
+
+    std::string_view input_;
+    internal::structural_index index_;
+    internal::string_arena* arena_ = nullptr;
+    std::size_t pos_ = 0;
+};
+
+} // namespace krrs::json
@@ -0,0 +1,207 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "../../include/reflect/key_table.hpp"
+#include "../../include/reflect/reflect.hpp"
+#include "concepts.hpp"
+#include "internal/to_json.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace krrs::json {
+
+namespace internal {
+
+consteval std::size_t decimal_digits(std::size_t value)
+{
+    std::size_t digits = 1;
+    while (value >= 10)
+    {
+        value /= 10;
+        ++digits;
+    }
+    return digits;
+}
+
+template <typename T>
+    requires(std::integral<T> || std::floating_point<T>)
+consteval std::size_t max_number_size()
+{
+    if constexpr (std::same_as<T, bool>)
+    {
+        return std::string_view{"false"}.size();
+    }
+    else if constexpr (std::same_as<T, char>)
+    {
+        // the longest escape, "\u0000"
+        return 8;
+    }
+    else if constexpr (std::integral<T>)
+    {
+        return static_cast<std::size_t>(std::numeric_limits<T>::digits10) + 1 + (std::is_signed_v<T> ? 1 : 0);
+    }
+    else
+    {
+        // shortest round-trip never needs more than max_digits10 significant digits, e.g. -2.2250738585072014e-308
+        constexpr std::size_t mantissa = static_cast<std::size_t>(std::numeric_limits<T>::max_digits10) + 1;
+        constexpr std::size_t exponent = 2 + decimal_digits(static_cast<std::size_t>(-std::numeric_limits<T>::min_exponent10) + 1);
+        return 1 + mantissa + exponent;
+    }
+}
+
+template <typename T>
+consteval bool has_fixed_size();
+
+template <::krrs::reflect::concepts::reflectable T>
+consteval bool has_fixed_size_members()
+{
+    return []<std::size_t... Is>(std::index_sequence<Is...>) {
+        return (has_fixed_size<typename ::krrs::reflect::detail::meta_type_underlying_type<::krrs::reflect::generate_meta_info<T>()[Is]>::member_type>()
+                && ...);
+    }(std::make_index_sequence<::krrs::reflect::generate_meta_info<T>().size()>{});
+}
+
+template <typename T>
+consteval bool has_fixed_size()
+{
+    if constexpr (::krrs::reflect::concepts::reflectable<T>)
+    {
+        return has_fixed_size_members<T>();
+    }
+    else if constexpr (::krrs::reflect::concepts::same_as_array_type<T> || concepts::same_as_optional<T>)
+    {
+        return has_fixed_size<typename T::value_type>();
+    }
+    else if constexpr (std::is_enum_v<T>)
+    {
+        // named enums need their names to be known up front
+        return !requires(T value) { enum_to_string(value); } || requires { enum_names(T{}); };
+    }
+    else
+    {
+        return std::integral<T> || std::floating_point<T>;
+    }
+}
+
+} // namespace internal
+
+namespace concepts {
+
+// types whose json form has an upper bound known at compile time: arithmetic types, enums, std::array and
+// std::optional of those, and reflected types made only of such members
+template <typename T>
+concept fixed_size = internal::has_fixed_size<std::remove_cvref_t<T>>();
+
+} // namespace concepts
+
+// the longest json convert_to_json can produce for any value of T
+template <concepts::fixed_size T>
+consteval std::size_t max_serialized_size()
+{
+    if constexpr (::krrs::reflect::concepts::reflectable<T>)
+    {
+        std::size_t size = 2;
+        ::krrs::reflect::for_each<T>([&size]<typename Descriptor>() {
+            size += ::krrs::reflect::key_table<T, internal::key_format>::template token<Descriptor>().size();
+            size += max_serialized_size<typename Descriptor::member_type>();
+        });
+        return size;
+    }
+    else if constexpr (::krrs::reflect::concepts::same_as_array_type<T>)
+    {
+        constexpr std::size_t count = std::tuple_size_v<T>;
+        return 2 + count * max_serialized_size<typename T::value_type>() + (count == 0 ? 0 : (count - 1) * 2);
+    }
+    else if constexpr (concepts::same_as_optional<T>)
+    {
+        return std::max(std::string_view{"null"}.size(), max_serialized_size<typename T::value_type>());
+    }
+    else if constexpr (std::is_enum_v<T>)
+    {
+        if constexpr (requires { enum_names(T{}); })
+        {
+            // enum_to_string falls back to "<unknown>" for values without a name
+            std::size_t longest = std::string_view{"<unknown>"}.size();
+            for (const std::string_view name : enum_names(T{}))
+            {
+                longest = std::max(longest, name.size());
+            }
+            return longest + 2;
+        }
+        else
+        {
+            return internal::max_number_size<std::underlying_type_t<T>>();
+        }
+    }
+    else
+    {
+        return internal::max_number_size<T>();
+    }
+}
+
+// cheap size hint for any serializable value, one walk over its containers without formatting anything.
+// exact bounds are used for the fixed-size parts, strings are counted as if nothing in them needs escaping
+template <typename T>
+std::size_t estimated_size(const T& value)
+{
+    if constexpr (concepts::fixed_size<T>)
+    {
+        return max_serialized_size<T>();
+    }
+    else if constexpr (::krrs::reflect::concepts::reflectable<T>)
+    {
+        std::size_t size = 2;
+        ::krrs::reflect::for_each<T>([&size, &value]<typename Descriptor>() {
+            if constexpr (!std::is_function_v<typename Descriptor::member_type>)
+            {
+                size += ::krrs::reflect::key_table<T, internal::key_format>::template token<Descriptor>().size();
+                size += estimated_size(::krrs::reflect::get_member_variable<Descriptor>(value));
+            }
+        });
+        return size;
+    }
+    else if constexpr (concepts::same_as_vector<T> || ::krrs::reflect::concepts::same_as_array_type<T>)
+    {
+        std::size_t size = 2 + (value.size() == 0 ? 0 : (value.size() - 1) * 2);
+        if constexpr (concepts::fixed_size<typename T::value_type>)
+        {
+            return size + value.size() * max_serialized_size<typename T::value_type>();
+        }
+        else
+        {
+            for (const auto& elem : value)
+            {
+                size += estimated_size(elem);
+            }
+            return size;
+        }
+    }
+    else if constexpr (concepts::same_as_unordered_map<T>)
+    {
+        std::size_t size = 2 + (value.size() == 0 ? 0 : (value.size() - 1) * 2);
+        for (const auto& [key, elem] : value)
+        {
+            size += estimated_size(key) + 2 + estimated_size(elem);
+        }
+        return size;
+    }
+    else if constexpr (concepts::same_as_optional<T>)
+    {
+        return value.has_value() ? estimated_size(*value) : std::string_view{"null"}.size();
+    }
+    else
+    {
+        static_assert(std::convertible_to<const T&, std::string_view>, "estimated_size: type is not json serializable!");
+        return std::string_view{value}.size() + 2;
+    }
+}
+
+} // namespace krrs::json
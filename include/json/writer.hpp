@@ -0,0 +1,162 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "../../include/io/sink.hpp"
+#include "../../include/reflect/numeric.hpp"
+#include "internal/escape.hpp"
+
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace krrs::json {
+
+// writes json tokens straight to an io::sink (a std::string for json::writer).
+// nothing is materialized in between, so nested objects / containers end up in the sink as they are encoded.
+// Sink is held by value, see io::sink
+template <typename Sink>
+    requires io::sink<std::remove_reference_t<Sink>>
+class basic_writer
+{
+public:
+    explicit basic_writer(Sink sink) noexcept(std::is_nothrow_move_constructible_v<Sink>)
+        : sink_{std::forward<Sink>(sink)}
+    {
+    }
+
+    void write(char c)
+    {
+        sink_.put(c);
+    }
+
+    void write(std::string_view str)
+    {
+        sink_.write(str.data(), str.size());
+    }
+
+    // shortest round-trip by default, or fixed notation with precision decimals
+    template <::krrs::reflect::numeric::number T>
+    void write_number(T value, int precision = ::krrs::reflect::numeric::shortest)
+    {
+        if constexpr (std::floating_point<T>)
+        {
+            // json has no representation for nan / inf
+            if (!std::isfinite(value))
+            {
+                write("null");
+                return;
+            }
+        }
+
+        std::array<char, ::krrs::reflect::numeric::max_shortest_chars> chars;
+        if (const char* end = ::krrs::reflect::numeric::format_to(chars.data(), chars.data() + chars.size(), value, precision))
+        {
+            sink_.write(chars.data(), static_cast<std::size_t>(end - chars.data()));
+            return;
+        }
+        // only fixed notation of a large value gets here
+        write(::krrs::reflect::numeric::to_string(value, precision));
+    }
+
+    // quotes and escapes str. clean runs between escape sites are found 16 / 32 bytes at a time and copied in bulk
+    void write_string(std::string_view str)
+    {
+        write_string<false>(str);
+    }
+
+    // same as write_string, but the sink may keep pointing into str instead of copying it (see io::write_borrowed),
+    // so str has to outlive the encode. used for the strings of the object being encoded
+    void write_borrowed_string(std::string_view str)
+    {
+        write_string<true>(str);
+    }
+
+    void reserve(std::size_t additional)
+    {
+        io::reserve(sink_, additional);
+    }
+
+    std::remove_reference_t<Sink>& sink() noexcept
+    {
+        return sink_;
+    }
+
+private:
+    template <bool Borrowed>
+    void write_string(std::string_view str)
+    {
+        sink_.put('"');
+        while (true)
+        {
+            const std::size_t clean = internal::find_escape(str.data(), str.size());
+            if constexpr (Borrowed)
+            {
+                io::write_borrowed(sink_, str.data(), clean);
+            }
+            else
+            {
+                sink_.write(str.data(), clean);
+            }
+            if (clean == str.size())
+            {
+                break;
+            }
+            write_escaped(str[clean]);
+            str.remove_prefix(clean + 1);
+        }
+        sink_.put('"');
+    }
+
+    void write_escaped(char c)
+    {
+        switch (c)
+        {
+        case '"':
+            write("\\\"");
+            break;
+        case '\\':
+            write("\\\\");
+            break;
+        case '\b':
+            write("\\b");
+            break;
+        case '\f':
+            write("\\f");
+            break;
+        case '\n':
+            write("\\n");
+            break;
+        case '\r':
+            write("\\r");
+            break;
+        case '\t':
+            write("\\t");
+            break;
+        default:
+        {
+            // remaining control characters have no short form
+            constexpr std::string_view hex_digits = "0123456789abcdef";
+            const auto byte = static_cast<unsigned char>(c);
+            const char escaped[] = {'\\', 'u', '0', '0', hex_digits[byte >> 4], hex_digits[byte & 0xF]};
+            sink_.write(escaped, sizeof(escaped));
+            break;
+        }
+        }
+    }
+
+    Sink sink_;
+};
+
+template <typename Sink>
+basic_writer(Sink&) -> basic_writer<Sink&>;
+
+// appends in place to a caller-owned std::string
+using writer = basic_writer<io::string_sink>;
+
+} // namespace krrs::json
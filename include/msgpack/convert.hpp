@@ -0,0 +1,331 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "../../include/reflect/key_table.hpp"
+#include "../../include/reflect/perfect_hash.hpp"
+#include "../../include/reflect/reflect.hpp"
+#include "concepts.hpp"
+#include "reader.hpp"
+#include "writer.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace krrs::msgpack {
+
+// how reflected structs are laid out on the wire
+enum class layout : std::uint8_t
+{
+    // a map from member name to value, members can be added, removed or reordered between versions
+    map,
+    // an array of the values in for_each order, no keys at all. only valid when both sides share the layout of
+    // the struct, e.g. checked up front through ::krrs::reflect::schema_hash
+    array,
+};
+
+template <layout Layout = layout::map, ::krrs::reflect::concepts::reflectable T, typename Sink>
+void convert_to_msgpack(const T& obj, basic_writer<Sink>& w);
+
+template <layout Layout = layout::map, ::krrs::reflect::concepts::reflectable T>
+void convert_from_msgpack(T& obj, reader& r);
+
+namespace internal {
+
+// key format for ::krrs::reflect::key_table, renders each member name as a complete msgpack str
+struct key_format
+{
+    static constexpr std::size_t token_size(std::string_view name, std::size_t)
+    {
+        return str_header_size(name.size()) + name.size();
+    }
+
+    static constexpr char* write_token(char* out, std::string_view name, std::size_t)
+    {
+        out = write_str_header(out, name.size());
+        for (const char c : name)
+        {
+            *out++ = c;
+        }
+        return out;
+    }
+};
+
+// members that are encoded, i.e. everything but member functions
+template <::krrs::reflect::concepts::reflectable T>
+consteval std::size_t field_count()
+{
+    std::size_t count = 0;
+    ::krrs::reflect::for_each<T>([&count]<typename Descriptor>() {
+        if constexpr (!std::is_function_v<typename Descriptor::member_type>)
+        {
+            ++count;
+        }
+    });
+    return count;
+}
+
+template <layout Layout, typename Sink, typename T>
+void write_value(basic_writer<Sink>& w, const T& value)
+{
+    if constexpr (::krrs::reflect::concepts::reflectable<T>)
+    {
+        convert_to_msgpack<Layout>(value, w);
+    }
+    else if constexpr (concepts::same_as_vector<T> || ::krrs::reflect::concepts::same_as_array_type<T>)
+    {
+        w.write_array_header(value.size());
+        for (const auto& elem : value)
+        {
+            write_value<Layout>(w, elem);
+        }
+    }
+    else if constexpr (concepts::same_as_unordered_map<T>)
+    {
+        w.write_map_header(value.size());
+        for (const auto& [key, elem] : value)
+        {
+            write_value<Layout>(w, key);
+            write_value<Layout>(w, elem);
+        }
+    }
+    else if constexpr (concepts::same_as_optional<T>)
+    {
+        if (value.has_value())
+        {
+            write_value<Layout>(w, *value);
+        }
+        else
+        {
+            w.write_nil();
+        }
+    }
+    else if constexpr (std::is_enum_v<T>)
+    {
+        w.write_integer(std::to_underlying(value));
+    }
+    else if constexpr (std::same_as<T, bool>)
+    {
+        w.write_bool(value);
+    }
+    else if constexpr (std::same_as<T, char>)
+    {
+        // a one character string, the same as json
+        w.write_string(std::string_view{&value, 1});
+    }
+    else if constexpr (std::integral<T>)
+    {
+        w.write_integer(value);
+    }
+    else if constexpr (std::floating_point<T>)
+    {
+        w.write_float(value);
+    }
+    else
+    {
+        static_assert(std::convertible_to<const T&, std::string_view>, "msgpack::serialize: type is not msgpack serializable!");
+        // borrowed, see io::write_borrowed
+        w.write_borrowed_string(std::string_view{value});
+    }
+}
+
+template <layout Layout, typename T>
+void read_value(reader& r, T& value)
+{
+    if constexpr (::krrs::reflect::concepts::reflectable<T>)
+    {
+        convert_from_msgpack<Layout>(value, r);
+    }
+    else if constexpr (concepts::same_as_vector<T>)
+    {
+        value.clear();
+        const std::size_t size = r.read_array_header();
+        for (std::size_t i = 0; i != size; ++i)
+        {
+            if constexpr (std::same_as<typename T::value_type, bool>)
+            {
+                // std::vector<bool> hands out proxies, not bool&
+                bool elem = false;
+                read_value<Layout>(r, elem);
+                value.push_back(elem);
+            }
+            else
+            {
+                read_value<Layout>(r, value.emplace_back());
+            }
+        }
+    }
+    else if constexpr (::krrs::reflect::concepts::same_as_array_type<T>)
+    {
+        if (const std::size_t size = r.read_array_header(); size != value.size())
+        {
+            throw std::runtime_error{"expected an array of " + std::to_string(value.size()) + " elements, got " + std::to_string(size)};
+        }
+        for (auto& elem : value)
+        {
+            read_value<Layout>(r, elem);
+        }
+    }
+    else if constexpr (concepts::same_as_unordered_map<T>)
+    {
+        value.clear();
+        const std::size_t size = r.read_map_header();
+        for (std::size_t i = 0; i != size; ++i)
+        {
+            typename T::key_type key{};
+            read_value<Layout>(r, key);
+            typename T::mapped_type elem{};
+            read_value<Layout>(r, elem);
+            value.insert_or_assign(std::move(key), std::move(elem));
+        }
+    }
+    else if constexpr (concepts::same_as_optional<T>)
+    {
+        if (r.consume_nil())
+        {
+            value.reset();
+        }
+        else
+        {
+            read_value<Layout>(r, value.emplace());
+        }
+    }
+    else if constexpr (std::is_enum_v<T>)
+    {
+        value = static_cast<T>(r.read_integer<std::underlying_type_t<T>>());
+    }
+    else if constexpr (std::same_as<T, bool>)
+    {
+        value = r.read_bool();
+    }
+    else if constexpr (std::same_as<T, char>)
+    {
+        const std::string_view str = r.read_string();
+        if (str.size() != 1)
+        {
+            throw std::runtime_error{"expected a single character, got: " + std::string{str}};
+        }
+        value = str.front();
+    }
+    else if constexpr (std::integral<T>)
+    {
+        value = r.read_integer<T>();
+    }
+    else if constexpr (std::floating_point<T>)
+    {
+        value = r.read_float<T>();
+    }
+    else
+    {
+        static_assert(std::same_as<T, std::string>, "msgpack::deserialize: type is not msgpack deserializable, non-owning strings would dangle!");
+        value.assign(r.read_string());
+    }
+}
+
+template <typename T>
+struct member_reader
+{
+    template <typename Descriptor>
+    static void invoke(T& obj, reader& r)
+    {
+        if constexpr (std::is_function_v<typename Descriptor::member_type>)
+        {
+            r.skip_value();
+        }
+        else
+        {
+            read_value<layout::map>(r, ::krrs::reflect::get_member_variable<Descriptor>(obj));
+        }
+    }
+};
+
+} // namespace internal
+
+template <layout Layout, ::krrs::reflect::concepts::reflectable T, typename Sink>
+void convert_to_msgpack(const T& obj, basic_writer<Sink>& w)
+{
+    static constexpr std::size_t field_count = internal::field_count<T>();
+
+    if constexpr (Layout == layout::map)
+    {
+        w.write_map_header(field_count);
+    }
+    else
+    {
+        w.write_array_header(field_count);
+    }
+
+    ::krrs::reflect::for_each<T>([&w, &obj]<typename Descriptor>() {
+        if constexpr (!std::is_function_v<typename Descriptor::member_type>)
+        {
+            if constexpr (Layout == layout::map)
+            {
+                // pre-rendered str holding the member name
+                w.write_raw(::krrs::reflect::key_table<T, internal::key_format>::template token<Descriptor>());
+            }
+            internal::write_value<Layout>(w, ::krrs::reflect::get_member_variable<Descriptor>(obj));
+        }
+    });
+}
+
+// layout::map matches members by name, unknown keys are skipped. layout::array assigns elements in for_each order,
+// a shorter array leaves the remaining members untouched and extra elements are skipped. either way members that
+// are not in the input keep their value
+template <layout Layout, ::krrs::reflect::concepts::reflectable T>
+void convert_from_msgpack(T& obj, reader& r)
+{
+    if constexpr (Layout == layout::map)
+    {
+        static constexpr auto& lookup = ::krrs::reflect::member_lookup<T>;
+        static constexpr auto readers = ::krrs::reflect::make_jump_table<T, void(T&, reader&), internal::member_reader<T>>();
+
+        const std::size_t size = r.read_map_header();
+        for (std::size_t i = 0; i != size; ++i)
+        {
+            if (const std::size_t index = lookup.find(r.read_string()); index != lookup.npos)
+            {
+                readers[index](obj, r);
+            }
+            else
+            {
+                r.skip_value();
+            }
+        }
+    }
+    else
+    {
+        const std::size_t size = r.read_array_header();
+        std::size_t index = 0;
+        ::krrs::reflect::for_each<T>([&r, &obj, &index, size]<typename Descriptor>() {
+            if constexpr (!std::is_function_v<typename Descriptor::member_type>)
+            {
+                if (index != size)
+                {
+                    internal::read_value<Layout>(r, ::krrs::reflect::get_member_variable<Descriptor>(obj));
+                    ++index;
+                }
+            }
+        });
+        for (; index < size; ++index)
+        {
+            r.skip_value();
+        }
+    }
+}
+
+template <layout Layout = layout::map, ::krrs::reflect::concepts::reflectable T, io::sink Sink>
+void convert_to_msgpack(const T& obj, Sink& out)
+{
+    basic_writer w{out};
+    convert_to_msgpack<Layout>(obj, w);
+    io::release_borrowed(out);
+}
+
+} // namespace krrs::msgpack
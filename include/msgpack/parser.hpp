@@ -0,0 +1,52 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "convert.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace krrs::msgpack {
+
+// bytes has to hold exactly one T, written with the same Layout
+template <::krrs::reflect::concepts::reflectable T, layout Layout = layout::map>
+T deserialize(std::string_view bytes)
+{
+    reader r{bytes};
+    T obj{};
+    convert_from_msgpack<Layout>(obj, r);
+    if (!r.at_end())
+    {
+        throw std::runtime_error{"unexpected trailing bytes at offset " + std::to_string(r.position())};
+    }
+    return obj;
+}
+
+// writes obj straight to out, e.g. an io::fd_sink. strings of obj may be handed to the sink without being copied,
+// they are released before this returns
+template <layout Layout = layout::map, ::krrs::reflect::concepts::reflectable T, io::sink Sink>
+void serialize(const T& obj, Sink& out)
+{
+    convert_to_msgpack<Layout>(obj, out);
+}
+
+// appends the serialized object to the end of out
+template <layout Layout = layout::map, ::krrs::reflect::concepts::reflectable T>
+void serialize(const T& obj, std::string& out)
+{
+    io::string_sink sink{out};
+    serialize<Layout>(obj, sink);
+}
+
+template <layout Layout = layout::map, ::krrs::reflect::concepts::reflectable T>
+std::string serialize(const T& obj)
+{
+    std::string out;
+    serialize<Layout>(obj, out);
+    return out;
+}
+
+} // namespace krrs::msgpack
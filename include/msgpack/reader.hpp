@@ -0,0 +1,333 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "writer.hpp"
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace krrs::msgpack {
+
+// forward-only cursor over msgpack bytes. the input is never copied, every read is bounds checked and
+// malformed input throws std::runtime_error
+class reader
+{
+public:
+    explicit reader(std::string_view input) noexcept
+        : input_{input}
+    {
+    }
+
+    // consumes a nil if it is next in the input
+    bool consume_nil()
+    {
+        if (peek() == format::nil)
+        {
+            ++pos_;
+            return true;
+        }
+        return false;
+    }
+
+    bool read_bool()
+    {
+        const std::uint8_t byte = next();
+        if (byte != format::true_ && byte != format::false_)
+        {
+            mismatch("a bool", byte);
+        }
+        return byte == format::true_;
+    }
+
+    // any integer format, as long as the value fits in T
+    template <std::integral T>
+        requires(!std::same_as<T, bool>)
+    T read_integer()
+    {
+        const std::uint8_t byte = next();
+        if (byte < 0x80)
+        {
+            return narrow<T>(byte);
+        }
+        if (byte >= format::negative_fixint)
+        {
+            return narrow<T>(static_cast<std::int8_t>(byte));
+        }
+
+        switch (byte)
+        {
+        case format::uint8:
+            return narrow<T>(read_big_endian(1));
+        case format::uint16:
+            return narrow<T>(read_big_endian(2));
+        case format::uint32:
+            return narrow<T>(read_big_endian(4));
+        case format::uint64:
+            return narrow<T>(read_big_endian(8));
+        case format::int8:
+            return narrow<T>(static_cast<std::int8_t>(read_big_endian(1)));
+        case format::int16:
+            return narrow<T>(static_cast<std::int16_t>(read_big_endian(2)));
+        case format::int32:
+            return narrow<T>(static_cast<std::int32_t>(read_big_endian(4)));
+        case format::int64:
+            return narrow<T>(static_cast<std::int64_t>(read_big_endian(8)));
+        default:
+            mismatch("an integer", byte);
+        }
+    }
+
+    // float32 / float64, integers are accepted as well
+    template <std::floating_point T>
+    T read_float()
+    {
+        const std::uint8_t byte = peek();
+        if (byte == format::float32)
+        {
+            ++pos_;
+            return static_cast<T>(std::bit_cast<float>(static_cast<std::uint32_t>(read_big_endian(4))));
+        }
+        if (byte == format::float64)
+        {
+            ++pos_;
+            return static_cast<T>(std::bit_cast<double>(read_big_endian(8)));
+        }
+        if (byte <= 0x7f || (byte >= format::uint8 && byte <= format::uint64))
+        {
+            return static_cast<T>(read_integer<std::uint64_t>());
+        }
+        return static_cast<T>(read_integer<std::int64_t>());
+    }
+
+    // the contents of the next str, pointing into the input
+    std::string_view read_string()
+    {
+        const std::uint8_t byte = next();
+        std::size_t size = 0;
+        if ((byte & 0xe0) == format::fixstr)
+        {
+            size = byte & 0x1f;
+        }
+        else if (byte == format::str8)
+        {
+            size = read_length(1);
+        }
+        else if (byte == format::str16)
+        {
+            size = read_length(2);
+        }
+        else if (byte == format::str32)
+        {
+            size = read_length(4);
+        }
+        else
+        {
+            mismatch("a string", byte);
+        }
+        return read_bytes(size);
+    }
+
+    std::size_t read_array_header()
+    {
+        return read_container_header(format::fixarray, format::array16, format::array32, "an array");
+    }
+
+    std::size_t read_map_header()
+    {
+        return read_container_header(format::fixmap, format::map16, format::map32, "a map");
+    }
+
+    // steps over the next value, containers included
+    void skip_value()
+    {
+        // values still to skip, containers add their elements instead of recursing
+        std::size_t pending = 1;
+        while (pending != 0)
+        {
+            --pending;
+            const std::uint8_t byte = next();
+            if (byte < 0x80 || byte >= format::negative_fixint || byte == format::nil || byte == format::false_ || byte == format::true_)
+            {
+                continue;
+            }
+            if ((byte & 0xf0) == format::fixmap)
+            {
+                pending += 2 * static_cast<std::size_t>(byte & 0x0f);
+                continue;
+            }
+            if ((byte & 0xf0) == format::fixarray)
+            {
+                pending += byte & 0x0f;
+                continue;
+            }
+            if ((byte & 0xe0) == format::fixstr)
+            {
+                read_bytes(byte & 0x1f);
+                continue;
+            }
+
+            switch (byte)
+            {
+            case format::bin8:
+            case format::str8:
+                read_bytes(read_length(1));
+                break;
+            case format::bin16:
+            case format::str16:
+                read_bytes(read_length(2));
+                break;
+            case format::bin32:
+            case format::str32:
+                read_bytes(read_length(4));
+                break;
+            case format::ext8:
+                read_bytes(read_length(1) + 1);
+                break;
+            case format::ext16:
+                read_bytes(read_length(2) + 1);
+                break;
+            case format::ext32:
+                read_bytes(read_length(4) + 1);
+                break;
+            case format::uint8:
+            case format::int8:
+                read_bytes(1);
+                break;
+            case format::uint16:
+            case format::int16:
+                read_bytes(2);
+                break;
+            case format::float32:
+            case format::uint32:
+            case format::int32:
+                read_bytes(4);
+                break;
+            case format::float64:
+            case format::uint64:
+            case format::int64:
+                read_bytes(8);
+                break;
+            case format::array16:
+                pending += read_length(2);
+                break;
+            case format::array32:
+                pending += read_length(4);
+                break;
+            case format::map16:
+                pending += 2 * read_length(2);
+                break;
+            case format::map32:
+                pending += 2 * read_length(4);
+                break;
+            default:
+                if (byte >= format::fixext1 && byte <= format::fixext16)
+                {
+                    // type byte plus 1, 2, 4, 8 or 16 bytes of data
+                    read_bytes(1 + (std::size_t{1} << (byte - format::fixext1)));
+                    break;
+                }
+                throw std::runtime_error{"invalid msgpack format byte " + std::to_string(byte) + " at offset " + std::to_string(pos_ - 1)};
+            }
+        }
+    }
+
+    bool at_end() const noexcept
+    {
+        return pos_ == input_.size();
+    }
+
+    std::size_t position() const noexcept
+    {
+        return pos_;
+    }
+
+private:
+    std::uint8_t peek() const
+    {
+        if (pos_ == input_.size())
+        {
+            throw std::runtime_error{"unexpected end of input"};
+        }
+        return static_cast<std::uint8_t>(input_[pos_]);
+    }
+
+    std::uint8_t next()
+    {
+        const std::uint8_t byte = peek();
+        ++pos_;
+        return byte;
+    }
+
+    std::string_view read_bytes(std::size_t size)
+    {
+        if (size > input_.size() - pos_)
+        {
+            throw std::runtime_error{"unexpected end of input at offset " + std::to_string(pos_) + ", " + std::to_string(size) + " more bytes expected"};
+        }
+        const std::string_view bytes = input_.substr(pos_, size);
+        pos_ += size;
+        return bytes;
+    }
+
+    std::uint64_t read_big_endian(std::size_t size)
+    {
+        std::uint64_t value = 0;
+        for (const char c : read_bytes(size))
+        {
+            value = (value << 8) | static_cast<unsigned char>(c);
+        }
+        return value;
+    }
+
+    // a length stored big-endian in the next `bytes` bytes
+    std::size_t read_length(std::size_t bytes)
+    {
+        return read_big_endian(bytes);
+    }
+
+    std::size_t read_container_header(std::uint8_t fix, std::uint8_t format16, std::uint8_t format32, std::string_view expected)
+    {
+        const std::uint8_t byte = next();
+        if ((byte & 0xf0) == fix)
+        {
+            return byte & 0x0f;
+        }
+        if (byte == format16)
+        {
+            return read_length(2);
+        }
+        if (byte == format32)
+        {
+            return read_length(4);
+        }
+        mismatch(expected, byte);
+    }
+
+    template <typename T, typename V>
+    T narrow(V value) const
+    {
+        if (!std::in_range<T>(value))
+        {
+            throw std::runtime_error{"integer " + std::to_string(value) + " at offset " + std::to_string(pos_) + " does not fit the member's type"};
+        }
+        return static_cast<T>(value);
+    }
+
+    [[noreturn]] void mismatch(std::string_view expected, std::uint8_t byte) const
+    {
+        throw std::runtime_error{"expected " + std::string{expected} + ", got format byte " + std::to_string(byte) + " at offset " + std::to_string(pos_ - 1)};
+    }
+
+    std::string_view input_;
+    std::size_t pos_ = 0;
+};
+
+} // namespace krrs::msgpack
@@ -0,0 +1,295 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "../../include/io/sink.hpp"
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace krrs::msgpack {
+
+// format bytes from the msgpack spec
+namespace format {
+
+inline constexpr std::uint8_t nil = 0xc0;
+inline constexpr std::uint8_t false_ = 0xc2;
+inline constexpr std::uint8_t true_ = 0xc3;
+inline constexpr std::uint8_t bin8 = 0xc4;
+inline constexpr std::uint8_t bin16 = 0xc5;
+inline constexpr std::uint8_t bin32 = 0xc6;
+inline constexpr std::uint8_t ext8 = 0xc7;
+inline constexpr std::uint8_t ext16 = 0xc8;
+inline constexpr std::uint8_t ext32 = 0xc9;
+inline constexpr std::uint8_t float32 = 0xca;
+inline constexpr std::uint8_t float64 = 0xcb;
+inline constexpr std::uint8_t uint8 = 0xcc;
+inline constexpr std::uint8_t uint16 = 0xcd;
+inline constexpr std::uint8_t uint32 = 0xce;
+inline constexpr std::uint8_t uint64 = 0xcf;
+inline constexpr std::uint8_t int8 = 0xd0;
+inline constexpr std::uint8_t int16 = 0xd1;
+inline constexpr std::uint8_t int32 = 0xd2;
+inline constexpr std::uint8_t int64 = 0xd3;
+inline constexpr std::uint8_t fixext1 = 0xd4;
+inline constexpr std::uint8_t fixext16 = 0xd8;
+inline constexpr std::uint8_t str8 = 0xd9;
+inline constexpr std::uint8_t str16 = 0xda;
+inline constexpr std::uint8_t str32 = 0xdb;
+inline constexpr std::uint8_t array16 = 0xdc;
+inline constexpr std::uint8_t array32 = 0xdd;
+inline constexpr std::uint8_t map16 = 0xde;
+inline constexpr std::uint8_t map32 = 0xdf;
+
+inline constexpr std::uint8_t fixmap = 0x80;
+inline constexpr std::uint8_t fixarray = 0x90;
+inline constexpr std::uint8_t fixstr = 0xa0;
+inline constexpr std::uint8_t negative_fixint = 0xe0;
+
+} // namespace format
+
+namespace internal {
+
+// size of the header in front of a string of size bytes
+constexpr std::size_t str_header_size(std::size_t size) noexcept
+{
+    return size < 32 ? 1 : size <= std::numeric_limits<std::uint8_t>::max() ? 2 : size <= std::numeric_limits<std::uint16_t>::max() ? 3 : 5;
+}
+
+// writes the header in front of a string of size bytes, returns one past its end
+constexpr char* write_str_header(char* out, std::size_t size) noexcept
+{
+    const auto put_big_endian = [&out](std::uint64_t value, int bytes) {
+        for (int i = bytes - 1; i >= 0; --i)
+        {
+            *out++ = static_cast<char>((value >> (i * 8)) & 0xFF);
+        }
+    };
+
+    if (size < 32)
+    {
+        *out++ = static_cast<char>(format::fixstr | size);
+    }
+    else if (size <= std::numeric_limits<std::uint8_t>::max())
+    {
+        *out++ = static_cast<char>(format::str8);
+        put_big_endian(size, 1);
+    }
+    else if (size <= std::numeric_limits<std::uint16_t>::max())
+    {
+        *out++ = static_cast<char>(format::str16);
+        put_big_endian(size, 2);
+    }
+    else
+    {
+        *out++ = static_cast<char>(format::str32);
+        put_big_endian(size, 4);
+    }
+    return out;
+}
+
+} // namespace internal
+
+// writes msgpack values to an io::sink, always in the smallest format that holds the value.
+// Sink is held by value, see io::sink
+template <typename Sink>
+    requires io::sink<std::remove_reference_t<Sink>>
+class basic_writer
+{
+public:
+    explicit basic_writer(Sink sink) noexcept(std::is_nothrow_move_constructible_v<Sink>)
+        : sink_{std::forward<Sink>(sink)}
+    {
+    }
+
+    void write_nil()
+    {
+        put(format::nil);
+    }
+
+    void write_bool(bool value)
+    {
+        put(value ? format::true_ : format::false_);
+    }
+
+    template <std::integral T>
+        requires(!std::same_as<T, bool>)
+    void write_integer(T value)
+    {
+        if constexpr (std::is_signed_v<T>)
+        {
+            if (value < 0)
+            {
+                write_negative(static_cast<std::int64_t>(value));
+                return;
+            }
+        }
+        write_unsigned(static_cast<std::uint64_t>(value));
+    }
+
+    template <std::floating_point T>
+    void write_float(T value)
+    {
+        if constexpr (sizeof(T) <= sizeof(float))
+        {
+            put(format::float32);
+            put_big_endian(std::bit_cast<std::uint32_t>(static_cast<float>(value)), 4);
+        }
+        else
+        {
+            put(format::float64);
+            put_big_endian(std::bit_cast<std::uint64_t>(static_cast<double>(value)), 8);
+        }
+    }
+
+    void write_string(std::string_view str)
+    {
+        write_str_header(str.size());
+        sink_.write(str.data(), str.size());
+    }
+
+    // same as write_string, but the sink may keep pointing into str instead of copying it (see io::write_borrowed),
+    // so str has to outlive the encode. used for the strings of the object being encoded
+    void write_borrowed_string(std::string_view str)
+    {
+        write_str_header(str.size());
+        io::write_borrowed(sink_, str.data(), str.size());
+    }
+
+    void write_array_header(std::size_t size)
+    {
+        write_container_header(size, format::fixarray, format::array16, format::array32);
+    }
+
+    void write_map_header(std::size_t size)
+    {
+        write_container_header(size, format::fixmap, format::map16, format::map32);
+    }
+
+    // already encoded msgpack, e.g. a pre-rendered key
+    void write_raw(std::string_view bytes)
+    {
+        sink_.write(bytes.data(), bytes.size());
+    }
+
+    std::remove_reference_t<Sink>& sink() noexcept
+    {
+        return sink_;
+    }
+
+private:
+    void put(std::uint8_t byte)
+    {
+        sink_.put(static_cast<char>(byte));
+    }
+
+    void put_big_endian(std::uint64_t value, int bytes)
+    {
+        char out[8];
+        for (int i = 0; i != bytes; ++i)
+        {
+            out[i] = static_cast<char>((value >> ((bytes - 1 - i) * 8)) & 0xFF);
+        }
+        sink_.write(out, static_cast<std::size_t>(bytes));
+    }
+
+    void write_unsigned(std::uint64_t value)
+    {
+        if (value < 0x80)
+        {
+            put(static_cast<std::uint8_t>(value));
+        }
+        else if (value <= std::numeric_limits<std::uint8_t>::max())
+        {
+            put(format::uint8);
+            put_big_endian(value, 1);
+        }
+        else if (value <= std::numeric_limits<std::uint16_t>::max())
+        {
+            put(format::uint16);
+            put_big_endian(value, 2);
+        }
+        else if (value <= std::numeric_limits<std::uint32_t>::max())
+        {
+            put(format::uint32);
+            put_big_endian(value, 4);
+        }
+        else
+        {
+            put(format::uint64);
+            put_big_endian(value, 8);
+        }
+    }
+
+    void write_negative(std::int64_t value)
+    {
+        const auto bits = static_cast<std::uint64_t>(value);
+        if (value >= -32)
+        {
+            put(static_cast<std::uint8_t>(bits));
+        }
+        else if (value >= std::numeric_limits<std::int8_t>::min())
+        {
+            put(format::int8);
+            put_big_endian(bits, 1);
+        }
+        else if (value >= std::numeric_limits<std::int16_t>::min())
+        {
+            put(format::int16);
+            put_big_endian(bits, 2);
+        }
+        else if (value >= std::numeric_limits<std::int32_t>::min())
+        {
+            put(format::int32);
+            put_big_endian(bits, 4);
+        }
+        else
+        {
+            put(format::int64);
+            put_big_endian(bits, 8);
+        }
+    }
+
+    void write_str_header(std::size_t size)
+    {
+        char header[5];
+        const char* end = internal::write_str_header(header, size);
+        sink_.write(header, static_cast<std::size_t>(end - header));
+    }
+
+    void write_container_header(std::size_t size, std::uint8_t fix, std::uint8_t format16, std::uint8_t format32)
+    {
+        if (size < 16)
+        {
+            put(static_cast<std::uint8_t>(fix | size));
+        }
+        else if (size <= std::numeric_limits<std::uint16_t>::max())
+        {
+            put(format16);
+            put_big_endian(size, 2);
+        }
+        else
+        {
+            put(format32);
+            put_big_endian(size, 4);
+        }
+    }
+
+    Sink sink_;
+};
+
+template <typename Sink>
+basic_writer(Sink&) -> basic_writer<Sink&>;
+
+// appends in place to a caller-owned std::string
+using writer = basic_writer<io::string_sink>;
+
+} // namespace krrs::msgpack
@@ -0,0 +1,400 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "../../include/binary/decoder.hpp"
+#include "../../include/reflect/perfect_hash.hpp"
+#include "field.hpp"
+#include "size.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace krrs::protowire {
+
+template <::krrs::reflect::concepts::reflectable T, typename Sink>
+void encode(const T& obj, binary::basic_encoder<Sink>& e);
+
+template <::krrs::reflect::concepts::reflectable T>
+void decode(T& obj, binary::decoder& d);
+
+namespace internal {
+
+template <typename Sink, typename T>
+void write_payload(binary::basic_encoder<Sink>& e, const T& value)
+{
+    if constexpr (varint_value<T>)
+    {
+        e.write_varint(to_varint(value));
+    }
+    else if constexpr (fixed_value<T>)
+    {
+        e.write_scalar(value);
+    }
+    else if constexpr (::krrs::reflect::concepts::reflectable<T>)
+    {
+        // the length prefix comes first, so the embedded message is sized before it is written
+        e.write_varint(encoded_size(value));
+        encode(value, e);
+    }
+    else
+    {
+        // borrowed, see io::write_borrowed
+        const std::string_view str{value};
+        e.write_varint(str.size());
+        e.write_borrowed_bytes(str.data(), str.size());
+    }
+}
+
+template <std::uint32_t Field, wire_type Wire, typename Sink>
+void write_tag(binary::basic_encoder<Sink>& e)
+{
+    static constexpr std::string_view bytes = tag_of<Field, Wire>.view();
+    e.write_bytes(bytes.data(), bytes.size());
+}
+
+// writes value as field Field, even if it is the default
+template <std::uint32_t Field, typename Sink, typename T>
+void write_present_field(binary::basic_encoder<Sink>& e, const T& value)
+{
+    if constexpr (binary::concepts::same_as_optional<T>)
+    {
+        static_assert(!binary::concepts::same_as_optional<typename T::value_type> && !binary::concepts::same_as_vector<typename T::value_type>,
+                      "protowire: optional repeated fields have no protobuf wire form!");
+        if (value.has_value())
+        {
+            write_present_field<Field>(e, *value);
+        }
+    }
+    else if constexpr (packed_vector<T>)
+    {
+        using value_type = typename T::value_type;
+        write_tag<Field, wire_type::length_delimited>(e);
+        e.write_varint(packed_size(value));
+        if constexpr (fixed_value<value_type> && binary::concepts::bulk_copyable<value_type>)
+        {
+            // the packed form of floats and doubles is their in-memory form on little-endian hosts
+            e.write_borrowed_bytes(reinterpret_cast<const char*>(value.data()), value.size() * sizeof(value_type));
+        }
+        else
+        {
+            for (const value_type elem : value)
+            {
+                write_payload(e, elem);
+            }
+        }
+    }
+    else if constexpr (binary::concepts::same_as_vector<T>)
+    {
+        using value_type = typename T::value_type;
+        static_assert(!binary::concepts::same_as_optional<value_type> && !binary::concepts::same_as_vector<value_type>
+                          && !binary::concepts::same_as_unordered_map<value_type>,
+                      "protowire: repeated fields hold scalars, strings or messages only!");
+        for (const auto& elem : value)
+        {
+            write_tag<Field, wire_type_of<value_type>()>(e);
+            write_payload(e, elem);
+        }
+    }
+    else if constexpr (binary::concepts::same_as_unordered_map<T>)
+    {
+        static_assert(varint_value<typename T::key_type> || string_value<typename T::key_type>, "protowire: map keys are integers or strings only!");
+        for (const auto& [key, elem] : value)
+        {
+            write_tag<Field, wire_type::length_delimited>(e);
+            e.write_varint(map_entry_size(key, elem));
+            write_present_field<1>(e, key);
+            write_present_field<2>(e, elem);
+        }
+    }
+    else
+    {
+        write_tag<Field, wire_type_of<T>()>(e);
+        write_payload(e, value);
+    }
+}
+
+template <typename T>
+T narrow_varint(std::uint64_t raw)
+{
+    if constexpr (std::is_enum_v<T>)
+    {
+        return static_cast<T>(narrow_varint<std::underlying_type_t<T>>(raw));
+    }
+    else if constexpr (std::same_as<T, bool>)
+    {
+        return raw != 0;
+    }
+    else if constexpr (std::same_as<T, char>)
+    {
+        return static_cast<char>(narrow_varint<std::conditional_t<std::is_signed_v<char>, signed char, unsigned char>>(raw));
+    }
+    else
+    {
+        // negative values are sign extended to 64 bits on the wire
+        if constexpr (std::is_signed_v<T>)
+        {
+            const auto value = static_cast<std::int64_t>(raw);
+            if (std::in_range<T>(value))
+            {
+                return static_cast<T>(value);
+            }
+        }
+        else if (std::in_range<T>(raw))
+        {
+            return static_cast<T>(raw);
+        }
+        throw std::runtime_error{"varint " + std::to_string(raw) + " does not fit the member's type"};
+    }
+}
+
+inline void expect_wire_type(wire_type actual, wire_type expected)
+{
+    if (actual != expected)
+    {
+        throw std::runtime_error{"wire type " + std::to_string(std::to_underlying(actual)) + " does not match the member's, expected "
+                                 + std::to_string(std::to_underlying(expected))};
+    }
+}
+
+template <typename T>
+void read_payload(binary::decoder& d, T& value)
+{
+    if constexpr (varint_value<T>)
+    {
+        value = narrow_varint<T>(d.read_varint());
+    }
+    else if constexpr (fixed_value<T>)
+    {
+        value = d.read_scalar<T>();
+    }
+    else if constexpr (::krrs::reflect::concepts::reflectable<T>)
+    {
+        binary::decoder message{d.read_bytes(d.read_length())};
+        decode(value, message);
+    }
+    else
+    {
+        static_assert(std::same_as<T, std::string>, "protowire::decode: type is not decodable, non-owning strings would dangle!");
+        value.assign(d.read_bytes(d.read_length()));
+    }
+}
+
+inline void skip_field(binary::decoder& d, wire_type wire)
+{
+    switch (wire)
+    {
+    case wire_type::varint:
+        d.read_varint();
+        return;
+    case wire_type::fixed64:
+        d.read_bytes(8);
+        return;
+    case wire_type::length_delimited:
+        d.read_bytes(d.read_length());
+        return;
+    case wire_type::fixed32:
+        d.read_bytes(4);
+        return;
+    }
+    throw std::runtime_error{"unsupported wire type " + std::to_string(std::to_underlying(wire)) + " at offset " + std::to_string(d.position())};
+}
+
+// the key of the next field, validated
+inline std::pair<std::uint64_t, wire_type> read_key(binary::decoder& d)
+{
+    const std::size_t start = d.position();
+    const std::uint64_t key = d.read_varint();
+    const std::uint64_t field = key >> 3;
+    const auto wire = static_cast<wire_type>(key & 0x07);
+    if (field == 0 || field > max_field_number)
+    {
+        throw std::runtime_error{"invalid field number " + std::to_string(field) + " at offset " + std::to_string(start)};
+    }
+    return {field, wire};
+}
+
+// reads one occurrence of a field into value. repeated fields append, packed or not, and a message field that occurs
+// again is merged into the value it already holds, like protobuf does
+template <typename T>
+void read_field(binary::decoder& d, wire_type wire, T& value)
+{
+    if constexpr (binary::concepts::same_as_optional<T>)
+    {
+        read_field(d, wire, value.has_value() ? *value : value.emplace());
+    }
+    else if constexpr (binary::concepts::same_as_vector<T>)
+    {
+        using value_type = typename T::value_type;
+        if constexpr (packable<value_type>)
+        {
+            // parsers have to take packed and unpacked repeated fields alike
+            if (wire == wire_type::length_delimited)
+            {
+                binary::decoder packed{d.read_bytes(d.read_length())};
+                if constexpr (fixed_value<value_type> && binary::concepts::bulk_copyable<value_type>)
+                {
+                    const std::size_t count = packed.remaining() / sizeof(value_type);
+                    if (packed.remaining() % sizeof(value_type) != 0)
+                    {
+                        throw std::runtime_error{"packed field of " + std::to_string(packed.remaining()) + " bytes does not hold whole elements"};
+                    }
+                    const std::size_t first = value.size();
+                    value.resize(first + count);
+                    std::memcpy(value.data() + first, packed.read_bytes(count * sizeof(value_type)).data(), count * sizeof(value_type));
+                    return;
+                }
+                while (!packed.at_end())
+                {
+                    value_type elem{};
+                    read_payload(packed, elem);
+                    value.push_back(elem);
+                }
+                return;
+            }
+        }
+        expect_wire_type(wire, wire_type_of<value_type>());
+        value_type elem{};
+        read_payload(d, elem);
+        value.push_back(std::move(elem));
+    }
+    else if constexpr (binary::concepts::same_as_unordered_map<T>)
+    {
+        expect_wire_type(wire, wire_type::length_delimited);
+        binary::decoder entry{d.read_bytes(d.read_length())};
+        typename T::key_type key{};
+        typename T::mapped_type elem{};
+        while (!entry.at_end())
+        {
+            const auto [field, entry_wire] = read_key(entry);
+            if (field == 1)
+            {
+                read_field(entry, entry_wire, key);
+            }
+            else if (field == 2)
+            {
+                read_field(entry, entry_wire, elem);
+            }
+            else
+            {
+                skip_field(entry, entry_wire);
+            }
+        }
+        value.insert_or_assign(std::move(key), std::move(elem));
+    }
+    else
+    {
+        expect_wire_type(wire, wire_type_of<T>());
+        read_payload(d, value);
+    }
+}
+
+template <typename T>
+struct member_reader
+{
+    template <typename Descriptor>
+    static void invoke(T& obj, binary::decoder& d, wire_type wire)
+    {
+        if constexpr (std::is_function_v<typename Descriptor::member_type>)
+        {
+            // member functions have no field number, nothing dispatches here
+            skip_field(d, wire);
+        }
+        else
+        {
+            read_field(d, wire, ::krrs::reflect::get_member_variable<Descriptor>(obj));
+        }
+    }
+};
+
+} // namespace internal
+
+// writes obj's fields in for_each order, each behind a key rendered at compile time. nothing is allocated, embedded
+// messages are sized with encoded_size before they are written
+template <::krrs::reflect::concepts::reflectable T, typename Sink>
+void encode(const T& obj, binary::basic_encoder<Sink>& e)
+{
+    ::krrs::reflect::for_each<T>([&e, &obj]<typename Descriptor>() {
+        if constexpr (!std::is_function_v<typename Descriptor::member_type>)
+        {
+            constexpr std::uint32_t field = internal::field_numbers<T>[::krrs::reflect::descriptor_index<T, Descriptor>()];
+            const auto& value = ::krrs::reflect::get_member_variable<Descriptor>(obj);
+            if (!internal::is_default(value))
+            {
+                internal::write_present_field<field>(e, value);
+            }
+        }
+    });
+}
+
+// writes straight to out, e.g. an io::fd_sink. strings and packed doubles of obj may be handed to the sink without
+// being copied, they are released before this returns
+template <::krrs::reflect::concepts::reflectable T, io::sink Sink>
+void encode(const T& obj, Sink& out)
+{
+    binary::basic_encoder e{out};
+    e.reserve(encoded_size(obj));
+    encode(obj, e);
+    io::release_borrowed(out);
+}
+
+// appends the message to the end of out, reserving exactly once
+template <::krrs::reflect::concepts::reflectable T>
+void encode(const T& obj, std::string& out)
+{
+    io::string_sink sink{out};
+    encode(obj, sink);
+}
+
+template <::krrs::reflect::concepts::reflectable T>
+std::string encode(const T& obj)
+{
+    std::string out;
+    encode(obj, out);
+    return out;
+}
+
+// merges the message held by the rest of d into obj, like protobuf's MergeFrom: fields that are not in the input
+// keep their value and repeated fields are appended to. unknown fields are skipped
+template <::krrs::reflect::concepts::reflectable T>
+void decode(T& obj, binary::decoder& d)
+{
+    static constexpr auto readers = ::krrs::reflect::make_jump_table<T, void(T&, binary::decoder&, wire_type), internal::member_reader<T>>();
+
+    while (!d.at_end())
+    {
+        const auto [field, wire] = internal::read_key(d);
+        if (const std::size_t index = internal::member_index<T>(field); index != readers.size())
+        {
+            readers[index](obj, d, wire);
+        }
+        else
+        {
+            internal::skip_field(d, wire);
+        }
+    }
+}
+
+template <::krrs::reflect::concepts::reflectable T>
+void decode(T& obj, std::string_view bytes)
+{
+    binary::decoder d{bytes};
+    decode(obj, d);
+}
+
+template <::krrs::reflect::concepts::reflectable T>
+T decode(std::string_view bytes)
+{
+    T obj{};
+    decode(obj, bytes);
+    return obj;
+}
+
+} // namespace krrs::protowire
@@ -0,0 +1,202 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "../../include/binary/concepts.hpp"
+#include "../../include/binary/encoder.hpp"
+#include "../../include/reflect/reflect.hpp"
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+namespace krrs::protowire {
+
+// the low three bits of every field key
+enum class wire_type : std::uint8_t
+{
+    varint = 0,
+    fixed64 = 1,
+    length_delimited = 2,
+    fixed32 = 5,
+};
+
+// field number of a member, by default its index in generate_meta_info<T>() plus one (base class members first).
+// specialize it to match an existing .proto, e.g. template <> inline constexpr std::uint32_t krrs::protowire::field_number<&quote::bid> = 7;
+template <auto MemberPtr>
+inline constexpr std::uint32_t field_number = 0;
+
+namespace internal {
+
+// field numbers above this or inside the reserved range are rejected by protoc
+inline constexpr std::uint32_t max_field_number = (1u << 29) - 1;
+inline constexpr std::uint32_t first_reserved_field_number = 19000;
+inline constexpr std::uint32_t last_reserved_field_number = 19999;
+
+// bool, integers and enums, written as a varint. signed values are sign extended to 64 bits like protobuf's int32 /
+// int64, not zigzag encoded
+template <typename T>
+concept varint_value = std::integral<T> || std::is_enum_v<T>;
+
+template <typename T>
+concept fixed_value = std::same_as<T, float> || std::same_as<T, double>;
+
+// element types a repeated field is packed for
+template <typename T>
+concept packable = varint_value<T> || fixed_value<T>;
+
+// a repeated field written as a single length-delimited run of its elements
+template <typename T>
+concept packed_vector = binary::concepts::same_as_vector<T> && packable<typename T::value_type>;
+
+template <typename T>
+concept string_value = std::convertible_to<const T&, std::string_view>;
+
+template <typename T>
+consteval wire_type wire_type_of()
+{
+    if constexpr (varint_value<T>)
+    {
+        return wire_type::varint;
+    }
+    else if constexpr (std::same_as<T, float>)
+    {
+        return wire_type::fixed32;
+    }
+    else if constexpr (std::same_as<T, double>)
+    {
+        return wire_type::fixed64;
+    }
+    else
+    {
+        static_assert(::krrs::reflect::concepts::reflectable<T> || string_value<T>, "protowire: type has no protobuf wire form!");
+        return wire_type::length_delimited;
+    }
+}
+
+template <varint_value T>
+constexpr std::uint64_t to_varint(T value) noexcept
+{
+    if constexpr (std::is_enum_v<T>)
+    {
+        return to_varint(std::to_underlying(value));
+    }
+    else if constexpr (std::same_as<T, bool>)
+    {
+        return value ? 1 : 0;
+    }
+    else if constexpr (std::is_signed_v<T>)
+    {
+        return static_cast<std::uint64_t>(std::int64_t{value});
+    }
+    else
+    {
+        return std::uint64_t{value};
+    }
+}
+
+// a field key, rendered once per field
+struct tag
+{
+    std::array<char, 5> bytes{};
+    std::size_t size = 0;
+
+    constexpr std::string_view view() const noexcept
+    {
+        return {bytes.data(), size};
+    }
+};
+
+consteval tag make_tag(std::uint32_t field, wire_type wire)
+{
+    tag out;
+    std::uint64_t key = (std::uint64_t{field} << 3) | std::to_underlying(wire);
+    while (key >= 0x80)
+    {
+        out.bytes[out.size++] = static_cast<char>((key & 0x7F) | 0x80);
+        key >>= 7;
+    }
+    out.bytes[out.size++] = static_cast<char>(key);
+    return out;
+}
+
+template <std::uint32_t Field, wire_type Wire>
+inline constexpr tag tag_of = make_tag(Field, Wire);
+
+template <typename Descriptor, std::size_t Index>
+consteval std::uint32_t resolve_field_number()
+{
+    if constexpr (std::is_function_v<typename Descriptor::member_type>)
+    {
+        return 0;
+    }
+    else if constexpr (field_number<Descriptor::mem_ptr> != 0)
+    {
+        return field_number<Descriptor::mem_ptr>;
+    }
+    else
+    {
+        return static_cast<std::uint32_t>(Index + 1);
+    }
+}
+
+// field number of every member of T, in generate_meta_info<T>() order. 0 for member functions, which are not encoded
+template <::krrs::reflect::concepts::reflectable T>
+consteval auto make_field_numbers()
+{
+    constexpr auto fields = []<std::size_t... Is>(std::index_sequence<Is...>) {
+        return std::array<std::uint32_t, sizeof...(Is)>{
+            resolve_field_number<::krrs::reflect::detail::meta_type_underlying_type<::krrs::reflect::generate_meta_info<T>()[Is]>, Is>()...};
+    }(std::make_index_sequence<::krrs::reflect::generate_meta_info<T>().size()>{});
+
+    for (std::size_t i = 0; i != fields.size(); ++i)
+    {
+        if (fields[i] == 0)
+        {
+            continue;
+        }
+        if (fields[i] > max_field_number || (fields[i] >= first_reserved_field_number && fields[i] <= last_reserved_field_number))
+        {
+            throw "protowire: field number out of range!";
+        }
+        for (std::size_t j = 0; j != i; ++j)
+        {
+            if (fields[j] == fields[i])
+            {
+                throw "protowire: two members share a field number!";
+            }
+        }
+    }
+    return fields;
+}
+
+template <::krrs::reflect::concepts::reflectable T>
+inline constexpr auto field_numbers = make_field_numbers<T>();
+
+// index of the member holding field in generate_meta_info<T>(), or the member count if T has no such field
+template <::krrs::reflect::concepts::reflectable T>
+constexpr std::size_t member_index(std::uint64_t field) noexcept
+{
+    constexpr auto& fields = field_numbers<T>;
+    // the default numbering, or any override that keeps it, resolves without a search
+    if (field != 0 && field <= fields.size() && fields[field - 1] == field)
+    {
+        return field - 1;
+    }
+    for (std::size_t i = 0; i != fields.size(); ++i)
+    {
+        if (fields[i] != 0 && fields[i] == field)
+        {
+            return i;
+        }
+    }
+    return fields.size();
+}
+
+} // namespace internal
+
+} // namespace krrs::protowire
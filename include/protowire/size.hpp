@@ -0,0 +1,174 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "field.hpp"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+namespace krrs::protowire {
+
+template <::krrs::reflect::concepts::reflectable T>
+constexpr std::size_t encoded_size(const T& obj) noexcept;
+
+namespace internal {
+
+// whether a field holding value is left out. like proto3, zero scalars, empty strings and empty repeated fields are
+// not written, while nested messages always are
+template <typename T>
+constexpr bool is_default(const T& value) noexcept
+{
+    if constexpr (::krrs::reflect::concepts::reflectable<T>)
+    {
+        return false;
+    }
+    else if constexpr (binary::concepts::same_as_optional<T>)
+    {
+        return !value.has_value();
+    }
+    else if constexpr (binary::concepts::same_as_vector<T> || binary::concepts::same_as_unordered_map<T>)
+    {
+        return value.empty();
+    }
+    else if constexpr (varint_value<T>)
+    {
+        return to_varint(value) == 0;
+    }
+    else if constexpr (fixed_value<T>)
+    {
+        // only +0.0, -0.0 would not read back as the default
+        return std::bit_cast<typename binary::internal::unsigned_of_size<sizeof(T)>::type>(value) == 0;
+    }
+    else
+    {
+        return std::string_view{value}.empty();
+    }
+}
+
+// bytes of value without its key, including the length prefix of length-delimited values
+template <typename T>
+constexpr std::size_t payload_size(const T& value) noexcept
+{
+    if constexpr (varint_value<T>)
+    {
+        return binary::internal::varint_size(to_varint(value));
+    }
+    else if constexpr (fixed_value<T>)
+    {
+        return sizeof(T);
+    }
+    else
+    {
+        std::size_t size = 0;
+        if constexpr (::krrs::reflect::concepts::reflectable<T>)
+        {
+            size = encoded_size(value);
+        }
+        else
+        {
+            size = std::string_view{value}.size();
+        }
+        return binary::internal::varint_size(size) + size;
+    }
+}
+
+// elements of a packed repeated field, without the key and length prefix
+template <typename T>
+constexpr std::size_t packed_size(const T& value) noexcept
+{
+    using value_type = typename T::value_type;
+    if constexpr (fixed_value<value_type>)
+    {
+        return value.size() * sizeof(value_type);
+    }
+    else
+    {
+        std::size_t size = 0;
+        for (const value_type elem : value)
+        {
+            size += binary::internal::varint_size(to_varint(elem));
+        }
+        return size;
+    }
+}
+
+// the { 1: key, 2: value } entry message protobuf writes for every element of a map field
+template <typename Key, typename Value>
+constexpr std::size_t map_entry_size(const Key& key, const Value& value) noexcept;
+
+// every byte written for a field holding value, keys included, even if value is the default
+template <std::uint32_t Field, typename T>
+constexpr std::size_t present_field_size(const T& value) noexcept
+{
+    if constexpr (binary::concepts::same_as_optional<T>)
+    {
+        return value.has_value() ? present_field_size<Field>(*value) : 0;
+    }
+    else if constexpr (packed_vector<T>)
+    {
+        const std::size_t size = packed_size(value);
+        return tag_of<Field, wire_type::length_delimited>.size + binary::internal::varint_size(size) + size;
+    }
+    else if constexpr (binary::concepts::same_as_vector<T>)
+    {
+        // every element is a field of its own, empty ones included
+        std::size_t size = 0;
+        for (const auto& elem : value)
+        {
+            size += tag_of<Field, wire_type_of<typename T::value_type>()>.size + payload_size(elem);
+        }
+        return size;
+    }
+    else if constexpr (binary::concepts::same_as_unordered_map<T>)
+    {
+        std::size_t size = 0;
+        for (const auto& [key, elem] : value)
+        {
+            const std::size_t entry = map_entry_size(key, elem);
+            size += tag_of<Field, wire_type::length_delimited>.size + binary::internal::varint_size(entry) + entry;
+        }
+        return size;
+    }
+    else
+    {
+        return tag_of<Field, wire_type_of<T>()>.size + payload_size(value);
+    }
+}
+
+// 0 for a field that is left out
+template <std::uint32_t Field, typename T>
+constexpr std::size_t field_size(const T& value) noexcept
+{
+    return is_default(value) ? 0 : present_field_size<Field>(value);
+}
+
+// key and value are always written
+template <typename Key, typename Value>
+constexpr std::size_t map_entry_size(const Key& key, const Value& value) noexcept
+{
+    return present_field_size<1>(key) + present_field_size<2>(value);
+}
+
+} // namespace internal
+
+// exact size of obj's message, the same number of bytes encode writes
+template <::krrs::reflect::concepts::reflectable T>
+constexpr std::size_t encoded_size(const T& obj) noexcept
+{
+    std::size_t size = 0;
+    ::krrs::reflect::for_each<T>([&size, &obj]<typename Descriptor>() {
+        if constexpr (!std::is_function_v<typename Descriptor::member_type>)
+        {
+            constexpr std::uint32_t field = internal::field_numbers<T>[::krrs::reflect::descriptor_index<T, Descriptor>()];
+            size += internal::field_size<field>(::krrs::reflect::get_member_variable<Descriptor>(obj));
+        }
+    });
+    return size;
+}
+
+} // namespace krrs::protowire
@@ -0,0 +1,456 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "concepts.hpp"
+#include "reflect.hpp"
+#include "simd.hpp"
+#include "soa_vector.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+namespace krrs::reflect {
+
+namespace concepts {
+
+// members the sum / min / max kernels are specialised for
+template <typename T>
+concept aggregatable = std::is_arithmetic_v<T> && !std::same_as<T, bool>;
+
+} // namespace concepts
+
+// what sum<MemberPtr>() accumulates in: floats in their own type, integers widened to 64 bits
+template <concepts::aggregatable T>
+using sum_type_t = std::conditional_t<std::floating_point<T>, T, std::conditional_t<std::is_signed_v<T>, std::int64_t, std::uint64_t>>;
+
+namespace detail {
+
+enum class aggregate_op : std::uint8_t
+{
+    sum,
+    min,
+    max,
+};
+
+// one member of count objects laid out stride bytes apart: a soa_vector column (stride == sizeof(M)) or the member
+// of every element of a contiguous range of T (stride == sizeof(T))
+template <typename M>
+struct member_stride
+{
+    using value_type = M;
+
+    const char* base;
+    std::size_t count;
+    std::size_t stride;
+
+    const M& operator[](std::size_t index) const noexcept
+    {
+        return *reinterpret_cast<const M*>(base + index * stride);
+    }
+};
+
+// the element type of a range the kernels accept: a soa_vector<T>, or a contiguous range of T (std::vector<T>,
+// std::span<const T>, std::array<T, N>, ...) whose members are read in place at sizeof(T) strides
+template <typename Range>
+struct aggregate_element
+{
+};
+
+template <typename Range>
+    requires std::ranges::contiguous_range<Range> && std::ranges::sized_range<Range> && concepts::reflectable<std::ranges::range_value_t<Range>>
+struct aggregate_element<Range>
+{
+    using type = std::ranges::range_value_t<Range>;
+};
+
+template <concepts::reflectable T>
+struct aggregate_element<soa_vector<T>>
+{
+    using type = T;
+};
+
+template <typename Range>
+using aggregate_element_t = typename aggregate_element<std::remove_cvref_t<Range>>::type;
+
+template <typename Range>
+concept aggregate_range = requires { typename aggregate_element_t<Range>; };
+
+template <auto MemberPtr, aggregate_range Range>
+auto strided_member(const Range& range) noexcept
+{
+    using T = aggregate_element_t<Range>;
+    using descriptor = descriptor_for<T, MemberPtr>;
+    using member_type = typename descriptor::member_type;
+    if constexpr (std::same_as<std::remove_cvref_t<Range>, soa_vector<T>>)
+    {
+        const auto column = range.template column<MemberPtr>();
+        return member_stride<member_type>{reinterpret_cast<const char*>(column.data()), column.size(), sizeof(member_type)};
+    }
+    else
+    {
+        const std::size_t count = std::ranges::size(range);
+        if (count == 0)
+        {
+            return member_stride<member_type>{nullptr, 0, sizeof(T)};
+        }
+        const member_type& first = get_member_variable<descriptor>(*std::ranges::data(range));
+        return member_stride<member_type>{reinterpret_cast<const char*>(&first), count, sizeof(T)};
+    }
+}
+
+template <aggregate_op Op, typename Acc>
+constexpr Acc combine(Acc acc, Acc value) noexcept
+{
+    if constexpr (Op == aggregate_op::sum)
+    {
+        return acc + value;
+    }
+    else if constexpr (Op == aggregate_op::min)
+    {
+        return value < acc ? value : acc;
+    }
+    else
+    {
+        return acc < value ? value : acc;
+    }
+}
+
+template <aggregate_op Op, typename Acc, typename M>
+Acc reduce_scalar(const member_stride<M>& values, std::size_t first, Acc acc) noexcept
+{
+    for (std::size_t i = first; i != values.count; ++i)
+    {
+        acc = combine<Op, Acc>(acc, values[i]);
+    }
+    return acc;
+}
+
+#if KRRS_SIMD_X86
+
+// the avx2 form of a member type: how a vector of it is loaded from a column (contiguous) or from an array of
+// structs (gathered at a fixed stride), and the lane-wise operations. int32 is widened to int64 lanes on load so
+// sums cannot overflow
+template <typename M>
+struct avx2_lanes;
+
+template <>
+struct avx2_lanes<double>
+{
+    using vector = __m256d;
+    using value_type = double;
+    static constexpr std::size_t width = 4;
+
+    KRRS_TARGET_AVX2 static __m256i offsets(std::size_t stride) noexcept
+    {
+        const auto s = static_cast<long long>(stride);
+        return _mm256_setr_epi64x(0, s, 2 * s, 3 * s);
+    }
+
+    KRRS_TARGET_AVX2 static vector load(const char* p, std::size_t stride, __m256i offsets) noexcept
+    {
+        return stride == sizeof(double) ? _mm256_loadu_pd(reinterpret_cast<const double*>(p)) : _mm256_i64gather_pd(reinterpret_cast<const double*>(p), offsets, 1);
+    }
+
+    KRRS_TARGET_AVX2 static vector broadcast(value_type value) noexcept
+    {
+        return _mm256_set1_pd(value);
+    }
+
+    KRRS_TARGET_AVX2 static vector add(vector a, vector b) noexcept
+    {
+        return _mm256_add_pd(a, b);
+    }
+
+    KRRS_TARGET_AVX2 static vector min(vector a, vector b) noexcept
+    {
+        return _mm256_min_pd(a, b);
+    }
+
+    KRRS_TARGET_AVX2 static vector max(vector a, vector b) noexcept
+    {
+        return _mm256_max_pd(a, b);
+    }
+
+    KRRS_TARGET_AVX2 static void store(value_type* out, vector v) noexcept
+    {
+        _mm256_storeu_pd(out, v);
+    }
+};
+
+template <>
+struct avx2_lanes<float>
+{
+    using vector = __m256;
+    using value_type = float;
+    static constexpr std::size_t width = 8;
+
+    KRRS_TARGET_AVX2 static __m256i offsets(std::size_t stride) noexcept
+    {
+        const auto s = static_cast<int>(stride);
+        return _mm256_setr_epi32(0, s, 2 * s, 3 * s, 4 * s, 5 * s, 6 * s, 7 * s);
+    }
+
+    KRRS_TARGET_AVX2 static vector load(const char* p, std::size_t stride, __m256i offsets) noexcept
+    {
+        return stride == sizeof(float) ? _mm256_loadu_ps(reinterpret_cast<const float*>(p)) : _mm256_i32gather_ps(reinterpret_cast<const float*>(p), offsets, 1);
+    }
+
+    KRRS_TARGET_AVX2 static vector broadcast(value_type value) noexcept
+    {
+        return _mm256_set1_ps(value);
+    }
+
+    KRRS_TARGET_AVX2 static vector add(vector a, vector b) noexcept
+    {
+        return _mm256_add_ps(a, b);
+    }
+
+    KRRS_TARGET_AVX2 static vector min(vector a, vector b) noexcept
+    {
+        return _mm256_min_ps(a, b);
+    }
+
+    KRRS_TARGET_AVX2 static vector max(vector a, vector b) noexcept
+    {
+        return _mm256_max_ps(a, b);
+    }
+
+    KRRS_TARGET_AVX2 static void store(value_type* out, vector v) noexcept
+    {
+        _mm256_storeu_ps(out, v);
+    }
+};
+
+// int64 lanes, shared by the int64 and the widened int32 forms
+struct avx2_int64_ops
+{
+    using vector = __m256i;
+    using value_type = std::int64_t;
+    static constexpr std::size_t width = 4;
+
+    KRRS_TARGET_AVX2 static __m256i offsets(std::size_t stride) noexcept
+    {
+        const auto s = static_cast<long long>(stride);
+        return _mm256_setr_epi64x(0, s, 2 * s, 3 * s);
+    }
+
+    KRRS_TARGET_AVX2 static vector broadcast(value_type value) noexcept
+    {
+        return _mm256_set1_epi64x(value);
+    }
+
+    KRRS_TARGET_AVX2 static vector add(vector a, vector b) noexcept
+    {
+        return _mm256_add_epi64(a, b);
+    }
+
+    // avx2 has no 64-bit min / max, a compare and blend stands in
+    KRRS_TARGET_AVX2 static vector min(vector a, vector b) noexcept
+    {
+        return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b));
+    }
+
+    KRRS_TARGET_AVX2 static vector max(vector a, vector b) noexcept
+    {
+        return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b));
+    }
+
+    KRRS_TARGET_AVX2 static void store(value_type* out, vector v) noexcept
+    {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), v);
+    }
+};
+
+template <>
+struct avx2_lanes<std::int64_t> : avx2_int64_ops
+{
+    KRRS_TARGET_AVX2 static vector load(const char* p, std::size_t stride, __m256i offsets) noexcept
+    {
+        return stride == sizeof(std::int64_t) ? _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))
+                                              : _mm256_i64gather_epi64(reinterpret_cast<const long long*>(p), offsets, 1);
+    }
+};
+
+template <>
+struct avx2_lanes<std::int32_t> : avx2_int64_ops
+{
+    KRRS_TARGET_AVX2 static vector load(const char* p, std::size_t stride, __m256i offsets) noexcept
+    {
+        const __m128i narrow = stride == sizeof(std::int32_t) ? _mm_loadu_si128(reinterpret_cast<const __m128i*>(p))
+                                                              : _mm256_i64gather_epi32(reinterpret_cast<const int*>(p), offsets, 1);
+        return _mm256_cvtepi32_epi64(narrow);
+    }
+};
+
+// M has an avx2 form whose lanes accumulate in Acc
+template <typename M, typename Acc>
+concept avx2_reducible = requires { typename avx2_lanes<M>::value_type; } && std::same_as<typename avx2_lanes<M>::value_type, Acc>;
+
+template <aggregate_op Op, typename Lanes>
+KRRS_TARGET_AVX2 typename Lanes::vector apply_lanes(typename Lanes::vector a, typename Lanes::vector b) noexcept
+{
+    if constexpr (Op == aggregate_op::sum)
+    {
+        return Lanes::add(a, b);
+    }
+    else if constexpr (Op == aggregate_op::min)
+    {
+        return Lanes::min(a, b);
+    }
+    else
+    {
+        return Lanes::max(a, b);
+    }
+}
+
+// the whole vectors of values, then the tail through the scalar loop. sums keep two accumulators in flight
+template <aggregate_op Op, typename M>
+KRRS_TARGET_AVX2 typename avx2_lanes<M>::value_type reduce_avx2(const member_stride<M>& values, typename avx2_lanes<M>::value_type init) noexcept
+{
+    using lanes = avx2_lanes<M>;
+    using value_type = typename lanes::value_type;
+    const __m256i offsets = lanes::offsets(values.stride);
+    const std::size_t step = lanes::width * values.stride;
+    const std::size_t whole = values.count - values.count % lanes::width;
+
+    const char* p = values.base;
+    typename lanes::vector acc0 = Op == aggregate_op::sum ? lanes::broadcast(value_type{}) : lanes::broadcast(init);
+    typename lanes::vector acc1 = acc0;
+    std::size_t i = 0;
+    for (; i + 2 * lanes::width <= whole; i += 2 * lanes::width, p += 2 * step)
+    {
+        acc0 = apply_lanes<Op, lanes>(acc0, lanes::load(p, values.stride, offsets));
+        acc1 = apply_lanes<Op, lanes>(acc1, lanes::load(p + step, values.stride, offsets));
+    }
+    if (i != whole)
+    {
+        acc0 = apply_lanes<Op, lanes>(acc0, lanes::load(p, values.stride, offsets));
+        i += lanes::width;
+    }
+    acc0 = apply_lanes<Op, lanes>(acc0, acc1);
+
+    value_type lane[lanes::width];
+    lanes::store(lane, acc0);
+    value_type acc = init;
+    for (const value_type v : lane)
+    {
+        acc = combine<Op, value_type>(acc, v);
+    }
+    return reduce_scalar<Op, value_type>(values, i, acc);
+}
+
+#endif
+
+template <aggregate_op Op, typename Acc, typename M>
+Acc reduce_member(const member_stride<M>& values, Acc init, simd::level requested) noexcept
+{
+#if KRRS_SIMD_X86
+    if constexpr (avx2_reducible<M, Acc>)
+    {
+        if (values.count >= avx2_lanes<M>::width && simd::supported_level(requested) == simd::level::avx2)
+        {
+            return reduce_avx2<Op, M>(values, init);
+        }
+    }
+#else
+    static_cast<void>(requested);
+#endif
+    return reduce_scalar<Op, Acc>(values, 0, init);
+}
+
+// the type min / max compare in: the avx2 lane type where there is one, otherwise M itself
+template <typename M>
+struct extremum_lane
+{
+    using type = M;
+};
+
+#if KRRS_SIMD_X86
+template <typename M>
+    requires requires { typename avx2_lanes<M>::value_type; }
+struct extremum_lane<M>
+{
+    using type = typename avx2_lanes<M>::value_type;
+};
+#endif
+
+template <aggregate_op Op, typename M>
+std::optional<M> extremum(const member_stride<M>& values, simd::level requested) noexcept
+{
+    if (values.count == 0)
+    {
+        return std::nullopt;
+    }
+    using lane_type = typename extremum_lane<M>::type;
+    const lane_type found = reduce_member<Op, lane_type>(values, lane_type{values[0]}, requested);
+    // an int32 column is compared in int64 lanes, the result is still one of its own values
+    if constexpr (std::same_as<lane_type, M>)
+    {
+        return found;
+    }
+    else
+    {
+        return static_cast<M>(found);
+    }
+}
+
+} // namespace detail
+
+// folds the member of every element with op, starting from init, e.g. reduce<&trade::quantity>(trades, 0, std::plus{}).
+// range is a soa_vector<T> or a contiguous range of T (std::vector<T>, std::span<const T>, ...), where the member is
+// read in place at sizeof(T) strides. MemberPtr may name a member of a base class
+template <auto MemberPtr, detail::aggregate_range Range, typename Acc, typename BinaryOp>
+constexpr Acc reduce(const Range& range, Acc init, BinaryOp op)
+{
+    const auto values = detail::strided_member<MemberPtr>(range);
+    for (std::size_t i = 0; i != values.count; ++i)
+    {
+        init = op(std::move(init), values[i]);
+    }
+    return init;
+}
+
+// sum of the member over range, vectorized for double, float, int32 and int64 members. floats are added in several
+// lanes at once, so the result can differ from a sequential loop in the last bits
+template <auto MemberPtr, detail::aggregate_range Range>
+auto sum(const Range& range, simd::level requested = simd::level::avx2) noexcept
+{
+    const auto values = detail::strided_member<MemberPtr>(range);
+    using member_type = typename decltype(values)::value_type;
+    static_assert(concepts::aggregatable<member_type>, "sum needs an arithmetic member!");
+    return detail::reduce_member<detail::aggregate_op::sum, sum_type_t<member_type>>(values, sum_type_t<member_type>{}, requested);
+}
+
+// smallest value of the member, or nullopt for an empty range. unspecified if the member holds NaNs
+template <auto MemberPtr, detail::aggregate_range Range>
+auto min(const Range& range, simd::level requested = simd::level::avx2) noexcept
+{
+    const auto values = detail::strided_member<MemberPtr>(range);
+    static_assert(concepts::aggregatable<typename decltype(values)::value_type>, "min needs an arithmetic member!");
+    return detail::extremum<detail::aggregate_op::min>(values, requested);
+}
+
+template <auto MemberPtr, detail::aggregate_range Range>
+auto max(const Range& range, simd::level requested = simd::level::avx2) noexcept
+{
+    const auto values = detail::strided_member<MemberPtr>(range);
+    static_assert(concepts::aggregatable<typename decltype(values)::value_type>, "max needs an arithmetic member!");
+    return detail::extremum<detail::aggregate_op::max>(values, requested);
+}
+
+// number of elements whose member satisfies pred
+template <auto MemberPtr, detail::aggregate_range Range, typename Predicate>
+std::size_t count_if(const Range& range, Predicate pred)
+{
+    return reduce<MemberPtr>(range, std::size_t{0}, [&pred](std::size_t count, const auto& value) { return count + (pred(value) ? std::size_t{1} : std::size_t{0}); });
+}
+
+} // namespace krrs::reflect
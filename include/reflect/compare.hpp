@@ -0,0 +1,329 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "concepts.hpp"
+#include "layout.hpp"
+#include "reflect.hpp"
+
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+namespace krrs::reflect {
+
+template <concepts::reflectable T>
+constexpr bool equal(const T& lhs, const T& rhs) noexcept;
+
+template <concepts::reflectable T>
+constexpr auto compare(const T& lhs, const T& rhs) noexcept;
+
+namespace detail {
+
+// whether U and the elements inside it have their own == (or <=>). std::vector<U> declares both for any U
+template <typename U>
+consteval bool has_equal()
+{
+    if constexpr (!std::equality_comparable<U>)
+    {
+        return false;
+    }
+    else if constexpr (std::ranges::input_range<U>)
+    {
+        using element_type = std::ranges::range_value_t<U>;
+        // a range may hold itself, e.g. std::filesystem::path
+        if constexpr (std::same_as<element_type, U>)
+        {
+            return true;
+        }
+        else
+        {
+            return has_equal<element_type>();
+        }
+    }
+    else
+    {
+        return true;
+    }
+}
+
+template <typename U>
+consteval bool has_three_way()
+{
+    if constexpr (!std::three_way_comparable<U>)
+    {
+        return false;
+    }
+    else if constexpr (std::ranges::input_range<U>)
+    {
+        using element_type = std::ranges::range_value_t<U>;
+        // a range may hold itself, e.g. std::filesystem::path
+        if constexpr (std::same_as<element_type, U>)
+        {
+            return true;
+        }
+        else
+        {
+            return has_three_way<element_type>();
+        }
+    }
+    else
+    {
+        return true;
+    }
+}
+
+// members are compared with their own == and <=> when they have one, reflected types without go memberwise
+template <typename U>
+constexpr bool equal_value(const U& lhs, const U& rhs) noexcept
+{
+    if constexpr (has_equal<U>())
+    {
+        return lhs == rhs;
+    }
+    else if constexpr (concepts::reflectable<U>)
+    {
+        return ::krrs::reflect::equal(lhs, rhs);
+    }
+    else
+    {
+        static_assert(std::ranges::input_range<U>, "member type has no ==, reflect it or define one!");
+        return std::ranges::equal(lhs, rhs, [](const auto& l, const auto& r) { return equal_value(l, r); });
+    }
+}
+
+template <typename U>
+constexpr auto compare_value(const U& lhs, const U& rhs) noexcept
+{
+    if constexpr (has_three_way<U>())
+    {
+        return lhs <=> rhs;
+    }
+    else if constexpr (concepts::reflectable<U>)
+    {
+        return ::krrs::reflect::compare(lhs, rhs);
+    }
+    else
+    {
+        // unordered containers iterate equal contents in any order, so they have no ordering to give
+        static_assert(std::ranges::input_range<U> && !requires { typename U::hasher; }, "member type has no <=>, reflect it or define one!");
+        return std::lexicographical_compare_three_way(std::ranges::begin(lhs), std::ranges::end(lhs), std::ranges::begin(rhs), std::ranges::end(rhs),
+                                                      [](const auto& l, const auto& r) { return compare_value(l, r); });
+    }
+}
+
+template <typename Descriptor>
+struct member_ordering
+{
+    using type = decltype(compare_value(std::declval<const typename Descriptor::member_type&>(), std::declval<const typename Descriptor::member_type&>()));
+};
+
+// member functions do not take part, strong_ordering leaves the common category as it is
+template <typename Descriptor>
+    requires std::is_function_v<typename Descriptor::member_type>
+struct member_ordering<Descriptor>
+{
+    using type = std::strong_ordering;
+};
+
+template <concepts::reflectable T, std::size_t... Is>
+auto make_ordering(std::index_sequence<Is...>)
+    -> std::common_comparison_category_t<typename member_ordering<meta_type_underlying_type<generate_meta_info<T>()[Is]>>::type...>;
+
+// the weakest ordering among the members of T
+template <concepts::reflectable T>
+using ordering_t = decltype(make_ordering<T>(std::make_index_sequence<generate_meta_info<T>().size()>{}));
+
+// blocks of bytes first, then scalars, strings, reflected types and whatever else. stops at the first difference, so
+// an expensive member is only reached when all the cheap ones matched
+template <typename Descriptor>
+consteval int equality_cost()
+{
+    using member_type = typename Descriptor::member_type;
+    if constexpr (std::is_arithmetic_v<member_type> || std::is_enum_v<member_type> || std::is_pointer_v<member_type>)
+    {
+        return 1;
+    }
+    else if constexpr (concepts::stringable<member_type>)
+    {
+        return 2;
+    }
+    else if constexpr (concepts::reflectable<member_type>)
+    {
+        return 3;
+    }
+    else
+    {
+        return 4;
+    }
+}
+
+template <concepts::reflectable T>
+consteval std::size_t compared_member_count()
+{
+    constexpr auto runs = member_runs<T>();
+    return static_cast<std::size_t>(std::ranges::count_if(runs, [](const member_run& run) { return run.how == member_run::block || run.how == member_run::single; }));
+}
+
+// indices into generate_meta_info<T>() in the order equal visits them
+template <concepts::reflectable T>
+consteval auto equality_order()
+{
+    constexpr auto runs = member_runs<T>();
+    std::array<std::size_t, compared_member_count<T>()> order{};
+    std::array<int, compared_member_count<T>()> costs{};
+    std::size_t found = 0;
+    std::size_t index = 0;
+    for_each<T>([&]<typename Descriptor>() {
+        const member_run run = runs[index];
+        if (run.how == member_run::block || run.how == member_run::single)
+        {
+            // insertion sort, equal costs keep declaration order
+            std::size_t at = found++;
+            const int cost = run.how == member_run::block ? 0 : equality_cost<Descriptor>();
+            for (; at != 0 && costs[at - 1] > cost; --at)
+            {
+                order[at] = order[at - 1];
+                costs[at] = costs[at - 1];
+            }
+            order[at] = index;
+            costs[at] = cost;
+        }
+        ++index;
+    });
+    return order;
+}
+
+// the members of the block that starts at Index one by one, for constant evaluation where memcmp is not available.
+// member functions may sit between them
+template <concepts::reflectable T, std::size_t Index>
+constexpr bool equal_block_members(const T& lhs, const T& rhs) noexcept
+{
+    using descriptor = meta_type_underlying_type<generate_meta_info<T>()[Index]>;
+    constexpr auto runs = member_runs<T>();
+    constexpr std::size_t next = Index + 1;
+    bool same = true;
+    if constexpr (runs[Index].how != member_run::none)
+    {
+        same = equal_value(get_member_variable<descriptor>(lhs), get_member_variable<descriptor>(rhs));
+    }
+    if constexpr (next != runs.size() && (runs[next].how == member_run::in_block || runs[next].how == member_run::none))
+    {
+        same = same && equal_block_members<T, next>(lhs, rhs);
+    }
+    return same;
+}
+
+template <concepts::reflectable T, std::size_t Index>
+constexpr bool equal_at(const T& lhs, const T& rhs) noexcept
+{
+    using descriptor = meta_type_underlying_type<generate_meta_info<T>()[Index]>;
+    constexpr member_run run = member_runs<T>()[Index];
+    const auto& left = get_member_variable<descriptor>(lhs);
+    const auto& right = get_member_variable<descriptor>(rhs);
+    if constexpr (run.how == member_run::block)
+    {
+        if consteval
+        {
+            return equal_block_members<T, Index>(lhs, rhs);
+        }
+        else
+        {
+            return std::memcmp(std::addressof(left), std::addressof(right), run.bytes) == 0;
+        }
+    }
+    else
+    {
+        return equal_value(left, right);
+    }
+}
+
+template <concepts::reflectable T, std::size_t... Is>
+constexpr bool equal_members(const T& lhs, const T& rhs, std::index_sequence<Is...>) noexcept
+{
+    constexpr auto order = equality_order<T>();
+    return (equal_at<T, order[Is]>(lhs, rhs) && ...);
+}
+
+// block_equal carries whether the last block compared equal as a whole to the members after its first
+template <concepts::reflectable T, std::size_t Index>
+constexpr ordering_t<T> compare_at(const T& lhs, const T& rhs, bool& block_equal) noexcept
+{
+    using descriptor = meta_type_underlying_type<generate_meta_info<T>()[Index]>;
+    constexpr member_run run = member_runs<T>()[Index];
+    if constexpr (run.how == member_run::none)
+    {
+        return ordering_t<T>::equivalent;
+    }
+    else
+    {
+        const auto& left = get_member_variable<descriptor>(lhs);
+        const auto& right = get_member_variable<descriptor>(rhs);
+        // bytes order values differently than <=> does, so a block only tells that its members are all equal
+        if constexpr (run.how == member_run::block && run.bytes > sizeof(typename descriptor::member_type))
+        {
+            if !consteval
+            {
+                block_equal = std::memcmp(std::addressof(left), std::addressof(right), run.bytes) == 0;
+                if (block_equal)
+                {
+                    return ordering_t<T>::equivalent;
+                }
+            }
+        }
+        else if constexpr (run.how == member_run::in_block)
+        {
+            if (block_equal)
+            {
+                return ordering_t<T>::equivalent;
+            }
+        }
+        return compare_value(left, right);
+    }
+}
+
+template <concepts::reflectable T, std::size_t... Is>
+constexpr ordering_t<T> compare_members(const T& lhs, const T& rhs, std::index_sequence<Is...>) noexcept
+{
+    ordering_t<T> out = ordering_t<T>::equivalent;
+    bool block_equal = false;
+    static_cast<void>(((out = compare_at<T, Is>(lhs, rhs, block_equal), out == 0) && ...));
+    return out;
+}
+
+} // namespace detail
+
+// true when every reflected member of lhs and rhs, base classes included, compares equal. when T is bitwise
+// comparable (see layout.hpp) that is a single memcmp, otherwise the members are compared cheapest first, with
+// touching integer and enum members compared as one block of bytes
+template <concepts::reflectable T>
+constexpr bool equal(const T& lhs, const T& rhs) noexcept
+{
+    if constexpr (is_bitwise_comparable<T>)
+    {
+        if !consteval
+        {
+            return std::memcmp(std::addressof(lhs), std::addressof(rhs), sizeof(T)) == 0;
+        }
+    }
+    return detail::equal_members(lhs, rhs, std::make_index_sequence<detail::compared_member_count<T>()>{});
+}
+
+// lexicographic three-way comparison of the reflected members in for_each order, returning the weakest ordering
+// among them, e.g. std::partial_ordering once a double takes part. a run of touching integer and enum members is
+// skipped with one memcmp when it is equal
+template <concepts::reflectable T>
+constexpr auto compare(const T& lhs, const T& rhs) noexcept
+{
+    return detail::compare_members(lhs, rhs, std::make_index_sequence<generate_meta_info<T>().size()>{});
+}
+
+} // namespace krrs::reflect
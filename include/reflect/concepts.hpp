@@ -74,6 +74,11 @@ concept reflectable = requires {
     { RawT::meta_info_array_as_id() } -> std::same_as<void (*)()>; // did you forget to use REFLECT / REFLECT_PRINTABLE macro?
 };
 
+// stands in for a reference to a reflected object whose members live elsewhere, e.g. soa_vector<T>::reference.
+// get_member_variable reads through it like through the object itself
+template <typename T, typename RawT = std::remove_cvref_t<T>>
+concept member_proxy = requires { typename RawT::proxied_type; } && reflectable<typename RawT::proxied_type>;
+
 template <typename T, typename RawT = std::remove_cvref_t<T>>
 concept reflect_and_printable = requires {
     requires reflectable<RawT>;
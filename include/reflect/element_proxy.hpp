@@ -0,0 +1,137 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "concepts.hpp"
+#include "reflect.hpp"
+
+#include <cstddef>
+#include <type_traits>
+
+namespace krrs::reflect::detail {
+
+// stands in for a T& (or const T&) to element index of a container that does not store T whole, e.g. soa_vector or
+// hot_cold_vector. members are read and written where the container keeps them, through its
+// member_at<Descriptor>(index), and converting to T gathers a copy of the whole element
+template <typename Container, bool Const>
+class element_reference
+{
+    using container_type = std::conditional_t<Const, const Container, Container>;
+    using value_type = typename Container::value_type;
+
+public:
+    using proxied_type = value_type;
+
+    element_reference(container_type* parent, std::size_t index) noexcept
+        : parent_{parent}
+        , index_{index}
+    {
+    }
+
+    element_reference(const element_reference&) = default;
+
+    // a reference to the member, e.g. v[i].get<&T::price>() += 1.0. MemberPtr may name a member of a base class
+    template <auto MemberPtr>
+    decltype(auto) get() const noexcept
+    {
+        return get<descriptor_for<value_type, MemberPtr>>();
+    }
+
+    template <typename Descriptor>
+        requires concepts::descriptor_like<Descriptor>
+    decltype(auto) get() const noexcept
+    {
+        static_assert(!std::is_function_v<typename Descriptor::member_type>, "member functions are not stored!");
+        return parent_->template member_at<Descriptor>(index_);
+    }
+
+    operator value_type() const
+    {
+        value_type out{};
+        for_each<value_type>([this, &out]<typename Descriptor>() {
+            if constexpr (!std::is_function_v<typename Descriptor::member_type>)
+            {
+                get_member_variable<Descriptor>(out) = get<Descriptor>();
+            }
+        });
+        return out;
+    }
+
+    // v[i] = v[j] copies the element over, it does not rebind the proxy
+    const element_reference& operator=(const element_reference& other) const
+        requires(!Const)
+    {
+        return *this = static_cast<value_type>(other);
+    }
+
+    // scatters value over the places the element's members are stored
+    const element_reference& operator=(const value_type& value) const
+        requires(!Const)
+    {
+        for_each<value_type>([this, &value]<typename Descriptor>() {
+            if constexpr (!std::is_function_v<typename Descriptor::member_type>)
+            {
+                get<Descriptor>() = get_member_variable<Descriptor>(value);
+            }
+        });
+        return *this;
+    }
+
+    std::size_t index() const noexcept
+    {
+        return index_;
+    }
+
+private:
+    container_type* parent_;
+    std::size_t index_;
+};
+
+// yields proxies, so `auto&& e : v` binds to a reference and `T e : v` copies the element out
+template <typename Container, bool Const>
+class element_iterator
+{
+    using container_type = std::conditional_t<Const, const Container, Container>;
+
+public:
+    using value_type = typename Container::value_type;
+    using difference_type = std::ptrdiff_t;
+
+    element_iterator() = default;
+
+    element_iterator(container_type* parent, std::size_t index) noexcept
+        : parent_{parent}
+        , index_{index}
+    {
+    }
+
+    element_reference<Container, Const> operator*() const noexcept
+    {
+        return {parent_, index_};
+    }
+
+    element_iterator& operator++() noexcept
+    {
+        ++index_;
+        return *this;
+    }
+
+    element_iterator operator++(int) noexcept
+    {
+        element_iterator copy = *this;
+        ++index_;
+        return copy;
+    }
+
+    bool operator==(const element_iterator& other) const noexcept
+    {
+        return index_ == other.index_;
+    }
+
+private:
+    container_type* parent_ = nullptr;
+    std::size_t index_ = 0;
+};
+
+} // namespace krrs::reflect::detail
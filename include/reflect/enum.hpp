@@ -7,6 +7,7 @@
 #include "preprocessor.hpp"
 #include "utility.hpp"
 
+#include <array>
 #include <format>
 #include <sstream>
 
@@ -20,6 +21,8 @@ namespace krrs::reflect {
     case ::krrs::reflect::utility::hash_dj2ba(PP_STRINGIZE(value)):                                                                                            \
         return Enum::value;
 
+#define ENUM_NAME(Enum, value) std::string_view{PP_STRINGIZE(value)},
+
 #define ENUM_PRINTABLE(Enum, ...)                                                                                                                              \
     inline constexpr std::string_view enum_to_string(Enum value)                                                                                               \
     {                                                                                                                                                          \
@@ -32,6 +35,12 @@ namespace krrs::reflect {
         return "<unknown>";                                                                                                                                    \
     }                                                                                                                                                          \
                                                                                                                                                                \
+    /* every enumerator name, in declaration order */                                                                                                          \
+    inline constexpr auto enum_names(Enum)                                                                                                                     \
+    {                                                                                                                                                          \
+        return std::array{PP_FOR_EACH(ENUM_NAME, Enum, PP_EVAL_TUPLE(__VA_ARGS__))};                                                                           \
+    }                                                                                                                                                          \
+                                                                                                                                                               \
     inline Enum string_to_enum(Enum, const ::krrs::reflect::concepts::stringable auto& str)                                                                    \
     {                                                                                                                                                          \
         static_assert(::krrs::reflect::concepts::enumerable<Enum>);                                                                                            \
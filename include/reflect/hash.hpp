@@ -0,0 +1,264 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "concepts.hpp"
+#include "layout.hpp"
+#include "reflect.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#if defined(_MSC_VER) && !defined(__clang__) && (defined(_M_X64) || defined(_M_ARM64))
+#include <intrin.h>
+#endif
+
+namespace krrs::reflect {
+
+template <concepts::reflectable T>
+struct hash;
+
+namespace detail {
+
+inline constexpr std::uint64_t hash_k0 = 0xA0761D6478BD642Full;
+inline constexpr std::uint64_t hash_k1 = 0xE7037ED1A0B428DBull;
+inline constexpr std::uint64_t hash_k2 = 0x8EBC6AF09C88C6E3ull;
+
+// the 128-bit product of a and b folded to 64 bits from four 32-bit partial products, for targets without a wider
+// multiply and for constant evaluation where the intrinsics are not available
+constexpr std::uint64_t fold_multiply_portable(std::uint64_t a, std::uint64_t b) noexcept
+{
+    const std::uint64_t a_low = a & 0xFFFFFFFF;
+    const std::uint64_t a_high = a >> 32;
+    const std::uint64_t b_low = b & 0xFFFFFFFF;
+    const std::uint64_t b_high = b >> 32;
+    const std::uint64_t low_low = a_low * b_low;
+    const std::uint64_t high_low = a_high * b_low;
+    const std::uint64_t low_high = a_low * b_high;
+    // at most (2^32 - 1)^2 + 2 * (2^32 - 1) = 2^64 - 1, so it cannot overflow
+    const std::uint64_t middle = (low_low >> 32) + (high_low & 0xFFFFFFFF) + low_high;
+    const std::uint64_t high = a_high * b_high + (high_low >> 32) + (middle >> 32);
+    const std::uint64_t low = middle << 32 | (low_low & 0xFFFFFFFF);
+    return low ^ high;
+}
+
+// the 128-bit product of a and b folded to 64 bits, one multiply mixes every bit of both inputs. both are salted
+// with a constant first, a zero operand would wipe out the other
+constexpr std::uint64_t fold_multiply(std::uint64_t a, std::uint64_t b) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+    __extension__ using uint128 = unsigned __int128;
+    const uint128 product = uint128{a} * b;
+    return static_cast<std::uint64_t>(product) ^ static_cast<std::uint64_t>(product >> 64);
+#elif defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+    if !consteval
+    {
+        std::uint64_t high = 0;
+        const std::uint64_t low = _umul128(a, b, &high);
+        return low ^ high;
+    }
+    return fold_multiply_portable(a, b);
+#elif defined(_MSC_VER) && !defined(__clang__) && defined(_M_ARM64)
+    if !consteval
+    {
+        return (a * b) ^ __umulh(a, b);
+    }
+    return fold_multiply_portable(a, b);
+#else
+    return fold_multiply_portable(a, b);
+#endif
+}
+
+// folds one more 64-bit word into the running hash, order matters
+constexpr std::uint64_t hash_word(std::uint64_t hash, std::uint64_t word) noexcept
+{
+    return fold_multiply(hash ^ hash_k0, word ^ hash_k1);
+}
+
+template <typename Word>
+Word load(const unsigned char* bytes) noexcept
+{
+    Word word;
+    std::memcpy(&word, bytes, sizeof(Word));
+    return word;
+}
+
+// 16 bytes per multiply. the last 16 (or fewer) are read as two overlapping words, so there is no byte loop, and the
+// length goes in last so that inputs differing only in trailing zeros hash apart
+inline std::uint64_t hash_bytes(std::uint64_t hash, const void* data, std::size_t size) noexcept
+{
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    const std::uint64_t length = size;
+    std::uint64_t a = 0;
+    std::uint64_t b = 0;
+    if (size > 16)
+    {
+        for (; size > 16; bytes += 16, size -= 16)
+        {
+            hash = fold_multiply(load<std::uint64_t>(bytes) ^ hash_k1, load<std::uint64_t>(bytes + 8) ^ hash ^ hash_k0);
+        }
+        a = load<std::uint64_t>(bytes + size - 16);
+        b = load<std::uint64_t>(bytes + size - 8);
+    }
+    else if (size >= 8)
+    {
+        a = load<std::uint64_t>(bytes);
+        b = load<std::uint64_t>(bytes + size - 8);
+    }
+    else if (size >= 4)
+    {
+        a = load<std::uint32_t>(bytes);
+        b = load<std::uint32_t>(bytes + size - 4);
+    }
+    else if (size != 0)
+    {
+        a = std::uint64_t{bytes[0]} << 16 | std::uint64_t{bytes[size / 2]} << 8 | bytes[size - 1];
+    }
+    return fold_multiply(hash_k2 ^ length, fold_multiply(a ^ hash_k1, b ^ hash ^ hash_k0));
+}
+
+template <typename U>
+concept char_string = requires(const U& value) {
+    { std::string_view{value} } -> std::same_as<std::string_view>;
+} && !std::is_pointer_v<std::decay_t<U>>;
+
+// unordered containers iterate equal contents in any order
+template <typename U>
+concept unordered_range = std::ranges::input_range<U> && requires { typename U::hasher; };
+
+template <typename U>
+concept optional_like = requires(const U& value) {
+    { value.has_value() } -> std::same_as<bool>;
+    *value;
+};
+
+template <typename U>
+concept pair_like = requires(const U& value) {
+    value.first;
+    value.second;
+};
+
+template <typename U>
+std::uint64_t hash_value(std::uint64_t hash, const U& value) noexcept;
+
+template <typename U>
+std::uint64_t hash_range(std::uint64_t hash, const U& range) noexcept
+{
+    using element_type = std::ranges::range_value_t<U>;
+    if constexpr (std::ranges::contiguous_range<U> && std::ranges::sized_range<U> && is_bitwise_comparable<element_type>)
+    {
+        return hash_bytes(hash, std::ranges::data(range), std::ranges::size(range) * sizeof(element_type));
+    }
+    else if constexpr (unordered_range<U>)
+    {
+        // a sum of independently hashed elements does not depend on their order
+        std::uint64_t sum = 0;
+        std::uint64_t count = 0;
+        for (const auto& element : range)
+        {
+            sum += hash_value(0, element);
+            ++count;
+        }
+        return hash_word(hash_word(hash, count), sum);
+    }
+    else
+    {
+        std::uint64_t count = 0;
+        for (const auto& element : range)
+        {
+            hash = hash_value(hash, element);
+            ++count;
+        }
+        return hash_word(hash, count);
+    }
+}
+
+template <typename U>
+std::uint64_t hash_value(std::uint64_t hash, const U& value) noexcept
+{
+    if constexpr (is_bitwise_comparable<U>)
+    {
+        if constexpr (sizeof(U) <= 8)
+        {
+            std::uint64_t word = 0;
+            std::memcpy(&word, std::addressof(value), sizeof(U));
+            return hash_word(hash, word);
+        }
+        else
+        {
+            return hash_bytes(hash, std::addressof(value), sizeof(U));
+        }
+    }
+    else if constexpr (std::is_floating_point_v<U> && sizeof(U) <= 8)
+    {
+        // 0.0 and -0.0 compare equal, so they have to hash alike
+        std::uint64_t word = 0;
+        const U normalized = value == U{} ? U{} : value;
+        std::memcpy(&word, &normalized, sizeof(U));
+        return hash_word(hash, word);
+    }
+    else if constexpr (char_string<U>)
+    {
+        const std::string_view str{value};
+        return hash_bytes(hash, str.data(), str.size());
+    }
+    else if constexpr (concepts::reflectable<U>)
+    {
+        return hash_word(hash, ::krrs::reflect::hash<U>{}(value));
+    }
+    else if constexpr (optional_like<U>)
+    {
+        return value.has_value() ? hash_value(hash_word(hash, 1), *value) : hash_word(hash, 0);
+    }
+    else if constexpr (pair_like<U>)
+    {
+        return hash_value(hash_value(hash, value.first), value.second);
+    }
+    else if constexpr (std::ranges::input_range<U>)
+    {
+        return hash_range(hash, value);
+    }
+    else
+    {
+        static_assert(requires { std::hash<U>{}(value); }, "member type has no hash, reflect it or specialize std::hash!");
+        return hash_word(hash, std::hash<U>{}(value));
+    }
+}
+
+} // namespace detail
+
+// hashes the reflected members of T in for_each order, base classes included, e.g.
+// std::unordered_map<risk_key, double, krrs::reflect::hash<risk_key>>. runs of integer and enum members with no
+// padding between them are hashed as one block of bytes, strings and containers with a 64-bit hash over their
+// contents. values equal under memberwise == hash alike. the value is not stable across builds
+template <concepts::reflectable T>
+struct hash
+{
+    std::size_t operator()(const T& value) const noexcept
+    {
+        std::uint64_t out = 0;
+        for_each<T>([&value, &out]<typename Descriptor>() {
+            constexpr detail::member_run run = detail::member_runs<T>()[descriptor_index<T, Descriptor>()];
+            if constexpr (run.how == detail::member_run::block)
+            {
+                out = detail::hash_bytes(out, std::addressof(get_member_variable<Descriptor>(value)), run.bytes);
+            }
+            else if constexpr (run.how == detail::member_run::single)
+            {
+                out = detail::hash_value(out, get_member_variable<Descriptor>(value));
+            }
+        });
+        return out;
+    }
+};
+
+} // namespace krrs::reflect
@@ -0,0 +1,251 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "concepts.hpp"
+#include "element_proxy.hpp"
+#include "reflect.hpp"
+
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace krrs::reflect {
+
+namespace detail {
+
+template <typename Descriptor, temperature Temperature>
+consteval bool stored_with()
+{
+    return !std::is_function_v<typename Descriptor::member_type> && temperature_of<Descriptor> == Temperature;
+}
+
+// positions in generate_meta_info<T>() of the data members declared with Temperature
+template <concepts::reflectable T, temperature Temperature>
+consteval auto members_with()
+{
+    constexpr std::size_t count = [] {
+        std::size_t n = 0;
+        for_each<T>([&n]<typename Descriptor>() {
+            if constexpr (stored_with<Descriptor, Temperature>())
+            {
+                ++n;
+            }
+        });
+        return n;
+    }();
+
+    std::array<std::size_t, count> out{};
+    std::size_t found = 0;
+    std::size_t index = 0;
+    for_each<T>([&out, &found, &index]<typename Descriptor>() {
+        if constexpr (stored_with<Descriptor, Temperature>())
+        {
+            out[found++] = index;
+        }
+        ++index;
+    });
+    return out;
+}
+
+template <concepts::reflectable T, temperature Temperature, std::size_t... Is>
+auto make_temperature_row(std::index_sequence<Is...>)
+    -> std::tuple<typename meta_type_underlying_type<generate_meta_info<T>()[members_with<T, Temperature>()[Is]]>::member_type...>;
+
+// the members of T declared with Temperature, packed together in declaration order
+template <concepts::reflectable T, temperature Temperature>
+using temperature_row = decltype(make_temperature_row<T, Temperature>(std::make_index_sequence<members_with<T, Temperature>().size()>{}));
+
+// the members of value declared with Temperature, copied into a row
+template <concepts::reflectable T, temperature Temperature, std::size_t... Is>
+temperature_row<T, Temperature> make_row(const T& value, std::index_sequence<Is...>)
+{
+    constexpr auto members = members_with<T, Temperature>();
+    return {get_member_variable<meta_type_underlying_type<generate_meta_info<T>()[members[Is]]>>(value)...};
+}
+
+// where Descriptor sits within its row
+template <concepts::reflectable T, typename Descriptor>
+consteval std::size_t row_position()
+{
+    constexpr auto members = members_with<T, temperature_of<Descriptor>>();
+    constexpr std::size_t index = descriptor_index<T, Descriptor>();
+    for (std::size_t i = 0; i != members.size(); ++i)
+    {
+        if (members[i] == index)
+        {
+            return i;
+        }
+    }
+    return members.size();
+}
+
+} // namespace detail
+
+// a sequence of T split by member temperature: the hot members of every element sit together in one dense array,
+// the cold ones in a side array indexed by the same position, so a loop over hot members never pulls cold bytes
+// into the cache. elements are reached through proxies that get_member_variable reads like a T&
+template <concepts::reflectable T>
+class hot_cold_vector
+{
+    template <typename, bool>
+    friend class detail::element_reference;
+
+    using hot_row = detail::temperature_row<T, temperature::hot>;
+    using cold_row = detail::temperature_row<T, temperature::cold>;
+    static constexpr bool has_cold = std::tuple_size_v<cold_row> != 0;
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = detail::element_reference<hot_cold_vector, false>;
+    using const_reference = detail::element_reference<hot_cold_vector, true>;
+    using iterator = detail::element_iterator<hot_cold_vector, false>;
+    using const_iterator = detail::element_iterator<hot_cold_vector, true>;
+
+    // bytes a loop over the hot members strides through per element
+    static constexpr std::size_t hot_row_size = sizeof(hot_row);
+
+    // both rows are copied out of value before either array grows, so a member that fails to copy leaves the vector
+    // as it was
+    void push_back(const T& value)
+    {
+        hot_row hot = copy_row<temperature::hot>(value);
+        if constexpr (has_cold)
+        {
+            cold_row cold = copy_row<temperature::cold>(value);
+            hot_.push_back(std::move(hot));
+            try
+            {
+                cold_.push_back(std::move(cold));
+            }
+            catch (...)
+            {
+                hot_.pop_back();
+                throw;
+            }
+        }
+        else
+        {
+            hot_.push_back(std::move(hot));
+        }
+    }
+
+    void pop_back() noexcept
+    {
+        hot_.pop_back();
+        if constexpr (has_cold)
+        {
+            cold_.pop_back();
+        }
+    }
+
+    void reserve(std::size_t capacity)
+    {
+        hot_.reserve(capacity);
+        if constexpr (has_cold)
+        {
+            cold_.reserve(capacity);
+        }
+    }
+
+    // new elements have every member value-initialized. if growing the cold array throws, the hot one is cut back
+    void resize(std::size_t size)
+    {
+        const std::size_t old_size = hot_.size();
+        hot_.resize(size);
+        if constexpr (has_cold)
+        {
+            try
+            {
+                cold_.resize(size);
+            }
+            catch (...)
+            {
+                hot_.erase(hot_.begin() + static_cast<std::ptrdiff_t>(old_size), hot_.end());
+                throw;
+            }
+        }
+    }
+
+    void clear() noexcept
+    {
+        hot_.clear();
+        cold_.clear();
+    }
+
+    std::size_t size() const noexcept
+    {
+        return hot_.size();
+    }
+
+    bool empty() const noexcept
+    {
+        return hot_.empty();
+    }
+
+    reference operator[](std::size_t index) noexcept
+    {
+        return {this, index};
+    }
+
+    const_reference operator[](std::size_t index) const noexcept
+    {
+        return {this, index};
+    }
+
+    iterator begin() noexcept
+    {
+        return {this, 0};
+    }
+
+    iterator end() noexcept
+    {
+        return {this, size()};
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return {this, 0};
+    }
+
+    const_iterator end() const noexcept
+    {
+        return {this, size()};
+    }
+
+private:
+    template <temperature Temperature>
+    static auto copy_row(const T& value)
+    {
+        return detail::make_row<T, Temperature>(value, std::make_index_sequence<detail::members_with<T, Temperature>().size()>{});
+    }
+
+    template <typename Descriptor>
+    auto& member_at(std::size_t index) noexcept
+    {
+        if constexpr (temperature_of<Descriptor> == temperature::hot)
+        {
+            return std::get<detail::row_position<T, Descriptor>()>(hot_[index]);
+        }
+        else
+        {
+            return std::get<detail::row_position<T, Descriptor>()>(cold_[index]);
+        }
+    }
+
+    template <typename Descriptor>
+    const auto& member_at(std::size_t index) const noexcept
+    {
+        return const_cast<hot_cold_vector*>(this)->member_at<Descriptor>(index);
+    }
+
+    std::vector<hot_row> hot_;
+    std::vector<cold_row> cold_;
+};
+
+} // namespace krrs::reflect
@@ -0,0 +1,96 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "concepts.hpp"
+#include "reflect.hpp"
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+namespace krrs::reflect {
+
+namespace concepts {
+
+// a key format describes how a codec spells a member key, separators included. e.g. for json: `, "name": `
+// token_size and write_token must agree with each other, and are only ever evaluated at compile time
+template <typename KeyFormat>
+concept key_format = requires(char* out, std::string_view name, std::size_t index) {
+    { KeyFormat::token_size(name, index) } -> std::same_as<std::size_t>;
+    { KeyFormat::write_token(out, name, index) } -> std::same_as<char*>;
+};
+
+} // namespace concepts
+
+namespace detail {
+
+template <std::size_t Size, std::size_t Count>
+struct key_table_storage
+{
+    std::array<char, Size> chars;
+    std::array<std::size_t, Count + 1> offsets;
+};
+
+template <concepts::reflectable T, concepts::key_format KeyFormat>
+consteval std::size_t key_table_size()
+{
+    constexpr auto names = generate_member_names<T>();
+    std::size_t size = 0;
+    for (std::size_t i = 0; i != names.size(); ++i)
+    {
+        size += KeyFormat::token_size(names[i], i);
+    }
+    return size;
+}
+
+template <concepts::reflectable T, concepts::key_format KeyFormat>
+consteval auto build_key_table()
+{
+    constexpr auto names = generate_member_names<T>();
+    key_table_storage<key_table_size<T, KeyFormat>(), names.size()> table{};
+    char* out = table.chars.data();
+    for (std::size_t i = 0; i != names.size(); ++i)
+    {
+        table.offsets[i] = static_cast<std::size_t>(out - table.chars.data());
+        char* const end = KeyFormat::write_token(out, names[i], i);
+        if (static_cast<std::size_t>(end - out) != KeyFormat::token_size(names[i], i))
+        {
+            throw "KeyFormat::write_token disagrees with KeyFormat::token_size!";
+        }
+        out = end;
+    }
+    table.offsets[names.size()] = static_cast<std::size_t>(out - table.chars.data());
+    return table;
+}
+
+} // namespace detail
+
+// per-type table of pre-rendered member keys. every token is laid out back to back in a single static buffer,
+// so emitting a key is a fixed-size copy out of read-only memory instead of quoting / formatting the name at runtime.
+template <concepts::reflectable T, concepts::key_format KeyFormat>
+class key_table
+{
+    static constexpr auto table = detail::build_key_table<T, KeyFormat>();
+
+public:
+    static constexpr std::size_t size = table.offsets.size() - 1;
+
+    template <std::size_t I>
+        requires(I < size)
+    static constexpr std::string_view token() noexcept
+    {
+        return std::string_view{table.chars.data() + table.offsets[I], table.offsets[I + 1] - table.offsets[I]};
+    }
+
+    template <concepts::descriptor_like Descriptor>
+    static constexpr std::string_view token() noexcept
+    {
+        constexpr std::size_t index = descriptor_index<T, Descriptor>();
+        static_assert(index != size, "Descriptor is not part of T!");
+        return token<index>();
+    }
+};
+
+} // namespace krrs::reflect
@@ -0,0 +1,298 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "concepts.hpp"
+#include "reflect.hpp"
+#include "utility.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace krrs::reflect {
+
+// line size the straddle report assumes
+inline constexpr std::size_t cache_line_size = 64;
+
+struct member_layout
+{
+    std::string_view name;
+    std::size_t offset = 0;
+    std::size_t size = 0;
+    std::size_t alignment = 0;
+    // bytes between the end of the member and the next member, or the end of the object
+    std::size_t padding = 0;
+    // the member spans two cache lines when the object starts on a line
+    bool straddles_cache_line = false;
+};
+
+namespace detail {
+
+template <concepts::reflectable T>
+consteval std::size_t data_member_count()
+{
+    std::size_t count = 0;
+    for_each<T>([&count]<typename Descriptor>() {
+        if constexpr (!std::is_function_v<typename Descriptor::member_type>)
+        {
+            ++count;
+        }
+    });
+    return count;
+}
+
+constexpr std::size_t align_up(std::size_t value, std::size_t alignment) noexcept
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// data members in declaration order, base classes first, with padding left unset
+template <concepts::reflectable T>
+consteval auto declared_layout()
+{
+    std::array<member_layout, data_member_count<T>()> members{};
+    std::size_t index = 0;
+    for_each<T>([&members, &index]<typename Descriptor>() {
+        using member_type = typename Descriptor::member_type;
+        if constexpr (!std::is_function_v<member_type>)
+        {
+            static_assert(requires { Descriptor::template offset_in<T>(); }, "descriptor has no offset, declare the members with REFLECT!");
+            member_layout& member = members[index++];
+            member.name = Descriptor::name;
+            member.offset = Descriptor::template offset_in<T>();
+            member.size = sizeof(member_type);
+            member.alignment = alignof(member_type);
+            member.straddles_cache_line = member.offset / cache_line_size != (member.offset + member.size - 1) / cache_line_size;
+        }
+    });
+    return members;
+}
+
+template <concepts::reflectable T>
+consteval auto memory_layout()
+{
+    auto members = declared_layout<T>();
+    std::ranges::sort(members, {}, &member_layout::offset);
+    for (std::size_t i = 0; i != members.size(); ++i)
+    {
+        const std::size_t next = i + 1 == members.size() ? sizeof(T) : members[i + 1].offset;
+        members[i].padding = next - (members[i].offset + members[i].size);
+    }
+    return members;
+}
+
+// widest alignment first and larger members first within one alignment leaves no gap between members, since a size
+// is always a multiple of its alignment. ties keep declaration order
+template <concepts::reflectable T>
+consteval auto packed_layout()
+{
+    auto members = declared_layout<T>();
+    // insertion sort, std::stable_sort is not constexpr
+    for (std::size_t i = 1; i < members.size(); ++i)
+    {
+        for (std::size_t j = i; j != 0 && std::pair{members[j].alignment, members[j].size} > std::pair{members[j - 1].alignment, members[j - 1].size}; --j)
+        {
+            std::swap(members[j], members[j - 1]);
+        }
+    }
+    std::size_t offset = 0;
+    for (member_layout& member : members)
+    {
+        member.offset = align_up(offset, member.alignment);
+        offset = member.offset + member.size;
+    }
+    return members;
+}
+
+} // namespace detail
+
+// where the reflected data members of T sit in memory and what reordering them would save, all at compile time,
+// e.g. static_assert(layout_info<quote>::bytes_wasted == 0). base class members count as members of T, the suggested
+// order ignores that they cannot move out of their base. bytes of unreflected members count as wasted
+template <concepts::reflectable T>
+struct layout_info
+{
+    static constexpr std::size_t size = sizeof(T);
+    static constexpr std::size_t alignment = alignof(T);
+
+    // in the order they sit in memory
+    static constexpr auto members = detail::memory_layout<T>();
+
+    // bytes of T not taken by a reflected member, including any before the first, e.g. a vtable pointer
+    static constexpr std::size_t bytes_wasted = [] {
+        std::size_t used = 0;
+        for (const member_layout& member : members)
+        {
+            used += member.size;
+        }
+        return size - used;
+    }();
+
+    // member names in the order that minimizes sizeof(T)
+    static constexpr auto suggested_order = [] {
+        constexpr auto packed = detail::packed_layout<T>();
+        std::array<std::string_view, packed.size()> names{};
+        std::ranges::transform(packed, names.begin(), &member_layout::name);
+        return names;
+    }();
+
+    // sizeof(T) with its members in suggested_order
+    static constexpr std::size_t suggested_size = [] {
+        constexpr auto packed = detail::packed_layout<T>();
+        return packed.empty() ? size : detail::align_up(packed.back().offset + packed.back().size, alignment);
+    }();
+
+    static constexpr std::size_t bytes_saved_by_reordering = suggested_size < size ? size - suggested_size : 0;
+
+    static constexpr std::size_t cache_line_straddles = static_cast<std::size_t>(std::ranges::count(members, true, &member_layout::straddles_cache_line));
+
+    // a table of members, one line each, for test failures and audits
+    static std::string report()
+    {
+        std::ostringstream oss;
+        oss << utility::get_short_name<T>() << ": " << size << " bytes, " << bytes_wasted << " wasted";
+        if (bytes_saved_by_reordering != 0)
+        {
+            oss << ", " << suggested_size << " in the suggested order";
+            const char* delimiter = " (";
+            for (const std::string_view name : suggested_order)
+            {
+                oss << std::exchange(delimiter, ", ") << name;
+            }
+            oss << ')';
+        }
+        oss << "\n  offset  size  align  padding  member";
+        for (const member_layout& member : members)
+        {
+            oss << '\n' << std::setw(8) << member.offset << std::setw(6) << member.size << std::setw(7) << member.alignment << std::setw(9) << member.padding << "  "
+                << member.name;
+            if (member.straddles_cache_line)
+            {
+                oss << " (straddles a cache line)";
+            }
+        }
+        return oss.str();
+    }
+};
+
+namespace detail {
+
+template <typename U>
+consteval bool bitwise_comparable();
+
+} // namespace detail
+
+// U compares equal exactly when its bytes do: integers, enums, arrays of them and reflected types made only of them
+// with no padding. floats are not (0.0 == -0.0), nor are pointers, which may stand for the string they point to
+template <typename U>
+inline constexpr bool is_bitwise_comparable = detail::bitwise_comparable<std::remove_cv_t<U>>();
+
+namespace detail {
+
+template <typename U>
+consteval bool bitwise_comparable()
+{
+    if constexpr (std::is_integral_v<U> || std::is_enum_v<U>)
+    {
+        return std::has_unique_object_representations_v<U>;
+    }
+    else if constexpr (std::is_array_v<U>)
+    {
+        return is_bitwise_comparable<std::remove_extent_t<U>>;
+    }
+    else if constexpr (concepts::same_as_array_type<U>)
+    {
+        return is_bitwise_comparable<typename U::value_type> && sizeof(U) == sizeof(typename U::value_type) * std::tuple_size_v<U>;
+    }
+    else if constexpr (concepts::reflectable<U>)
+    {
+        if constexpr (!std::is_trivially_copyable_v<U> || layout_info<U>::bytes_wasted != 0)
+        {
+            return false;
+        }
+        else
+        {
+            bool bitwise = true;
+            for_each<U>([&bitwise]<typename Descriptor>() {
+                if constexpr (!std::is_function_v<typename Descriptor::member_type>)
+                {
+                    bitwise = bitwise && is_bitwise_comparable<typename Descriptor::member_type>;
+                }
+            });
+            return bitwise;
+        }
+    }
+    else
+    {
+        return false;
+    }
+}
+
+// how each entry of generate_meta_info<T>() is read by code that may treat raw bytes as values, e.g. hash and equal:
+// consecutive bitwise comparable members that touch form one block, read at its first member. member functions
+// are none
+struct member_run
+{
+    enum kind : std::uint8_t
+    {
+        none,
+        single,
+        block,
+        in_block,
+    };
+
+    kind how = none;
+    // block only, bytes from the first member to the end of the last
+    std::size_t bytes = 0;
+};
+
+template <concepts::reflectable T>
+consteval auto member_runs()
+{
+    std::array<member_run, generate_meta_info<T>().size()> runs{};
+    std::size_t index = 0;
+    // the block being extended and where its bytes end, runs.size() when there is none
+    std::size_t open_block = runs.size();
+    std::size_t block_end = 0;
+    for_each<T>([&]<typename Descriptor>() {
+        using member_type = typename Descriptor::member_type;
+        if constexpr (!std::is_function_v<member_type>)
+        {
+            if constexpr (is_bitwise_comparable<member_type>)
+            {
+                const std::size_t offset = Descriptor::template offset_in<T>();
+                if (open_block != runs.size() && offset == block_end)
+                {
+                    runs[open_block].bytes += sizeof(member_type);
+                    runs[index].how = member_run::in_block;
+                }
+                else
+                {
+                    open_block = index;
+                    runs[index] = {member_run::block, sizeof(member_type)};
+                }
+                block_end = offset + sizeof(member_type);
+            }
+            else
+            {
+                open_block = runs.size();
+                runs[index].how = member_run::single;
+            }
+        }
+        ++index;
+    });
+    return runs;
+}
+
+} // namespace detail
+
+} // namespace krrs::reflect
@@ -0,0 +1,100 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <array>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// shared number <-> text kernel for every codec. formatting is std::to_chars based: shortest round-trip by default
+// (the fewest digits that parse back to the exact same value), or fixed notation with a given number of decimals
+namespace krrs::reflect::numeric {
+
+// precision meaning the shortest round-trip representation
+inline constexpr int shortest = -1;
+
+// arithmetic types that are formatted as numbers. bool and the character types have their own textual forms,
+// while (u)int8_t (signed / unsigned char) are numbers
+template <typename T, typename RawT = std::remove_cv_t<T>>
+concept number = (std::integral<RawT> || std::floating_point<RawT>) && !std::same_as<RawT, bool> && !std::same_as<RawT, char>
+                 && !std::same_as<RawT, wchar_t> && !std::same_as<RawT, char8_t> && !std::same_as<RawT, char16_t> && !std::same_as<RawT, char32_t>;
+
+// enough for any integer, and for the shortest representation of any floating point value
+inline constexpr std::size_t max_shortest_chars = 64;
+
+// writes value into [first, last). returns one past the last character written, or nullptr if it does not fit.
+// precision only applies to floating point values
+template <number T>
+char* format_to(char* first, char* last, T value, int precision = shortest) noexcept
+{
+    std::to_chars_result result{};
+    if constexpr (std::floating_point<T>)
+    {
+        result = precision == shortest ? std::to_chars(first, last, value) : std::to_chars(first, last, value, std::chars_format::fixed, precision);
+    }
+    else
+    {
+        result = std::to_chars(first, last, value);
+    }
+    return result.ec == std::errc{} ? result.ptr : nullptr;
+}
+
+// appends value to out
+template <number T>
+void append(std::string& out, T value, int precision = shortest)
+{
+    std::array<char, max_shortest_chars> chars;
+    if (const char* end = format_to(chars.data(), chars.data() + chars.size(), value, precision))
+    {
+        out.append(chars.data(), static_cast<std::size_t>(end - chars.data()));
+        return;
+    }
+
+    // only fixed notation of a large value gets here, format straight into the string instead
+    const std::size_t size = out.size();
+    out.resize(size + static_cast<std::size_t>(std::numeric_limits<T>::max_exponent10 + precision) + 4);
+    const char* end = format_to(out.data() + size, out.data() + out.size(), value, precision);
+    out.resize(static_cast<std::size_t>(end - out.data()));
+}
+
+template <number T>
+std::string to_string(T value, int precision = shortest)
+{
+    std::string out;
+    append(out, value, precision);
+    return out;
+}
+
+// parses the whole of text, nullopt if it is not exactly one number of type T (e.g. "3.5" for an int, or out of range).
+// a leading '+' is accepted, std::from_chars alone rejects it
+template <number T>
+std::optional<T> parse(std::string_view text) noexcept
+{
+    if (text.starts_with('+') && !text.substr(1).starts_with('-'))
+    {
+        text.remove_prefix(1);
+    }
+
+    if (text.empty())
+    {
+        return std::nullopt;
+    }
+
+    T value{};
+    const char* last = text.data() + text.size();
+    const auto [ptr, ec] = std::from_chars(text.data(), last, value);
+    if (ec != std::errc{} || ptr != last)
+    {
+        return std::nullopt;
+    }
+    return value;
+}
+
+} // namespace krrs::reflect::numeric
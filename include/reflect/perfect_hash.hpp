@@ -0,0 +1,190 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "concepts.hpp"
+#include "reflect.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+
+namespace krrs::reflect {
+
+namespace detail {
+
+// fnv-1a, computed once per lookup. every probe afterwards only remixes this value
+constexpr std::uint64_t perfect_hash_key(std::string_view key) noexcept
+{
+    std::uint64_t hash = 14695981039346656037ull;
+    for (char c : key)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+constexpr std::uint64_t perfect_hash_mix(std::uint64_t hash, std::uint64_t seed) noexcept
+{
+    hash ^= (seed + 1) * 0x9E3779B97F4A7C15ull;
+    hash ^= hash >> 31;
+    hash *= 0xBF58476D1CE4E5B9ull;
+    hash ^= hash >> 29;
+    return hash;
+}
+
+} // namespace detail
+
+// minimal collision-free table from a fixed set of names to their index (hash-and-displace).
+// a key is first hashed into a bucket, and every bucket stores the seed that spreads its keys into free slots.
+// a lookup is therefore one hash of the key, two remixes and a single string compare, regardless of the number of names.
+template <std::size_t N>
+struct perfect_hash_table
+{
+    static constexpr std::size_t npos = N;
+    static constexpr std::size_t bucket_count = std::bit_ceil(std::max<std::size_t>(N / 2, 1));
+    static constexpr std::size_t slot_count = std::bit_ceil(std::max<std::size_t>(N, 1)) * 2;
+
+    // slots store index + 1, 0 marks an empty slot
+    using slot_type = std::conditional_t<(N < std::numeric_limits<std::uint8_t>::max()), std::uint8_t, std::uint16_t>;
+
+    std::array<std::uint16_t, bucket_count> seeds{};
+    std::array<slot_type, slot_count> slots{};
+    std::array<std::string_view, N> names{};
+
+    static constexpr std::size_t bucket_of(std::uint64_t hash) noexcept
+    {
+        // salted outside of the seed range, so that bucket and slot selection stay independent
+        constexpr std::uint64_t bucket_salt = std::numeric_limits<std::uint16_t>::max() + 1ull;
+        return (detail::perfect_hash_mix(hash, bucket_salt) >> 32) & (bucket_count - 1);
+    }
+
+    static constexpr std::size_t slot_of(std::uint64_t hash, std::uint16_t seed) noexcept
+    {
+        return detail::perfect_hash_mix(hash, seed) & (slot_count - 1);
+    }
+
+    // returns the index of key, or npos if it is not one of the names
+    constexpr std::size_t find(std::string_view key) const noexcept
+    {
+        const std::uint64_t hash = detail::perfect_hash_key(key);
+        const slot_type slot = slots[slot_of(hash, seeds[bucket_of(hash)])];
+        if (slot == 0 || names[slot - 1u] != key)
+        {
+            return npos;
+        }
+        return slot - 1u;
+    }
+};
+
+// builds and verifies the table at compile time. duplicated names (e.g. a member hiding a base class member) resolve to the first one
+template <std::size_t N>
+consteval perfect_hash_table<N> make_perfect_hash(const std::array<std::string_view, N>& names)
+{
+    using table_type = perfect_hash_table<N>;
+    table_type table{};
+    table.names = names;
+
+    std::array<std::uint64_t, N> hashes{};
+    std::array<std::size_t, table_type::bucket_count> bucket_sizes{};
+    std::array<bool, N> is_duplicate{};
+    for (std::size_t i = 0; i != N; ++i)
+    {
+        hashes[i] = detail::perfect_hash_key(names[i]);
+        is_duplicate[i] = std::ranges::find(names.begin(), names.begin() + i, names[i]) != names.begin() + i;
+        if (!is_duplicate[i])
+        {
+            ++bucket_sizes[table_type::bucket_of(hashes[i])];
+        }
+    }
+
+    // place the most crowded buckets first while there is still plenty of room
+    std::array<std::size_t, table_type::bucket_count> bucket_order{};
+    for (std::size_t b = 0; b != bucket_order.size(); ++b)
+    {
+        bucket_order[b] = b;
+    }
+    std::ranges::sort(bucket_order, [&bucket_sizes](std::size_t lhs, std::size_t rhs) {
+        return bucket_sizes[lhs] != bucket_sizes[rhs] ? bucket_sizes[lhs] > bucket_sizes[rhs] : lhs < rhs;
+    });
+
+    for (const std::size_t bucket : bucket_order)
+    {
+        if (bucket_sizes[bucket] == 0)
+        {
+            break;
+        }
+
+        bool placed = false;
+        for (std::uint32_t seed = 0; seed <= std::numeric_limits<std::uint16_t>::max() && !placed; ++seed)
+        {
+            std::array<std::size_t, N> claimed{};
+            std::size_t claimed_count = 0;
+            placed = true;
+            for (std::size_t i = 0; i != N && placed; ++i)
+            {
+                if (is_duplicate[i] || table_type::bucket_of(hashes[i]) != bucket)
+                {
+                    continue;
+                }
+
+                const std::size_t slot = table_type::slot_of(hashes[i], static_cast<std::uint16_t>(seed));
+                const bool taken = std::ranges::find(claimed.begin(), claimed.begin() + claimed_count, slot) != claimed.begin() + claimed_count;
+                placed = table.slots[slot] == 0 && !taken;
+                claimed[claimed_count++] = slot;
+            }
+
+            if (placed)
+            {
+                table.seeds[bucket] = static_cast<std::uint16_t>(seed);
+                for (std::size_t i = 0; i != N; ++i)
+                {
+                    if (!is_duplicate[i] && table_type::bucket_of(hashes[i]) == bucket)
+                    {
+                        table.slots[table_type::slot_of(hashes[i], table.seeds[bucket])] = static_cast<typename table_type::slot_type>(i + 1);
+                    }
+                }
+            }
+        }
+
+        if (!placed)
+        {
+            throw "unable to find a collision-free seed for the perfect hash table!";
+        }
+    }
+
+    // every name must resolve back to itself (or to its first occurrence)
+    for (std::size_t i = 0; i != N; ++i)
+    {
+        const std::size_t first = static_cast<std::size_t>(std::ranges::find(names, names[i]) - names.begin());
+        if (table.find(names[i]) != first)
+        {
+            throw "perfect hash table verification failed!";
+        }
+    }
+    return table;
+}
+
+// compile-time table mapping a member name of T to its index in generate_meta_info<T>()
+template <concepts::reflectable T>
+inline constexpr auto member_lookup = make_perfect_hash(generate_member_names<T>());
+
+// one function pointer per member of T, in for_each order. Visitor::template invoke<Descriptor> is instantiated for every
+// descriptor, so a looked up index dispatches straight to the code for that member without walking the others.
+template <concepts::reflectable T, typename Fn, typename Visitor>
+    requires std::is_function_v<Fn>
+consteval auto make_jump_table()
+{
+    return []<std::size_t... Is>(std::index_sequence<Is...>) {
+        return std::array<Fn*, sizeof...(Is)>{&Visitor::template invoke<detail::meta_type_underlying_type<generate_meta_info<T>()[Is]>>...};
+    }(std::make_index_sequence<generate_meta_info<T>().size()>{});
+}
+
+} // namespace krrs::reflect
@@ -13,6 +13,25 @@
 #define PP_STRINGIZE(x) #x
 #define PP_EXPAND(x) x
 
+// paste two tokens after expanding them
+#define PP_CAT(a, b) PP_CAT_IMPL(a, b)
+#define PP_CAT_IMPL(a, b) a##b
+
+// 1 if x is wrapped in parentheses, otherwise 0. e.g. PP_IS_PAREN((hot, price)) -> 1, PP_IS_PAREN(price) -> 0
+#define PP_IS_PAREN(x) PP_EXPAND(PP_IS_PAREN_CHECK(PP_IS_PAREN_PROBE x))
+#define PP_IS_PAREN_PROBE(...) ~, 1,
+#define PP_IS_PAREN_CHECK(...) PP_EXPAND(PP_IS_PAREN_CHECK_N(__VA_ARGS__, 0, ))
+#define PP_IS_PAREN_CHECK_N(x, n, ...) n
+
+// pick t when c is 1, f when c is 0
+#define PP_IF(c, t, f) PP_CAT(PP_IF_, c)(t, f)
+#define PP_IF_1(t, f) t
+#define PP_IF_0(t, f) f
+
+// first / second element of a pair. e.g. PP_SECOND (hot, price) -> price
+#define PP_FIRST(a, b) a
+#define PP_SECOND(a, b) b
+
 // Get N-th argument, up to 128 variables
 #define PP_GET_NTH_ARG(_1,                                                                                                                                     \
                        _2,                                                                                                                                     \
@@ -4,13 +4,16 @@
 #pragma once
 
 #include "concepts.hpp"
+#include "numeric.hpp"
 #include "preprocessor.hpp"
 #include "typelist.hpp"
 #include "utility.hpp"
 
 #include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
-#include <iomanip>
 #include <sstream>
 #include <utility>
 
@@ -116,6 +119,24 @@ consteval auto generate_meta_info()
     return decltype(get_meta_info(detail::meta_id<T::meta_info_array_as_id()>{}))::value;
 }
 
+// returns the name of every reflected member of T (including base classes), in for_each order
+template <concepts::reflectable T>
+consteval auto generate_member_names()
+{
+    return []<std::size_t... Is>(std::index_sequence<Is...>) {
+        return std::array<std::string_view, sizeof...(Is)>{detail::meta_type_underlying_type<generate_meta_info<T>()[Is]>::name...};
+    }(std::make_index_sequence<generate_meta_info<T>().size()>{});
+}
+
+// returns the position of Descriptor within generate_meta_info<T>(), or generate_meta_info<T>().size() if it is not part of T
+template <concepts::reflectable T, concepts::descriptor_like Descriptor>
+consteval std::size_t descriptor_index()
+{
+    constexpr auto descriptor_array = generate_meta_info<T>();
+    const auto iter = std::ranges::find(descriptor_array, detail::meta_type_info<Descriptor>);
+    return static_cast<std::size_t>(iter - std::ranges::begin(descriptor_array));
+}
+
 template <concepts::descriptor_like Descriptor, concepts::reflectable T>
 constexpr decltype(auto) get_member_variable(T&& obj) noexcept
 {
@@ -139,6 +160,14 @@ constexpr decltype(auto) get_member_variable(T&& obj) noexcept
     }
 }
 
+// the member as reached through a proxy, e.g. get_member_variable<Descriptor>(soa[i]), so code written against T& also
+// runs over containers that do not store T whole
+template <concepts::descriptor_like Descriptor, concepts::member_proxy Proxy>
+constexpr decltype(auto) get_member_variable(const Proxy& proxy) noexcept
+{
+    return proxy.template get<Descriptor>();
+}
+
 template <concepts::descriptor_like Descriptor, concepts::reflectable T>
 constexpr decltype(auto) get_member_variable(T&& obj, Descriptor) noexcept
 {
@@ -197,9 +226,59 @@ constexpr void for_each(Functor&& func, std::index_sequence<Is...> = {})
     }
 }
 
+// how often a member is read, declared in REFLECT as (hot, name) or (cold, name). plain names are hot. containers like
+// hot_cold_vector keep hot members packed together and move cold ones out of the way, e.g. rarely read strings
+enum class temperature : std::uint8_t
+{
+    hot,
+    cold,
+};
+
+// the temperature a descriptor was declared with. hot for descriptors written by hand
+template <typename Descriptor>
+inline constexpr temperature temperature_of = temperature::hot;
+
+template <typename Descriptor>
+    requires requires { Descriptor::temperature; }
+inline constexpr temperature temperature_of<Descriptor> = Descriptor::temperature;
+
+// decimals that REFLECT_PRINTABLE prints the floating point members of T with. shortest round-trip by default,
+// specialize it for fixed notation, e.g. template <> inline constexpr int krrs::reflect::print_precision<quote> = 3;
+template <typename T>
+inline constexpr int print_precision = numeric::shortest;
+
+namespace detail {
+
+// numbers go through the shared to_chars kernel, anything else through its operator<<
+template <typename T, typename Value>
+void print_value(std::ostream& os, const Value& value)
+{
+    if constexpr (numeric::number<Value>)
+    {
+        std::array<char, numeric::max_shortest_chars> chars;
+        if (const char* end = numeric::format_to(chars.data(), chars.data() + chars.size(), value, print_precision<T>))
+        {
+            os.write(chars.data(), end - chars.data());
+            return;
+        }
+        os << numeric::to_string(value, print_precision<T>);
+    }
+    else
+    {
+        os << value;
+    }
+}
+
+} // namespace detail
+
 /* ===================================== END OF HELPER FUNCTIONS ===================================== */
+/* A member entry of REFLECT is either the member's name or a (temperature, name) pair, e.g. (cold, notes) */
+#define REFLECT_MEMBER_NAME(Entry) PP_IF(PP_IS_PAREN(Entry), PP_SECOND Entry, Entry)
+#define REFLECT_MEMBER_TEMPERATURE(Entry) PP_IF(PP_IS_PAREN(Entry), PP_FIRST Entry, hot)
+
 /* To be used within REFLECT macro */
-#define GENERATE_DESCRIPTOR(Class, Member)                                                                                                                     \
+#define GENERATE_DESCRIPTOR(Class, Entry) GENERATE_DESCRIPTOR_IMPL(Class, REFLECT_MEMBER_NAME(Entry), REFLECT_MEMBER_TEMPERATURE(Entry))
+#define GENERATE_DESCRIPTOR_IMPL(Class, Member, Temperature)                                                                                                   \
     struct PP_CREATE_CLASS_NAME(descriptor, Class, Member)                                                                                                     \
     {                                                                                                                                                          \
         using introspection_type = ::krrs::reflect::detail::introspection<decltype(&Class::Member)>;                                                           \
@@ -210,10 +289,22 @@ constexpr void for_each(Functor&& func, std::index_sequence<Is...> = {})
         static constexpr std::string_view name = PP_STRINGIZE(Member);                                                                                         \
         static constexpr std::string_view mem_type_str = introspection_type::mem_type_str;                                                                     \
         static constexpr member_pointer_type mem_ptr = &Class::Member;                                                                                         \
+        static constexpr ::krrs::reflect::temperature temperature = ::krrs::reflect::temperature::Temperature;                                                 \
+                                                                                                                                                               \
+        /* offset of the member within Owner, which may be a class derived from Class. qualified, so a member of Owner that */                                 \
+        /* hides this one is not picked up instead. data members only */                                                                                       \
+        template <typename Owner = struct Class>                                                                                                               \
+            requires(!std::is_function_v<member_type>)                                                                                                         \
+        static consteval std::size_t offset_in()                                                                                                               \
+        {                                                                                                                                                      \
+            _Pragma("GCC diagnostic push") _Pragma("GCC diagnostic ignored \"-Winvalid-offsetof\"") return offsetof(Owner, Class::Member);                     \
+            _Pragma("GCC diagnostic pop")                                                                                                                      \
+        }                                                                                                                                                      \
     };
 
 /* To be used within REFLECT macro */
-#define GENERATE_MEMBER_META_INFO(Class, Member) ::krrs::reflect::detail::meta_type_info<PP_CREATE_CLASS_NAME(descriptor, Class, Member)>,
+#define GENERATE_MEMBER_META_INFO(Class, Entry) GENERATE_MEMBER_META_INFO_IMPL(Class, REFLECT_MEMBER_NAME(Entry))
+#define GENERATE_MEMBER_META_INFO_IMPL(Class, Member) ::krrs::reflect::detail::meta_type_info<PP_CREATE_CLASS_NAME(descriptor, Class, Member)>,
 
 /* To be used within REFLECT macro */
 #define GET_META_INFO_ARRAY(_, Base) Base::meta_info_array(),
@@ -235,8 +326,10 @@ constexpr void for_each(Functor&& func, std::index_sequence<Is...> = {})
     }
 
 /* To be used within REFLECT_PRINTABLE macro */
-#define OSTREAM_PRINT(_, value)                                                                                                                                \
-    oss << std::fixed << std::setprecision(3) << std::exchange(delimiter, ", ") << "'" << PP_STRINGIZE(value) << "': " << object.value;
+#define OSTREAM_PRINT(_, Entry) OSTREAM_PRINT_IMPL(_, REFLECT_MEMBER_NAME(Entry))
+#define OSTREAM_PRINT_IMPL(_, value)                                                                                                                           \
+    oss << std::exchange(delimiter, ", ") << "'" << PP_STRINGIZE(value) << "': ";                                                                              \
+    ::krrs::reflect::detail::print_value<std::remove_cvref_t<decltype(object)>>(oss, object.value);
 
 /* To be used within REFLECT_PRINTABLE macro */
 #define OSTREAM_PRINT_BASE(_, Base) oss << to_string(static_cast<Base>(object)) << ", ";
@@ -251,8 +344,8 @@ constexpr void for_each(Functor&& func, std::index_sequence<Is...> = {})
         const char* delimiter = "";                                                                                                                            \
         oss << "struct " << PP_STRINGIZE(Class) << " has the following reflected variables:\n";                                                                \
         ::krrs::reflect::for_each<struct Class>([&oss, &object, &delimiter]<typename Descriptor>() {                                                           \
-            oss << std::exchange(delimiter, "\n") << "  " << Descriptor::mem_type_str << " " << Descriptor::name << " = "                                      \
-                << ::krrs::reflect::get_member_variable<Descriptor>(object);                                                                                   \
+            oss << std::exchange(delimiter, "\n") << "  " << Descriptor::mem_type_str << " " << Descriptor::name << " = ";                                     \
+            ::krrs::reflect::detail::print_value<struct Class>(oss, ::krrs::reflect::get_member_variable<Descriptor>(object));                                 \
         });                                                                                                                                                    \
         return oss.str();                                                                                                                                      \
     }                                                                                                                                                          \
@@ -0,0 +1,110 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "concepts.hpp"
+#include "reflect.hpp"
+#include "utility.hpp"
+
+#include <concepts>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+namespace krrs::reflect {
+
+namespace detail {
+
+inline constexpr std::uint64_t fnv_offset_basis = 14695981039346656037ull;
+inline constexpr std::uint64_t fnv_prime = 1099511628211ull;
+
+constexpr std::uint64_t fnv1a(std::uint64_t hash, std::uint64_t value) noexcept
+{
+    for (int i = 0; i != 8; ++i)
+    {
+        hash ^= (value >> (i * 8)) & 0xFF;
+        hash *= fnv_prime;
+    }
+    return hash;
+}
+
+// the length goes in first, so ("ab", "c") and ("a", "bc") do not collide
+constexpr std::uint64_t fnv1a(std::uint64_t hash, std::string_view str) noexcept
+{
+    hash = fnv1a(hash, std::uint64_t{str.size()});
+    for (const char c : str)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= fnv_prime;
+    }
+    return hash;
+}
+
+template <typename T, typename... Visiting>
+consteval std::uint64_t nested_schema_hash();
+
+// Visiting holds the reflected types whose members are being hashed, outermost last
+template <concepts::reflectable T, typename... Visiting>
+consteval std::uint64_t members_schema_hash()
+{
+    std::uint64_t hash = fnv_offset_basis;
+    for_each<T>([&hash]<typename Descriptor>() {
+        hash = fnv1a(hash, utility::get_short_name<typename Descriptor::class_type>());
+        hash = fnv1a(hash, Descriptor::name);
+        hash = fnv1a(hash, Descriptor::mem_type_str);
+        hash = fnv1a(hash, nested_schema_hash<typename Descriptor::member_type, T, Visiting...>());
+    });
+    return hash;
+}
+
+} // namespace detail
+
+// fingerprint of T's layout as the codecs see it: every member's name, type and declaring class (so base classes
+// count), in for_each order, with reflected member types (also inside containers) folded in recursively. a type
+// reached again from inside itself, e.g. struct node { std::vector<node> children; }, is folded in by name only.
+// classes are identified by their name without namespaces. type names come from the compiler, so the value is
+// only comparable between builds with the same toolchain
+template <concepts::reflectable T>
+consteval std::uint64_t schema_hash()
+{
+    return detail::members_schema_hash<T>();
+}
+
+namespace detail {
+
+// reflected types reachable through T, 0 when there are none
+template <typename T, typename... Visiting>
+consteval std::uint64_t nested_schema_hash()
+{
+    if constexpr (concepts::reflectable<T>)
+    {
+        if constexpr ((std::same_as<T, Visiting> || ...))
+        {
+            return fnv1a(fnv_offset_basis, utility::get_short_name<T>());
+        }
+        else
+        {
+            return members_schema_hash<T, Visiting...>();
+        }
+    }
+    else if constexpr (requires {
+                           typename T::first_type;
+                           typename T::second_type;
+                       })
+    {
+        return fnv1a(nested_schema_hash<std::remove_const_t<typename T::first_type>, Visiting...>(), nested_schema_hash<typename T::second_type, Visiting...>());
+    }
+    else if constexpr (requires { typename T::value_type; } && !std::convertible_to<T, std::string_view>)
+    {
+        return nested_schema_hash<typename T::value_type, Visiting...>();
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+} // namespace detail
+
+} // namespace krrs::reflect
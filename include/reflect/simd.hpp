@@ -0,0 +1,53 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define KRRS_SIMD_X86 1
+#include <immintrin.h>
+// per-function instruction set selection, so the binary still runs on cpus without the extension
+#define KRRS_TARGET_AVX2 __attribute__((target("avx2,bmi,bmi2,popcnt")))
+#else
+#define KRRS_SIMD_X86 0
+#endif
+
+namespace krrs::reflect::simd {
+
+// instruction sets the kernels in this library are specialised for, ordered from least to most capable.
+// sse2 is part of the x86-64 baseline, so it never needs a runtime check
+enum class level : std::uint8_t
+{
+    scalar,
+    sse2,
+    avx2,
+};
+
+// the best level supported by the running cpu, detected once
+inline level detected_level() noexcept
+{
+#if KRRS_SIMD_X86
+    static const level detected = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi") && __builtin_cpu_supports("bmi2"))
+        {
+            return level::avx2;
+        }
+        return level::sse2;
+    }();
+    return detected;
+#else
+    return level::scalar;
+#endif
+}
+
+// clamps a requested level to what the running cpu supports
+inline level supported_level(level requested) noexcept
+{
+    const level detected = detected_level();
+    return requested < detected ? requested : detected;
+}
+
+} // namespace krrs::reflect::simd
@@ -0,0 +1,336 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "concepts.hpp"
+#include "element_proxy.hpp"
+#include "reflect.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace krrs::reflect {
+
+namespace detail {
+
+// std::vector<bool> packs bits and has no data(), so bool columns keep one bool per byte in a buffer of their own
+class bool_column
+{
+public:
+    bool* data() noexcept
+    {
+        return data_.get();
+    }
+
+    const bool* data() const noexcept
+    {
+        return data_.get();
+    }
+
+    std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    std::size_t capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    void reserve(std::size_t capacity)
+    {
+        if (capacity > capacity_)
+        {
+            auto grown = std::make_unique_for_overwrite<bool[]>(capacity);
+            std::copy_n(data_.get(), size_, grown.get());
+            data_ = std::move(grown);
+            capacity_ = capacity;
+        }
+    }
+
+    void push_back(bool value)
+    {
+        if (size_ == capacity_)
+        {
+            reserve(std::max<std::size_t>(8, capacity_ * 2));
+        }
+        data_[size_++] = value;
+    }
+
+    void pop_back() noexcept
+    {
+        --size_;
+    }
+
+    void resize(std::size_t size)
+    {
+        reserve(size);
+        std::fill(data_.get() + std::min(size, size_), data_.get() + size, false);
+        size_ = size;
+    }
+
+    void clear() noexcept
+    {
+        size_ = 0;
+    }
+
+    bool_column() = default;
+    bool_column(bool_column&&) noexcept = default;
+    bool_column& operator=(bool_column&&) noexcept = default;
+
+    bool_column(const bool_column& other)
+        : data_{std::make_unique_for_overwrite<bool[]>(other.size_)}
+        , size_{other.size_}
+        , capacity_{other.size_}
+    {
+        std::copy_n(other.data_.get(), size_, data_.get());
+    }
+
+    bool_column& operator=(const bool_column& other)
+    {
+        if (this != &other)
+        {
+            *this = bool_column{other};
+        }
+        return *this;
+    }
+
+private:
+    std::unique_ptr<bool[]> data_;
+    std::size_t size_ = 0;
+    std::size_t capacity_ = 0;
+};
+
+// member functions take a slot so the tuple can be indexed by descriptor_index, but hold nothing
+struct no_column
+{
+};
+
+template <typename Descriptor>
+struct soa_column
+{
+    using type = std::vector<typename Descriptor::member_type>;
+};
+
+template <typename Descriptor>
+    requires std::same_as<typename Descriptor::member_type, bool>
+struct soa_column<Descriptor>
+{
+    using type = bool_column;
+};
+
+template <typename Descriptor>
+    requires std::is_function_v<typename Descriptor::member_type>
+struct soa_column<Descriptor>
+{
+    using type = no_column;
+};
+
+template <concepts::reflectable T, std::size_t... Is>
+auto make_soa_columns(std::index_sequence<Is...>) -> std::tuple<typename soa_column<meta_type_underlying_type<generate_meta_info<T>()[Is]>>::type...>;
+
+template <concepts::reflectable T>
+using soa_columns = decltype(make_soa_columns<T>(std::make_index_sequence<generate_meta_info<T>().size()>{}));
+
+} // namespace detail
+
+// a sequence of T stored as one contiguous array per reflected member, so a loop over one or two members of many
+// objects reads only those members' bytes. member functions take no storage. elements are reached through proxies,
+// e.g. v[i].get<&T::price>(), or whole members at once through column<&T::price>()
+template <concepts::reflectable T>
+class soa_vector
+{
+    template <typename, bool>
+    friend class detail::element_reference;
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = detail::element_reference<soa_vector, false>;
+    using const_reference = detail::element_reference<soa_vector, true>;
+    using iterator = detail::element_iterator<soa_vector, false>;
+    using const_iterator = detail::element_iterator<soa_vector, true>;
+
+    soa_vector() = default;
+
+    // if a member fails to copy, the columns it already reached are cut back and the vector is left as it was
+    void push_back(const T& value)
+    {
+        try
+        {
+            for_each<T>([this, &value]<typename Descriptor>() {
+                if constexpr (!std::is_function_v<typename Descriptor::member_type>)
+                {
+                    column_of<Descriptor>().push_back(get_member_variable<Descriptor>(value));
+                }
+            });
+        }
+        catch (...)
+        {
+            truncate_columns();
+            throw;
+        }
+        ++size_;
+    }
+
+    void pop_back() noexcept
+    {
+        for_each<T>([this]<typename Descriptor>() {
+            if constexpr (!std::is_function_v<typename Descriptor::member_type>)
+            {
+                column_of<Descriptor>().pop_back();
+            }
+        });
+        --size_;
+    }
+
+    void reserve(std::size_t capacity)
+    {
+        for_each<T>([this, capacity]<typename Descriptor>() {
+            if constexpr (!std::is_function_v<typename Descriptor::member_type>)
+            {
+                column_of<Descriptor>().reserve(capacity);
+            }
+        });
+    }
+
+    // new elements have every member value-initialized. if growing a column throws, the vector is left as it was
+    void resize(std::size_t size)
+    {
+        try
+        {
+            for_each<T>([this, size]<typename Descriptor>() {
+                if constexpr (!std::is_function_v<typename Descriptor::member_type>)
+                {
+                    column_of<Descriptor>().resize(size);
+                }
+            });
+        }
+        catch (...)
+        {
+            truncate_columns();
+            throw;
+        }
+        size_ = size;
+    }
+
+    void clear() noexcept
+    {
+        for_each<T>([this]<typename Descriptor>() {
+            if constexpr (!std::is_function_v<typename Descriptor::member_type>)
+            {
+                column_of<Descriptor>().clear();
+            }
+        });
+        size_ = 0;
+    }
+
+    std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    reference operator[](std::size_t index) noexcept
+    {
+        return {this, index};
+    }
+
+    const_reference operator[](std::size_t index) const noexcept
+    {
+        return {this, index};
+    }
+
+    // every value of one member, in element order. MemberPtr may name a member of a base class
+    template <auto MemberPtr>
+    auto column() noexcept
+    {
+        using descriptor = detail::descriptor_for<T, MemberPtr>;
+        static_assert(!std::is_function_v<typename descriptor::member_type>, "member functions have no column!");
+        return std::span<typename descriptor::member_type>{column_of<descriptor>().data(), size_};
+    }
+
+    template <auto MemberPtr>
+    auto column() const noexcept
+    {
+        using descriptor = detail::descriptor_for<T, MemberPtr>;
+        static_assert(!std::is_function_v<typename descriptor::member_type>, "member functions have no column!");
+        return std::span<const typename descriptor::member_type>{column_of<descriptor>().data(), size_};
+    }
+
+    iterator begin() noexcept
+    {
+        return {this, 0};
+    }
+
+    iterator end() noexcept
+    {
+        return {this, size_};
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return {this, 0};
+    }
+
+    const_iterator end() const noexcept
+    {
+        return {this, size_};
+    }
+
+private:
+    // drops whatever a failed push_back or resize appended past size_, so element i sits at index i in every column
+    void truncate_columns() noexcept
+    {
+        for_each<T>([this]<typename Descriptor>() {
+            if constexpr (!std::is_function_v<typename Descriptor::member_type>)
+            {
+                auto& column = column_of<Descriptor>();
+                while (column.size() > size_)
+                {
+                    column.pop_back();
+                }
+            }
+        });
+    }
+
+    template <typename Descriptor>
+    auto& member_at(std::size_t index) noexcept
+    {
+        return column_of<Descriptor>().data()[index];
+    }
+
+    template <typename Descriptor>
+    const auto& member_at(std::size_t index) const noexcept
+    {
+        return column_of<Descriptor>().data()[index];
+    }
+
+    template <typename Descriptor>
+    auto& column_of() noexcept
+    {
+        return std::get<descriptor_index<T, Descriptor>()>(columns_);
+    }
+
+    template <typename Descriptor>
+    const auto& column_of() const noexcept
+    {
+        return std::get<descriptor_index<T, Descriptor>()>(columns_);
+    }
+
+    detail::soa_columns<T> columns_;
+    std::size_t size_ = 0;
+};
+
+} // namespace krrs::reflect
@@ -0,0 +1,363 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "../../include/reflect/reflect.hpp"
+#include "../../include/reflect/schema.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <type_traits>
+#include <unistd.h>
+#include <utility>
+
+namespace krrs::storage {
+
+namespace concepts {
+
+namespace detail {
+
+// pointers, including the one inside a string_view, mean nothing once the process that wrote them is gone
+template <typename T>
+consteval bool holds_pointers()
+{
+    if constexpr (std::is_pointer_v<T> || std::is_member_pointer_v<T> || std::same_as<T, std::string_view>)
+    {
+        return true;
+    }
+    else if constexpr (::krrs::reflect::concepts::reflectable<T>)
+    {
+        bool any = false;
+        ::krrs::reflect::for_each<T>([&any]<typename Descriptor>() {
+            if constexpr (!std::is_function_v<typename Descriptor::member_type>)
+            {
+                any = any || holds_pointers<typename Descriptor::member_type>();
+            }
+        });
+        return any;
+    }
+    else if constexpr (::krrs::reflect::concepts::same_as_array_type<T>)
+    {
+        return holds_pointers<typename T::value_type>();
+    }
+    else
+    {
+        return false;
+    }
+}
+
+} // namespace detail
+
+// a reflected type whose bytes can be written to a file and mapped back in as is
+template <typename T>
+concept record = ::krrs::reflect::concepts::reflectable<T> && std::is_trivially_copyable_v<T> && !detail::holds_pointers<T>();
+
+} // namespace concepts
+
+enum class open_mode : std::uint8_t
+{
+    // mapped read-only, the file is never written. opening costs the same regardless of its size
+    read_only,
+    // created if missing, records are appended with push_back
+    read_write,
+};
+
+namespace internal {
+
+// the first bytes of the file. records follow at header_size, so they keep any alignment up to a cache line
+struct file_header
+{
+    // "KRRSMVEC" read as a little-endian word, a host of the other byte order sees another value
+    static constexpr std::uint64_t expected_magic = 0x4345564D5352524BULL;
+
+    std::uint64_t magic;
+    std::uint64_t schema_hash;
+    std::uint64_t record_size;
+    std::uint64_t size;
+};
+
+inline constexpr std::size_t header_size = 64;
+static_assert(sizeof(file_header) <= header_size);
+
+[[noreturn]] inline void throw_errno(std::string_view what, const std::string& path)
+{
+    throw std::runtime_error{std::string{what} + " " + path + ": " + std::strerror(errno)};
+}
+
+} // namespace internal
+
+// an append-only file of fixed-width T records, mapped into memory. the header carries reflect::schema_hash<T>(),
+// so a file written with another layout of T is rejected instead of being misread. reopening read-only maps the file
+// and checks the header, nothing is parsed or copied. not thread-safe, and a file must not be appended to by two
+// mapped_vectors at once
+template <concepts::record T>
+class mapped_vector
+{
+    static_assert(alignof(T) <= internal::header_size, "records are placed right after the 64-byte header");
+
+public:
+    explicit mapped_vector(std::string path, open_mode mode = open_mode::read_write)
+        : path_{std::move(path)}
+        , mode_{mode}
+    {
+        const bool writable = mode_ == open_mode::read_write;
+        fd_ = ::open(path_.c_str(), writable ? O_RDWR | O_CREAT | O_CLOEXEC : O_RDONLY | O_CLOEXEC, 0644);
+        if (fd_ < 0)
+        {
+            internal::throw_errno("failed to open", path_);
+        }
+
+        try
+        {
+            struct stat info{};
+            if (::fstat(fd_, &info) != 0)
+            {
+                internal::throw_errno("failed to stat", path_);
+            }
+            const auto file_size = static_cast<std::size_t>(info.st_size);
+
+            if (file_size == 0 && writable)
+            {
+                // a new file, grown to hold the header and a first batch of records
+                map(initial_capacity);
+                header() = internal::file_header{internal::file_header::expected_magic, ::krrs::reflect::schema_hash<T>(), sizeof(T), 0};
+                return;
+            }
+            if (file_size < internal::header_size)
+            {
+                throw std::runtime_error{path_ + " is too small to be a mapped_vector file"};
+            }
+
+            map_existing(file_size);
+            validate(file_size);
+        }
+        catch (...)
+        {
+            // the header was not validated, so it says nothing about how far the file may be trimmed
+            release(false);
+            throw;
+        }
+    }
+
+    mapped_vector(const mapped_vector&) = delete;
+    mapped_vector& operator=(const mapped_vector&) = delete;
+
+    mapped_vector(mapped_vector&& other) noexcept
+        : path_{std::move(other.path_)}
+        , mode_{other.mode_}
+        , fd_{std::exchange(other.fd_, -1)}
+        , base_{std::exchange(other.base_, nullptr)}
+        , mapped_size_{std::exchange(other.mapped_size_, 0)}
+    {
+    }
+
+    mapped_vector& operator=(mapped_vector&& other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            path_ = std::move(other.path_);
+            mode_ = other.mode_;
+            fd_ = std::exchange(other.fd_, -1);
+            base_ = std::exchange(other.base_, nullptr);
+            mapped_size_ = std::exchange(other.mapped_size_, 0);
+        }
+        return *this;
+    }
+
+    // a writable file is trimmed to its records on the way out
+    ~mapped_vector()
+    {
+        release();
+    }
+
+    void push_back(const T& record)
+    {
+        require_writable();
+        const std::size_t count = size();
+        if (count == capacity())
+        {
+            reserve(std::max<std::size_t>(initial_capacity, count * 2));
+        }
+        std::memcpy(records() + count, &record, sizeof(T));
+        header().size = count + 1;
+    }
+
+    // grows the file and the mapping so that size() can reach capacity without remapping
+    void reserve(std::size_t capacity)
+    {
+        require_writable();
+        if (capacity > this->capacity())
+        {
+            map(capacity);
+        }
+    }
+
+    // writes the dirty pages back to the file, the kernel otherwise does so on its own schedule
+    void flush()
+    {
+        if (base_ != nullptr && mode_ == open_mode::read_write && ::msync(base_, mapped_size_, MS_SYNC) != 0)
+        {
+            internal::throw_errno("failed to sync", path_);
+        }
+    }
+
+    // a moved from object holds nothing
+    std::size_t size() const noexcept
+    {
+        return base_ != nullptr ? header().size : 0;
+    }
+
+    bool empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    std::size_t capacity() const noexcept
+    {
+        return base_ != nullptr ? (mapped_size_ - internal::header_size) / sizeof(T) : 0;
+    }
+
+    const T& operator[](std::size_t index) const noexcept
+    {
+        return data()[index];
+    }
+
+    const T* data() const noexcept
+    {
+        return base_ != nullptr ? reinterpret_cast<const T*>(static_cast<const char*>(base_) + internal::header_size) : nullptr;
+    }
+
+    const T* begin() const noexcept
+    {
+        return data();
+    }
+
+    const T* end() const noexcept
+    {
+        return data() + size();
+    }
+
+    std::span<const T> records_view() const noexcept
+    {
+        return {data(), size()};
+    }
+
+    const std::string& path() const noexcept
+    {
+        return path_;
+    }
+
+private:
+    static constexpr std::size_t initial_capacity = 1024;
+
+    internal::file_header& header() const noexcept
+    {
+        return *static_cast<internal::file_header*>(base_);
+    }
+
+    T* records() const noexcept
+    {
+        return reinterpret_cast<T*>(static_cast<char*>(base_) + internal::header_size);
+    }
+
+    void require_writable() const
+    {
+        if (mode_ != open_mode::read_write)
+        {
+            throw std::runtime_error{path_ + " is opened read-only"};
+        }
+    }
+
+    // grows the file to hold capacity records and maps all of it, moving the mapping if it has to
+    void map(std::size_t capacity)
+    {
+        const std::size_t new_size = internal::header_size + capacity * sizeof(T);
+        if (::ftruncate(fd_, static_cast<off_t>(new_size)) != 0)
+        {
+            internal::throw_errno("failed to grow", path_);
+        }
+
+        void* mapped = base_ == nullptr ? ::mmap(nullptr, new_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0)
+                                        : ::mremap(base_, mapped_size_, new_size, MREMAP_MAYMOVE);
+        if (mapped == MAP_FAILED)
+        {
+            internal::throw_errno("failed to map", path_);
+        }
+        base_ = mapped;
+        mapped_size_ = new_size;
+    }
+
+    void map_existing(std::size_t file_size)
+    {
+        const int protection = mode_ == open_mode::read_write ? PROT_READ | PROT_WRITE : PROT_READ;
+        void* mapped = ::mmap(nullptr, file_size, protection, MAP_SHARED, fd_, 0);
+        if (mapped == MAP_FAILED)
+        {
+            internal::throw_errno("failed to map", path_);
+        }
+        base_ = mapped;
+        mapped_size_ = file_size;
+    }
+
+    void validate(std::size_t file_size) const
+    {
+        const internal::file_header& h = header();
+        if (h.magic != internal::file_header::expected_magic)
+        {
+            throw std::runtime_error{path_ + " is not a mapped_vector file, or was written on a host of the other byte order"};
+        }
+        if (h.schema_hash != ::krrs::reflect::schema_hash<T>() || h.record_size != sizeof(T))
+        {
+            throw std::runtime_error{path_ + " holds records of another layout of " + std::string{::krrs::reflect::utility::get_short_name<T>()}};
+        }
+        if (h.size > (file_size - internal::header_size) / sizeof(T))
+        {
+            throw std::runtime_error{path_ + " is truncated, its header claims " + std::to_string(h.size) + " records"};
+        }
+    }
+
+    void release(bool trim = true) noexcept
+    {
+        std::size_t used = 0;
+        if (base_ != nullptr && trim)
+        {
+            used = internal::header_size + size() * sizeof(T);
+        }
+        if (base_ != nullptr)
+        {
+            ::munmap(base_, mapped_size_);
+            base_ = nullptr;
+            mapped_size_ = 0;
+        }
+        if (fd_ >= 0)
+        {
+            if (mode_ == open_mode::read_write && used != 0)
+            {
+                // drop the spare capacity, so the file holds exactly its records. errors are ignored, the slack is harmless
+                [[maybe_unused]] const int ignored = ::ftruncate(fd_, static_cast<off_t>(used));
+            }
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    std::string path_;
+    open_mode mode_;
+    int fd_ = -1;
+    void* base_ = nullptr;
+    std::size_t mapped_size_ = 0;
+};
+
+} // namespace krrs::storage
@@ -3,11 +3,17 @@
 
 #pragma once
 
+#include "../../include/reflect/numeric.hpp"
+#include "../../include/reflect/perfect_hash.hpp"
 #include "../../include/reflect/reflect.hpp"
 #include "concepts.hpp"
 
 #include <yaml-cpp/yaml.h>
 
+#include <array>
+#include <cmath>
+#include <concepts>
+
 namespace YAML {
 
 template <::krrs::reflect::concepts::reflectable T>
@@ -26,7 +32,7 @@ struct convert<T>
                 {
                     return;
                 }
-                node[Descriptor::name] = member;
+                node[Descriptor::name] = encode_value(member);
             }
             else if constexpr (::krrs::yaml::concepts::same_as_optional<member_type>)
             {
@@ -34,11 +40,11 @@ struct convert<T>
                 {
                     return;
                 }
-                node[Descriptor::name] = *member;
+                node[Descriptor::name] = encode_value(*member);
             }
             else
             {
-                node[Descriptor::name] = member;
+                node[Descriptor::name] = encode_value(member);
             }
         });
         return node;
@@ -48,32 +54,105 @@ struct convert<T>
     {
         // TODO: yaml key validation?
 
-        ::krrs::reflect::for_each<T>([&node, &obj]<typename Descriptor>() {
-            using member_type = typename Descriptor::member_type;
-            auto& member = ::krrs::reflect::get_member_variable<Descriptor>(obj);
+        static constexpr auto& lookup = ::krrs::reflect::member_lookup<T>;
+        static constexpr auto decoders = ::krrs::reflect::make_jump_table<T, void(const Node&, T&), member_decoder>();
 
-            if constexpr (::krrs::yaml::concepts::container_like<member_type>)
+        // one pass over the mapping, each key goes straight to its member through the perfect hash
+        // instead of a node[name] lookup (itself a linear scan of the mapping) per member
+        std::array<bool, lookup.names.size()> seen{};
+        if (node.IsMap())
+        {
+            for (const auto& entry : node)
             {
-                if (!node[Descriptor::name])
+                if (const std::size_t index = lookup.find(entry.first.Scalar()); index != lookup.npos)
                 {
-                    return;
+                    decoders[index](entry.second, obj);
+                    seen[index] = true;
                 }
-                member = node[Descriptor::name].template as<member_type>();
             }
-            else if constexpr (::krrs::yaml::concepts::same_as_optional<member_type>)
+        }
+
+        // containers and optionals may be absent. for any other missing member, let yaml-cpp report the missing key as before
+        ::krrs::reflect::for_each<T>([&node, &obj, &seen]<typename Descriptor>() {
+            using member_type = typename Descriptor::member_type;
+            if constexpr (!::krrs::yaml::concepts::container_like<member_type> && !::krrs::yaml::concepts::same_as_optional<member_type>)
             {
-                if (!node[Descriptor::name])
+                if (!seen[::krrs::reflect::descriptor_index<T, Descriptor>()])
                 {
-                    return;
+                    ::krrs::reflect::get_member_variable<Descriptor>(obj) = node[Descriptor::name].template as<member_type>();
                 }
-                member = node[Descriptor::name].template as<typename member_type::value_type>();
+            }
+        });
+        return true;
+    }
+
+private:
+    // jump table entry, decodes a mapping value into the member described by Descriptor
+    struct member_decoder
+    {
+        template <typename Descriptor>
+        static void invoke(const Node& value, T& obj)
+        {
+            using member_type = typename Descriptor::member_type;
+            auto& member = ::krrs::reflect::get_member_variable<Descriptor>(obj);
+
+            if constexpr (::krrs::yaml::concepts::same_as_optional<member_type>)
+            {
+                member = decode_value<typename member_type::value_type>(value);
             }
             else
             {
-                member = node[Descriptor::name].template as<member_type>();
+                member = decode_value<member_type>(value);
             }
-        });
-        return true;
+        }
+    };
+
+    template <typename V>
+    static Node encode_value(const V& value)
+    {
+        if constexpr (::krrs::reflect::numeric::number<V>)
+        {
+            if constexpr (std::floating_point<V>)
+            {
+                // yaml-cpp spells these .inf / .nan
+                if (!std::isfinite(value))
+                {
+                    return Node{value};
+                }
+            }
+            // yaml-cpp streams numbers with max_digits10 (0.1 becomes 0.10000000000000001), emit the shortest form instead
+            return Node{::krrs::reflect::numeric::to_string(value)};
+        }
+        else if constexpr (::krrs::yaml::concepts::container_like<V> && requires { requires ::krrs::reflect::numeric::number<typename V::value_type>; })
+        {
+            Node node{NodeType::Sequence};
+            for (const auto& elem : value)
+            {
+                node.push_back(encode_value(elem));
+            }
+            return node;
+        }
+        else
+        {
+            return Node{value};
+        }
+    }
+
+    template <typename V>
+    static V decode_value(const Node& value)
+    {
+        if constexpr (::krrs::reflect::numeric::number<V>)
+        {
+            // from_chars fast path. anything else yaml accepts as a number (.inf, 0x1F, ...) still goes through yaml-cpp
+            if (value.IsScalar())
+            {
+                if (const auto parsed = ::krrs::reflect::numeric::parse<V>(value.Scalar()))
+                {
+                    return *parsed;
+                }
+            }
+        }
+        return value.template as<V>();
     }
 };
 
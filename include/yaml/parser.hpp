@@ -3,9 +3,11 @@
 
 #pragma once
 
+#include "../../include/io/sink.hpp"
 #include "convert.hpp"
 
-#include <sstream>
+#include <ostream>
+#include <string>
 
 namespace krrs::yaml {
 
@@ -17,15 +19,27 @@ T deserialize(const std::string& yaml_config_str)
     return node[type_name].as<T>();
 }
 
-template <krrs::reflect::concepts::reflectable T>
-std::string serialize(const T& obj)
+// the emitter writes straight to out, e.g. an io::fd_sink, rather than into a string that is copied afterwards
+template <krrs::reflect::concepts::reflectable T, io::sink Sink>
+void serialize(const T& obj, Sink& out)
 {
     constexpr std::string_view type_name = ::krrs::reflect::utility::get_short_name<T>();
     YAML::Node node;
     node[type_name] = obj;
-    std::ostringstream oss;
-    oss << node;
-    return oss.str();
+    io::sink_streambuf<Sink> buffer{out};
+    std::ostream os{&buffer};
+    // rethrows whatever the sink threw instead of just setting badbit
+    os.exceptions(std::ostream::badbit);
+    os << node;
+}
+
+template <krrs::reflect::concepts::reflectable T>
+std::string serialize(const T& obj)
+{
+    std::string out;
+    io::string_sink sink{out};
+    serialize(obj, sink);
+    return out;
 }
 
 } // namespace krrs::yaml
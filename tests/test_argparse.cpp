@@ -36,6 +36,22 @@ struct arg_optional_options
     REFLECT(arg_optional_options, (), (dummy, backup_directory, interval))
 };
 
+struct arg_base_options
+{
+    int level;
+    std::string name;
+
+    REFLECT(arg_base_options, (), (level, name))
+};
+
+// level hides the member of the base class
+struct arg_derived_options : arg_base_options
+{
+    int level;
+
+    REFLECT(arg_derived_options, (arg_base_options), (level))
+};
+
 } // namespace mocks
 
 template <typename T, std::convertible_to<std::exception> ExceptionT = std::invalid_argument>
@@ -132,4 +148,15 @@ TEST(test_argparse, test_optional_no_default_value)
     expect_exception<mocks::arg_optional_options>(argc, argv, "[argparse] arguments not supplied (or no default values): backup_directory");
 }
 
+TEST(test_argparse, test_hidden_base_member_shares_the_flag)
+{
+    const char* argv[] = {"dummy", "--level", "7", "--name", "derived"};
+    const int argc = std::ranges::size(argv);
+    const auto argparsed = ::krrs::argparse::parse_args<mocks::arg_derived_options>(argc, argv);
+
+    EXPECT_EQ(argparsed.level, 7);
+    EXPECT_EQ(static_cast<const mocks::arg_base_options&>(argparsed).level, 7);
+    EXPECT_EQ(argparsed.name, "derived");
+}
+
 } // namespace tests
@@ -0,0 +1,326 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#include "../include/binary/convert.hpp"
+#include "../include/binary/stream.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace tests {
+
+using namespace ::testing;
+
+namespace mocks {
+
+enum class binary_side : uint8_t
+{
+    BUY = 1,
+    SELL = 2,
+};
+
+struct binary_point
+{
+    int32_t x;
+    double y;
+
+    auto operator<=>(const binary_point&) const = default;
+
+    REFLECT(binary_point, (), (x, y));
+};
+
+struct binary_order
+{
+    int64_t id;
+    float quantity;
+    binary_side side;
+    std::array<uint16_t, 2> flags;
+    std::optional<binary_point> anchor;
+    bool active;
+
+    auto operator<=>(const binary_order&) const = default;
+
+    REFLECT(binary_order, (), (id, quantity, side, flags, anchor, active));
+};
+
+struct binary_header
+{
+    std::string venue;
+    uint64_t sequence;
+
+    bool operator==(const binary_header&) const = default;
+
+    REFLECT(binary_header, (), (venue, sequence));
+};
+
+struct binary_book : binary_header
+{
+    char letter;
+    std::vector<double> levels;
+    std::vector<binary_point> points;
+    std::vector<std::string> tags;
+    std::vector<binary_side> sides;
+    std::unordered_map<std::string, int> counters;
+    std::optional<std::string> note;
+    std::vector<std::optional<int>> gaps;
+
+    bool operator==(const binary_book&) const = default;
+
+    REFLECT(binary_book, (binary_header), (letter, levels, points, tags, sides, counters, note, gaps));
+};
+
+struct binary_switches
+{
+    std::vector<bool> on;
+    std::vector<std::vector<bool>> grid;
+
+    bool operator==(const binary_switches&) const = default;
+
+    REFLECT(binary_switches, (), (on, grid));
+};
+
+// binary_switches with grid dropped
+struct binary_switches_v2
+{
+    std::vector<bool> on;
+
+    REFLECT(binary_switches_v2, (), (on));
+};
+
+// the same record before and after a schema change
+namespace v1 {
+
+struct binary_trade
+{
+    std::string symbol;
+    int32_t quantity;
+    double price;
+    std::vector<binary_point> fills;
+    bool retired;
+
+    REFLECT(binary_trade, (), (symbol, quantity, price, fills, retired));
+};
+
+} // namespace v1
+
+namespace v2 {
+
+// members reordered, quantity widened, retired dropped and venue added
+struct binary_trade
+{
+    double price;
+    int64_t quantity;
+    std::string symbol;
+    std::optional<std::string> venue;
+    std::vector<binary_point> fills;
+
+    REFLECT(binary_trade, (), (price, quantity, symbol, venue, fills));
+};
+
+// price can no longer be read from what v1 wrote
+struct binary_trade_text_price
+{
+    std::string price;
+
+    REFLECT(binary_trade_text_price, (), (price));
+};
+
+} // namespace v2
+
+} // namespace mocks
+
+TEST(test_binary_codec, wire_format_is_little_endian_and_tagless)
+{
+    const mocks::binary_point point{-2, 1.5};
+    const std::string bytes = krrs::binary::encode(point);
+
+    // int32 then double, no keys, lengths or padding in between
+    const std::string expected{"\xFE\xFF\xFF\xFF"
+                               "\x00\x00\x00\x00\x00\x00\xF8\x3F",
+                               12};
+    EXPECT_EQ(bytes, expected);
+    EXPECT_EQ(krrs::binary::decode<mocks::binary_point>(bytes), point);
+
+    // vectors and strings carry a leb128 length
+    mocks::binary_header header{};
+    header.venue = std::string(300, 'v');
+    header.sequence = 1;
+    const std::string encoded = krrs::binary::encode(header);
+    ASSERT_EQ(encoded.size(), 2u + 300u + 8u);
+    EXPECT_EQ(encoded.substr(0, 2), "\xAC\x02");
+}
+
+TEST(test_binary_codec, round_trip)
+{
+    mocks::binary_book book{};
+    book.venue = "XNAS";
+    book.sequence = std::numeric_limits<uint64_t>::max();
+    book.letter = 'q';
+    book.levels = {101.25, 101.5, -0.0, std::numeric_limits<double>::denorm_min()};
+    book.points = {{1, 0.5}, {2, 0.25}};
+    book.tags = {"", "a", std::string(200, 't')};
+    book.sides = {mocks::binary_side::SELL, mocks::binary_side::BUY};
+    book.counters = {{"orders", 1200}, {"cancels", -311}};
+    book.note = "late";
+    book.gaps = {std::nullopt, 4};
+
+    const std::string bytes = krrs::binary::encode(book);
+    EXPECT_EQ(bytes.size(), krrs::binary::encoded_size(book));
+    EXPECT_EQ(krrs::binary::decode<mocks::binary_book>(bytes), book);
+
+    // every member is overwritten, including the ones the encoded value left empty
+    mocks::binary_book reused = book;
+    reused.levels.push_back(9.0);
+    const mocks::binary_book empty{};
+    krrs::binary::decode(reused, krrs::binary::encode(empty));
+    EXPECT_EQ(reused, empty);
+
+    // encode appends, so several records can share one buffer and be read back in order
+    std::string stream;
+    krrs::binary::encode(book, stream);
+    krrs::binary::encode(empty, stream);
+    krrs::binary::decoder d{stream};
+    mocks::binary_book first{};
+    mocks::binary_book second{};
+    krrs::binary::decode(first, d);
+    krrs::binary::decode(second, d);
+    EXPECT_TRUE(d.at_end());
+    EXPECT_EQ(first, book);
+    EXPECT_EQ(second, empty);
+}
+
+TEST(test_binary_codec, vector_of_bool_round_trips)
+{
+    const mocks::binary_switches switches{{true, false, false, true, true}, {{}, {false}, {true, true, false}}};
+    EXPECT_EQ(krrs::binary::decode<mocks::binary_switches>(krrs::binary::encode(switches)), switches);
+}
+
+TEST(test_binary_codec, encode_through_sinks)
+{
+    mocks::binary_book book{};
+    book.venue = std::string(2000, 'v');
+    book.levels.assign(1000, 3.5);
+    book.tags = {"short", std::string(1000, 't')};
+    const std::string expected = krrs::binary::encode(book);
+
+    // the large strings and the levels array are handed to writev straight out of book
+    std::FILE* file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    {
+        krrs::io::fd_sink sink{fileno(file), 64};
+        krrs::binary::encode(book, sink);
+        krrs::binary::encode(book, sink);
+    }
+    std::string contents(expected.size() * 2, '\0');
+    std::rewind(file);
+    EXPECT_EQ(std::fread(contents.data(), 1, contents.size(), file), contents.size());
+    std::fclose(file);
+    EXPECT_EQ(contents, expected + expected);
+}
+
+TEST(test_binary_codec, max_encoded_size_bounds_fixed_size_types)
+{
+    static_assert(krrs::binary::concepts::fixed_size<mocks::binary_order>);
+    static_assert(!krrs::binary::concepts::fixed_size<mocks::binary_book>);
+    static_assert(krrs::binary::max_encoded_size<mocks::binary_point>() == 12);
+    // id, quantity, side, flags, presence flag + point, active
+    static_assert(krrs::binary::max_encoded_size<mocks::binary_order>() == 8 + 4 + 1 + 4 + 1 + 12 + 1);
+
+    mocks::binary_order order{42, 1.5f, mocks::binary_side::SELL, {7, 9}, mocks::binary_point{1, 2.0}, true};
+    EXPECT_EQ(krrs::binary::encode(order).size(), krrs::binary::max_encoded_size<mocks::binary_order>());
+    EXPECT_EQ(krrs::binary::decode<mocks::binary_order>(krrs::binary::encode(order)), order);
+
+    order.anchor.reset();
+    EXPECT_EQ(krrs::binary::encode(order).size(), krrs::binary::encoded_size(order));
+    EXPECT_EQ(krrs::binary::decode<mocks::binary_order>(krrs::binary::encode(order)), order);
+}
+
+TEST(test_binary_codec, malformed_input_throws)
+{
+    const mocks::binary_order order{42, 1.5f, mocks::binary_side::BUY, {7, 9}, std::nullopt, true};
+    const std::string bytes = krrs::binary::encode(order);
+
+    // truncated at every offset
+    for (std::size_t size = 0; size != bytes.size(); ++size)
+    {
+        EXPECT_THROW(krrs::binary::decode<mocks::binary_order>(bytes.substr(0, size)), std::runtime_error) << "size " << size;
+    }
+    EXPECT_THROW(krrs::binary::decode<mocks::binary_order>(bytes + '\0'), std::runtime_error);
+
+    // bools and presence flags only take 0 / 1
+    std::string corrupt = bytes;
+    corrupt.back() = '\2';
+    EXPECT_THROW(krrs::binary::decode<mocks::binary_order>(corrupt), std::runtime_error);
+
+    // a length claiming more elements than the input could hold fails before anything is allocated
+    mocks::binary_header header{};
+    std::string huge_length = "\xFF\xFF\xFF\xFF\x0F";
+    EXPECT_THROW(krrs::binary::decode(header, huge_length), std::runtime_error);
+    EXPECT_THROW(krrs::binary::decode(header, std::string(11, '\xFF')), std::runtime_error);
+}
+
+TEST(test_binary_codec, stream_with_schema_fingerprint)
+{
+    std::string bytes;
+    krrs::io::string_sink sink{bytes};
+    krrs::binary::stream_writer<mocks::v1::binary_trade, krrs::io::string_sink> writer{sink};
+    writer.write({"AAPL", 300, 189.25, {{1, 0.5}}, true});
+    writer.write({"MSFT", -5, 411.5, {}, false});
+
+    // the same type takes the fast path, with no per-field checks
+    krrs::binary::stream_reader<mocks::v1::binary_trade> same{bytes};
+    EXPECT_TRUE(same.schema_matches());
+    EXPECT_EQ(same.writer_schema_hash(), krrs::reflect::schema_hash<mocks::v1::binary_trade>());
+    mocks::v1::binary_trade trade{};
+    ASSERT_TRUE(same.read(trade));
+    EXPECT_EQ(trade.symbol, "AAPL");
+    EXPECT_EQ(trade.fills, (std::vector<mocks::binary_point>{{1, 0.5}}));
+    ASSERT_TRUE(same.read(trade));
+    EXPECT_EQ(trade.quantity, -5);
+    EXPECT_FALSE(same.read(trade));
+
+    // another version matches fields by name against the schema in the header
+    krrs::binary::stream_reader<mocks::v2::binary_trade> other{bytes};
+    EXPECT_FALSE(other.schema_matches());
+    mocks::v2::binary_trade upgraded{};
+    upgraded.venue = "kept";
+    ASSERT_TRUE(other.read(upgraded));
+    EXPECT_EQ(upgraded.price, 189.25);
+    EXPECT_EQ(upgraded.quantity, 300);
+    EXPECT_EQ(upgraded.symbol, "AAPL");
+    EXPECT_EQ(upgraded.venue, std::optional<std::string>{"kept"});
+    EXPECT_EQ(upgraded.fills, (std::vector<mocks::binary_point>{{1, 0.5}}));
+    ASSERT_TRUE(other.read(upgraded));
+    EXPECT_EQ(upgraded.symbol, "MSFT");
+    EXPECT_EQ(upgraded.quantity, -5);
+    EXPECT_TRUE(upgraded.fills.empty());
+    EXPECT_FALSE(other.read(upgraded));
+
+    krrs::binary::stream_reader<mocks::v2::binary_trade_text_price> incompatible{bytes};
+    mocks::v2::binary_trade_text_price text{};
+    EXPECT_THROW(incompatible.read(text), std::runtime_error);
+
+    // a corrupt header fails up front
+    EXPECT_THROW(krrs::binary::stream_reader<mocks::v2::binary_trade>{bytes.substr(0, 12)}, std::runtime_error);
+
+    std::string switch_bytes;
+    krrs::io::string_sink switch_sink{switch_bytes};
+    krrs::binary::stream_writer<mocks::binary_switches, krrs::io::string_sink> switch_writer{switch_sink};
+    switch_writer.write({{true, false, true}, {{false}, {true, true}}});
+    krrs::binary::stream_reader<mocks::binary_switches_v2> switch_reader{switch_bytes};
+    EXPECT_FALSE(switch_reader.schema_matches());
+    mocks::binary_switches_v2 switches{};
+    ASSERT_TRUE(switch_reader.read(switches));
+    EXPECT_EQ(switches.on, (std::vector<bool>{true, false, true}));
+}
+
+} // namespace tests
@@ -0,0 +1,174 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#include "../include/columnar/reader.hpp"
+#include "../include/columnar/writer.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tests {
+
+using namespace ::testing;
+
+namespace mocks {
+
+enum class columnar_side : uint8_t
+{
+    BUY = 1,
+    SELL = 2,
+};
+
+struct columnar_key
+{
+    std::string symbol;
+    uint64_t sequence;
+
+    REFLECT(columnar_key, (), (symbol, sequence));
+};
+
+struct columnar_trade : columnar_key
+{
+    int64_t timestamp;
+    columnar_side side;
+    double price;
+    int32_t quantity;
+    bool aggressor;
+    char venue;
+
+    double notional() const
+    {
+        return price * quantity;
+    }
+
+    REFLECT(columnar_trade, (columnar_key), (timestamp, side, price, quantity, aggressor, venue, notional));
+};
+
+// columnar_trade's base with another member order, so another schema
+struct columnar_key_v2
+{
+    uint64_t sequence;
+    std::string symbol;
+
+    REFLECT(columnar_key_v2, (), (sequence, symbol));
+};
+
+std::vector<columnar_trade> make_trades(std::size_t count)
+{
+    static constexpr std::string_view symbols[] = {"AAPL", "MSFT", "NVDA"};
+    std::vector<columnar_trade> trades;
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        columnar_trade t{};
+        t.symbol = symbols[i % 3];
+        t.sequence = 1'000'000 + i;
+        t.timestamp = 1'700'000'000'000'000'000 + static_cast<int64_t>(i) * 1'000;
+        t.side = i % 2 == 0 ? columnar_side::BUY : columnar_side::SELL;
+        t.price = 100.0 + static_cast<double>(i % 50) / 4.0;
+        t.quantity = static_cast<int32_t>(i % 7) - 3;
+        t.aggressor = i % 5 == 0;
+        t.venue = static_cast<char>('A' + i % 4);
+        trades.push_back(t);
+    }
+    return trades;
+}
+
+} // namespace mocks
+
+TEST(test_columnar, round_trip)
+{
+    const auto trades = mocks::make_trades(1'000);
+    const std::string bytes = krrs::columnar::write(trades, 300);
+
+    const krrs::columnar::reader<mocks::columnar_trade> reader{bytes};
+    EXPECT_EQ(reader.size(), 1'000u);
+    ASSERT_EQ(reader.row_group_count(), 4u);
+    EXPECT_EQ(reader.row_group_size(3), 100u);
+
+    const auto decoded = reader.read<>();
+    ASSERT_EQ(decoded.size(), trades.size());
+    for (std::size_t i = 0; i != trades.size(); ++i)
+    {
+        EXPECT_EQ(decoded[i].symbol, trades[i].symbol);
+        EXPECT_EQ(decoded[i].sequence, trades[i].sequence);
+        EXPECT_EQ(decoded[i].timestamp, trades[i].timestamp);
+        EXPECT_EQ(decoded[i].side, trades[i].side);
+        EXPECT_EQ(decoded[i].price, trades[i].price);
+        EXPECT_EQ(decoded[i].quantity, trades[i].quantity);
+        EXPECT_EQ(decoded[i].aggressor, trades[i].aggressor);
+        EXPECT_EQ(decoded[i].venue, trades[i].venue);
+    }
+
+    // sequential integers and a three-entry dictionary take far less than the rows in memory
+    EXPECT_LT(bytes.size(), trades.size() * 20);
+
+    const std::string empty = krrs::columnar::write(std::vector<mocks::columnar_trade>{});
+    const krrs::columnar::reader<mocks::columnar_trade> empty_reader{empty};
+    EXPECT_TRUE(empty_reader.empty());
+    EXPECT_TRUE(empty_reader.read<>().empty());
+
+    EXPECT_THROW(krrs::columnar::write(trades, 0), std::invalid_argument);
+}
+
+TEST(test_columnar, projection_and_stats)
+{
+    const auto trades = mocks::make_trades(1'000);
+    const std::string bytes = krrs::columnar::write(trades, 256);
+    const krrs::columnar::reader<mocks::columnar_trade> reader{bytes};
+
+    const std::vector<int32_t> quantities = reader.column<&mocks::columnar_trade::quantity>();
+    ASSERT_EQ(quantities.size(), trades.size());
+    EXPECT_EQ(quantities[10], trades[10].quantity);
+
+    // base class members are named through the base's member pointer
+    int64_t aapl = 0;
+    reader.scan<&mocks::columnar_key::symbol>([&aapl](std::string_view symbol) { aapl += symbol == "AAPL" ? 1 : 0; });
+    EXPECT_EQ(aapl, 334);
+
+    const auto projected = reader.read<&mocks::columnar_trade::price, &mocks::columnar_key::sequence>();
+    EXPECT_EQ(projected[999].price, trades[999].price);
+    EXPECT_EQ(projected[999].sequence, trades[999].sequence);
+    EXPECT_TRUE(projected[999].symbol.empty());
+    EXPECT_EQ(projected[999].timestamp, 0);
+
+    const auto sequence = reader.stats<&mocks::columnar_key::sequence>(1);
+    EXPECT_EQ(sequence.min, 1'000'256u);
+    EXPECT_EQ(sequence.max, 1'000'511u);
+    const auto quantity = reader.stats<&mocks::columnar_trade::quantity>(0);
+    EXPECT_EQ(quantity.min, -3);
+    EXPECT_EQ(quantity.max, 3);
+    const auto symbol = reader.stats<&mocks::columnar_key::symbol>(2);
+    EXPECT_EQ(symbol.min, "AAPL");
+    EXPECT_EQ(symbol.max, "NVDA");
+    const auto side = reader.stats<&mocks::columnar_trade::side>(3);
+    EXPECT_EQ(side.min, mocks::columnar_side::BUY);
+    EXPECT_EQ(side.max, mocks::columnar_side::SELL);
+    EXPECT_THROW(reader.stats<&mocks::columnar_trade::price>(4), std::out_of_range);
+}
+
+TEST(test_columnar, rejects_mismatched_files)
+{
+    const std::string bytes = krrs::columnar::write(mocks::make_trades(10));
+    EXPECT_THROW(krrs::columnar::reader<mocks::columnar_key_v2>{bytes}, std::runtime_error);
+    EXPECT_THROW(krrs::columnar::reader<mocks::columnar_trade>{std::string_view{bytes}.substr(0, bytes.size() - 1)}, std::runtime_error);
+
+    // a footer offset pointing past the footer
+    std::string corrupt = bytes;
+    corrupt[corrupt.size() - 16] = '\xFF';
+    corrupt[corrupt.size() - 15] = '\xFF';
+    EXPECT_THROW(krrs::columnar::reader<mocks::columnar_trade>{corrupt}, std::runtime_error);
+
+    // a dictionary index past its dictionary: the first chunk is symbol, a count and three 5-byte entries, then an index per row
+    std::string bad_index = bytes;
+    bad_index[16 + 1 + 3 * 5] = '\x09';
+    const krrs::columnar::reader<mocks::columnar_trade> bad_reader{bad_index};
+    EXPECT_THROW(bad_reader.column<&mocks::columnar_key::symbol>(), std::runtime_error);
+}
+
+} // namespace tests
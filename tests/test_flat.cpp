@@ -0,0 +1,164 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#include "../include/flat/builder.hpp"
+#include "../include/flat/view.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tests {
+
+using namespace ::testing;
+
+namespace mocks {
+
+enum class flat_side : uint8_t
+{
+    BUY = 1,
+    SELL = 2,
+};
+
+struct flat_level
+{
+    double price;
+    int32_t size;
+
+    REFLECT(flat_level, (), (price, size));
+};
+
+struct flat_header
+{
+    std::string venue;
+    uint64_t sequence;
+
+    REFLECT(flat_header, (), (venue, sequence));
+};
+
+struct flat_book : flat_header
+{
+    bool active;
+    flat_side side;
+    std::array<int16_t, 3> flags;
+    flat_level best;
+    std::vector<double> bids;
+    std::vector<flat_level> levels;
+    std::vector<std::string> tags;
+    std::vector<std::vector<int32_t>> buckets;
+
+    double mid() const
+    {
+        return best.price;
+    }
+
+    REFLECT(flat_book, (flat_header), (active, side, flags, best, bids, levels, tags, buckets, mid));
+};
+
+// flat_level with another member order, so another schema
+struct flat_level_v2
+{
+    int32_t size;
+    double price;
+
+    REFLECT(flat_level_v2, (), (size, price));
+};
+
+} // namespace mocks
+
+TEST(test_flat, table_layout)
+{
+    using layout = krrs::flat::internal::table_layout<mocks::flat_level>;
+    static_assert(layout::size == 16);
+    static_assert(layout::align == 8);
+    static_assert(layout::offset<krrs::reflect::descriptor_for<mocks::flat_level, &mocks::flat_level::size>> == 8);
+
+    // scalars inline, the venue as a (offset, length) slot right after the header and the root table
+    const std::string bytes = krrs::flat::build(mocks::flat_header{"XNAS", 7});
+    ASSERT_EQ(bytes.size(), krrs::flat::header_size + 16 + 4);
+    EXPECT_EQ(bytes.substr(8, 8), std::string("\x18\x00\x00\x00\x04\x00\x00\x00", 8));
+    EXPECT_EQ(bytes.substr(16, 8), std::string("\x07\x00\x00\x00\x00\x00\x00\x00", 8));
+    EXPECT_EQ(bytes.substr(24), "XNAS");
+}
+
+TEST(test_flat, view_reads_in_place)
+{
+    mocks::flat_book book{};
+    book.venue = "XNAS";
+    book.sequence = 77;
+    book.active = true;
+    book.side = mocks::flat_side::SELL;
+    book.flags = {-1, 0, 9};
+    book.best = {101.5, 300};
+    book.bids = {101.25, 101.0};
+    book.levels = {{1.5, 10}, {2.5, -30}};
+    book.tags = {"", "odd lot", std::string(300, 't')};
+    book.buckets = {{1, 2, 3}, {}, {4}};
+
+    krrs::flat::builder<mocks::flat_book> builder;
+    const std::string_view bytes = builder.build(book);
+    const krrs::flat::view<mocks::flat_book> view{bytes};
+
+    // base class members through the base's member pointer
+    EXPECT_EQ(view.get<&mocks::flat_header::venue>(), "XNAS");
+    EXPECT_EQ(view.get<&mocks::flat_header::sequence>(), 77u);
+    EXPECT_TRUE(view.get<&mocks::flat_book::active>());
+    EXPECT_EQ(view.get<&mocks::flat_book::side>(), mocks::flat_side::SELL);
+    EXPECT_EQ(view.get<&mocks::flat_book::flags>(), (std::array<int16_t, 3>{-1, 0, 9}));
+    EXPECT_EQ(view.get<&mocks::flat_book::best>().get<&mocks::flat_level::size>(), 300);
+
+    // strings point into the buffer, nothing is copied
+    const std::string_view venue = view.get<&mocks::flat_header::venue>();
+    EXPECT_GE(venue.data(), bytes.data());
+    EXPECT_LT(venue.data(), bytes.data() + bytes.size());
+
+    const auto bids = view.get<&mocks::flat_book::bids>();
+    EXPECT_EQ(std::vector<double>(bids.begin(), bids.end()), book.bids);
+
+    const auto levels = view.get<&mocks::flat_book::levels>();
+    ASSERT_EQ(levels.size(), 2u);
+    EXPECT_EQ(levels[1].get<&mocks::flat_level::price>(), 2.5);
+    EXPECT_EQ(levels[1].get<&mocks::flat_level::size>(), -30);
+
+    std::vector<std::string> tags;
+    for (const std::string_view tag : view.get<&mocks::flat_book::tags>())
+    {
+        tags.emplace_back(tag);
+    }
+    EXPECT_EQ(tags, book.tags);
+
+    const auto buckets = view.get<&mocks::flat_book::buckets>();
+    ASSERT_EQ(buckets.size(), 3u);
+    EXPECT_TRUE(buckets[1].empty());
+    EXPECT_EQ(buckets[0][2], 3);
+    EXPECT_EQ(buckets[2][0], 4);
+
+    // accessors also take the descriptor itself
+    using sequence = krrs::reflect::descriptor_for<mocks::flat_header, &mocks::flat_header::sequence>;
+    EXPECT_EQ(view.get<sequence>(), 77u);
+
+    // the builder reuses its buffer
+    book.venue = "XLON";
+    EXPECT_EQ(krrs::flat::view<mocks::flat_book>{builder.build(book)}.get<&mocks::flat_header::venue>(), "XLON");
+}
+
+TEST(test_flat, view_rejects_foreign_or_corrupt_buffers)
+{
+    const std::string bytes = krrs::flat::build(mocks::flat_level{1.5, 10});
+    EXPECT_THROW(krrs::flat::view<mocks::flat_level_v2>{bytes}, std::runtime_error);
+    EXPECT_THROW(krrs::flat::view<mocks::flat_level>{bytes.substr(0, bytes.size() - 1)}, std::runtime_error);
+
+    // a slot pointing past the end of the buffer fails on access
+    std::string corrupt = krrs::flat::build(mocks::flat_header{"XNAS", 7});
+    corrupt[12] = '\x05';
+    const krrs::flat::view<mocks::flat_header> view{corrupt};
+    EXPECT_EQ(view.get<&mocks::flat_header::sequence>(), 7u);
+    EXPECT_THROW(view.get<&mocks::flat_header::venue>(), std::runtime_error);
+}
+
+} // namespace tests
@@ -1,12 +1,19 @@
 // Copyright (c) 2025 KiryuRS
 // SPDX-License-Identifier: MIT
 
+#include "../include/json/borrowed_document.hpp"
+#include "../include/json/ndjson.hpp"
 #include "../include/json/parser.hpp"
+#include "../include/reflect/enum.hpp"
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <array>
 #include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <random>
 #include <optional>
 #include <string>
 #include <unordered_map>
@@ -46,6 +53,101 @@ struct json_compound
     REFLECT(json_compound, (), (inner, numbers, tags, registry, maybe_int, maybe_str));
 };
 
+struct json_point
+{
+    int x;
+    double y;
+
+    REFLECT(json_point, (), (x, y));
+};
+
+struct json_path
+{
+    std::vector<json_point> points;
+    std::optional<json_point> origin;
+
+    REFLECT(json_path, (), (points, origin));
+};
+
+struct json_owning
+{
+    bool active;
+    char letter;
+    int32_t count;
+    uint64_t unsigned_big;
+    double precision;
+    std::string name;
+    std::vector<std::string> tags;
+    std::unordered_map<std::string, int> registry;
+    std::optional<int> maybe_int;
+    json_path path;
+
+    REFLECT(json_owning, (), (active, letter, count, unsigned_big, precision, name, tags, registry, maybe_int, path));
+};
+
+struct json_borrowed
+{
+    std::string_view venue;
+    std::vector<std::string_view> tags;
+    std::optional<std::string_view> note;
+    int quantity;
+
+    REFLECT(json_borrowed, (), (venue, tags, note, quantity));
+};
+
+struct json_switches
+{
+    std::vector<bool> on;
+    std::vector<std::vector<bool>> grid;
+
+    REFLECT(json_switches, (), (on, grid));
+};
+
+struct json_limit_base
+{
+    int level;
+    int limit;
+
+    REFLECT(json_limit_base, (), (level, limit));
+};
+
+// level hides the member of the base class, both are written under the same key
+struct json_hidden_limit : json_limit_base
+{
+    int level;
+    std::string note;
+
+    REFLECT(json_hidden_limit, (json_limit_base), (level, note));
+};
+
+enum class json_side : uint8_t
+{
+    NONE,
+    BUY,
+    SELL,
+};
+
+ENUM_PRINTABLE(json_side, (NONE, BUY, SELL));
+
+enum class json_venue_id : int16_t
+{
+};
+
+struct json_fixed_order
+{
+    int64_t id;
+    double price;
+    float quantity;
+    json_side side;
+    json_venue_id venue;
+    std::array<uint8_t, 3> flags;
+    std::optional<json_point> anchor;
+    bool active;
+    char tag;
+
+    REFLECT(json_fixed_order, (), (id, price, quantity, side, venue, flags, anchor, active, tag));
+};
+
 } // namespace mocks
 
 TEST(test_json_serialization, serialize_primitive_and_string_types)
@@ -115,4 +217,537 @@ TEST(test_json_serialization, serialize_complex_types)
     EXPECT_THAT(sparse_result, HasSubstr(R"("tags": [])"));
 }
 
+TEST(test_json_serialization, serialize_into_existing_buffer)
+{
+    const mocks::json_path path{
+        .points = {{1, 0.5}, {2, 0.1}},
+        .origin = mocks::json_point{0, std::numeric_limits<double>::quiet_NaN()},
+    };
+
+    // the writer appends in place, existing content is left untouched
+    std::string buffer = "prefix ";
+    krrs::json::convert_to_json(path, buffer);
+    EXPECT_EQ(buffer, R"(prefix {"points": [{"x": 1, "y": 0.5}, {"x": 2, "y": 0.1}], "origin": {"x": 0, "y": null}})");
+
+    // serialize appends as well, and both paths agree with the returning overloads
+    buffer.clear();
+    krrs::json::serialize(path, buffer);
+    EXPECT_EQ(buffer, krrs::json::serialize(path));
+    EXPECT_THAT(buffer, StartsWith(R"({"json_path": {"points": )"));
+}
+
+TEST(test_json_serialization, deserialize_round_trip)
+{
+    const mocks::json_owning original{
+        .active = true,
+        .letter = 'Q',
+        .count = -42,
+        .unsigned_big = 18'000'000'000ULL,
+        .precision = 0.1,
+        .name = "alice",
+        .tags = {"foo", "bar"},
+        .registry = {{"alpha", 1}, {"beta", 2}},
+        .maybe_int = std::nullopt,
+        .path = {.points = {{1, 0.5}, {2, -1e-7}}, .origin = mocks::json_point{3, 4.25}},
+    };
+
+    const auto decoded = krrs::json::deserialize<mocks::json_owning>(krrs::json::serialize(original));
+    EXPECT_EQ(decoded.active, original.active);
+    EXPECT_EQ(decoded.letter, original.letter);
+    EXPECT_EQ(decoded.count, original.count);
+    EXPECT_EQ(decoded.unsigned_big, original.unsigned_big);
+    EXPECT_EQ(decoded.precision, original.precision); // shortest round-trip formatting is exact
+    EXPECT_EQ(decoded.name, original.name);
+    EXPECT_THAT(decoded.tags, ElementsAre("foo", "bar"));
+    EXPECT_THAT(decoded.registry, UnorderedElementsAre(Pair("alpha", 1), Pair("beta", 2)));
+    EXPECT_FALSE(decoded.maybe_int.has_value());
+    ASSERT_EQ(decoded.path.points.size(), 2u);
+    EXPECT_EQ(decoded.path.points[1].x, 2);
+    EXPECT_EQ(decoded.path.points[1].y, -1e-7);
+    ASSERT_TRUE(decoded.path.origin.has_value());
+    EXPECT_EQ(decoded.path.origin->y, 4.25);
+}
+
+TEST(test_json_serialization, vector_of_bool_round_trips)
+{
+    const mocks::json_switches switches{{true, false, false, true, true}, {{}, {false}, {true, true, false}}};
+    const auto decoded = krrs::json::deserialize<mocks::json_switches>(krrs::json::serialize(switches));
+    EXPECT_EQ(decoded.on, switches.on);
+    EXPECT_EQ(decoded.grid, switches.grid);
+}
+
+TEST(test_json_serialization, deserialize_escapes_whitespace_and_unknown_keys)
+{
+    // unknown keys (including nested containers) are skipped, missing members keep their value
+    const std::string json = R"(
+    {
+        "unknown" : {"nested": ["}", {"deep": [1, 2]}], "text": "\"]"},
+        "name"    : "line\nbreak \"quoted\" \u00e9\ud83d\ude00",
+        "count"   : 7,
+        "tags"    : [ ],
+        "maybe_int": 5,
+        "also_unknown": -1.5e3
+    }
+    )";
+
+    mocks::json_owning obj{};
+    obj.letter = 'x';
+    krrs::json::convert_from_json(obj, json);
+    EXPECT_EQ(obj.name, "line\nbreak \"quoted\" \xC3\xA9\xF0\x9F\x98\x80");
+    EXPECT_EQ(obj.count, 7);
+    EXPECT_TRUE(obj.tags.empty());
+    EXPECT_EQ(obj.maybe_int, std::optional<int>{5});
+    EXPECT_EQ(obj.letter, 'x');
+
+    // malformed input is reported rather than silently accepted
+    mocks::json_point point{};
+    EXPECT_THROW(krrs::json::convert_from_json(point, R"({"x": 1.5})"), std::runtime_error);
+    EXPECT_THROW(krrs::json::convert_from_json(point, R"({"x": 1, "y": 2)"), std::runtime_error);
+    EXPECT_THROW(krrs::json::convert_from_json(point, R"({"x": 1} trailing)"), std::runtime_error);
+    EXPECT_THROW(krrs::json::deserialize<mocks::json_point>(R"({"json_path": {}})"), std::runtime_error);
+
+    // numbers follow the json grammar, not whatever from_chars accepts. non-finite values are written as null
+    for (const std::string_view number : {"nan", "-nan", "inf", "-infinity", "01", "-01", ".5", "5.", "-", "1e", "1e+", "+1", "0x10", "1.5e3.2"})
+    {
+        SCOPED_TRACE(number);
+        EXPECT_THROW(krrs::json::convert_from_json(point, R"({"y": )" + std::string{number} + "}"), std::runtime_error);
+    }
+    EXPECT_THROW(krrs::json::convert_from_json(point, R"({"x": 01})"), std::runtime_error);
+    krrs::json::convert_from_json(point, R"({"x": -0, "y": -0.5e-3})");
+    EXPECT_EQ(point.x, 0);
+    EXPECT_EQ(point.y, -0.0005);
+    krrs::json::convert_from_json(point, R"({"x": 10, "y": 1E+2 })");
+    EXPECT_EQ(point.x, 10);
+    EXPECT_EQ(point.y, 100.0);
+}
+
+namespace {
+
+// byte by byte reference for the structural index
+std::vector<std::size_t> reference_structurals(std::string_view json)
+{
+    std::vector<std::size_t> positions;
+    bool in_string = false;
+    for (std::size_t i = 0; i != json.size(); ++i)
+    {
+        const char c = json[i];
+        if (in_string && c == '\\')
+        {
+            ++i;
+        }
+        else if (c == '"')
+        {
+            in_string = !in_string;
+            positions.push_back(i);
+        }
+        else if (!in_string && std::string_view{"{}[]:,"}.contains(c))
+        {
+            positions.push_back(i);
+        }
+    }
+    return positions;
+}
+
+std::vector<std::size_t> indexed_structurals(std::string_view json, krrs::reflect::simd::level level)
+{
+    std::vector<std::size_t> positions;
+    krrs::json::internal::structural_index index{json, level};
+    for (std::size_t pos = index.next(0); pos != krrs::json::internal::structural_index::npos; pos = index.next(pos + 1))
+    {
+        positions.push_back(pos);
+    }
+    return positions;
+}
+
+} // namespace
+
+TEST(test_json_serialization, structural_index_matches_reference_for_every_level)
+{
+    // strings full of escapes, backslash runs and structural characters, so that every kind of run straddles a block boundary
+    std::mt19937 rng{1234};
+    const std::array<std::string_view, 11> pieces{"a", "b", R"(\\)", R"(\")", "{", "}", "[", "]", ":", ",", " "};
+    std::string json = "[";
+    for (int i = 0; i != 400; ++i)
+    {
+        json += R"({"k": ")";
+        const std::size_t length = rng() % 40;
+        for (std::size_t c = 0; c != length; ++c)
+        {
+            json += pieces[rng() % pieces.size()];
+        }
+        json += R"("}, )";
+    }
+    json += "1]";
+
+    const auto expected = reference_structurals(json);
+    for (const auto level : {krrs::reflect::simd::level::scalar, krrs::reflect::simd::level::sse2, krrs::reflect::simd::level::avx2})
+    {
+        EXPECT_EQ(indexed_structurals(json, level), expected) << "level " << static_cast<int>(level);
+    }
+}
+
+TEST(test_json_serialization, deserialize_with_every_simd_level)
+{
+    mocks::json_owning original{};
+    // escapes and structural characters inside strings, long enough to cross block boundaries
+    original.name = std::string(100, '\\') + "\"" + std::string(63, ']');
+    original.tags = {"{", "}", "[\\]", std::string(200, ','), "\"\\\""};
+    original.registry = {{"a\"b", 1}};
+    original.path.points = {{1, 2.5}, {3, -4.0}};
+    const std::string json = krrs::json::convert_to_json(original);
+
+    for (const auto level : {krrs::reflect::simd::level::scalar, krrs::reflect::simd::level::sse2, krrs::reflect::simd::level::avx2})
+    {
+        mocks::json_owning decoded{};
+        krrs::json::reader r{json, level};
+        krrs::json::convert_from_json(decoded, r);
+        EXPECT_TRUE(r.at_end());
+        EXPECT_EQ(decoded.name, original.name);
+        EXPECT_EQ(decoded.tags, original.tags);
+        EXPECT_THAT(decoded.registry, ElementsAre(Pair("a\"b", 1)));
+        ASSERT_EQ(decoded.path.points.size(), 2u);
+        EXPECT_EQ(decoded.path.points[1].y, -4.0);
+    }
+}
+
+TEST(test_json_serialization, ndjson_round_trip_through_small_buffers)
+{
+    std::vector<mocks::json_path> records;
+    for (int i = 0; i != 50; ++i)
+    {
+        mocks::json_path& record = records.emplace_back();
+        record.points.assign(static_cast<std::size_t>(i % 7), mocks::json_point{i, i * 0.5});
+        if (i % 3 == 0)
+        {
+            record.origin = mocks::json_point{-i, 1.25};
+        }
+    }
+
+    std::FILE* file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    {
+        // smaller than most records, so lines straddle every flush and every refill
+        krrs::json::ndjson_writer<mocks::json_path> writer{file, 16};
+        writer.write_all(records);
+        writer.flush();
+    }
+    std::rewind(file);
+
+    std::vector<mocks::json_path> decoded;
+    krrs::json::ndjson_reader<mocks::json_path> reader{file, 16};
+    static_assert(std::ranges::input_range<decltype(reader)>);
+    for (const mocks::json_path& record : reader)
+    {
+        decoded.push_back(record);
+    }
+    std::fclose(file);
+
+    ASSERT_EQ(decoded.size(), records.size());
+    for (std::size_t i = 0; i != records.size(); ++i)
+    {
+        ASSERT_EQ(decoded[i].points.size(), records[i].points.size());
+        EXPECT_EQ(decoded[i].origin.has_value(), records[i].origin.has_value());
+        if (!records[i].points.empty())
+        {
+            EXPECT_EQ(decoded[i].points.back().y, records[i].points.back().y);
+        }
+    }
+}
+
+TEST(test_json_serialization, ndjson_reader_over_file_descriptor)
+{
+    std::FILE* file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    const std::string_view lines = "{\"x\": 1, \"y\": 2.5}\n\n  \r\n{\"x\": 2}\n{\"y\": 3}";
+    std::fwrite(lines.data(), 1, lines.size(), file);
+    std::fflush(file);
+    std::rewind(file);
+
+    krrs::json::ndjson_reader<mocks::json_point> reader{fileno(file)};
+    mocks::json_point point{};
+    ASSERT_TRUE(reader.read(point));
+    EXPECT_EQ(point.x, 1);
+    EXPECT_EQ(point.y, 2.5);
+    // blank lines are skipped and every record starts from a default constructed value
+    ASSERT_TRUE(reader.read(point));
+    EXPECT_EQ(point.x, 2);
+    EXPECT_EQ(point.y, 0.0);
+    ASSERT_TRUE(reader.read(point));
+    EXPECT_EQ(point.x, 0);
+    EXPECT_EQ(point.y, 3.0);
+    EXPECT_FALSE(reader.read(point));
+    std::fclose(file);
+
+    EXPECT_THROW(krrs::json::ndjson_reader<mocks::json_point>{-1}, std::invalid_argument);
+}
+
+TEST(test_json_serialization, ndjson_writer_over_file_descriptor)
+{
+    std::FILE* file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    {
+        // full buffers go out through the fd_sink as they are, the tail on flush
+        krrs::json::ndjson_writer<mocks::json_point> writer{fileno(file), 24};
+        for (int i = 0; i != 10; ++i)
+        {
+            writer.write({i, i * 0.25});
+        }
+    }
+    std::rewind(file);
+
+    krrs::json::ndjson_reader<mocks::json_point> reader{file};
+    int count = 0;
+    for (const mocks::json_point& point : reader)
+    {
+        EXPECT_EQ(point.x, count);
+        EXPECT_EQ(point.y, count * 0.25);
+        ++count;
+    }
+    EXPECT_EQ(count, 10);
+    std::fclose(file);
+
+    EXPECT_THROW(krrs::json::ndjson_writer<mocks::json_point>{-1}, std::invalid_argument);
+    EXPECT_THROW((krrs::json::ndjson_writer<mocks::json_point>{fileno(stdout), 0}), std::invalid_argument);
+    EXPECT_THROW(krrs::json::ndjson_writer<mocks::json_point>{static_cast<std::FILE*>(nullptr)}, std::invalid_argument);
+}
+
+TEST(test_json_serialization, decode_only_selected_members)
+{
+    mocks::json_owning original{};
+    original.count = 12;
+    original.name = "bob";
+    original.tags = {"x", "y"};
+    original.path.points = {{1, 2.0}};
+    const std::string json = krrs::json::convert_to_json(original);
+
+    const auto decoded = krrs::json::decode_only<mocks::json_owning, &mocks::json_owning::name, &mocks::json_owning::path>(json);
+    EXPECT_EQ(decoded.name, "bob");
+    ASSERT_EQ(decoded.path.points.size(), 1u);
+    EXPECT_EQ(decoded.count, 0);
+    EXPECT_TRUE(decoded.tags.empty());
+
+    // decoding stops once every selected member has been seen, whatever follows is never parsed
+    const auto early = krrs::json::decode_only<mocks::json_point, &mocks::json_point::x, &mocks::json_point::x>(R"({"y": [{"}": 1}], "x": 5, "z": [[[)");
+    EXPECT_EQ(early.x, 5);
+    EXPECT_EQ(early.y, 0.0);
+
+    // selected members that never show up keep the parser going until the end of the object
+    EXPECT_THROW((krrs::json::decode_only<mocks::json_point, &mocks::json_point::y>(R"({"x": 5, "z": [[[)")), std::runtime_error);
+
+    // base class members can be selected, and the n-th "level" key belongs to the n-th member named level
+    mocks::json_hidden_limit limits{};
+    limits.json_limit_base::level = 1;
+    limits.limit = 2;
+    limits.level = 3;
+    limits.note = "note";
+    const std::string limits_json = krrs::json::convert_to_json(limits);
+    const auto derived_level = krrs::json::decode_only<mocks::json_hidden_limit, &mocks::json_hidden_limit::level>(limits_json);
+    EXPECT_EQ(derived_level.level, 3);
+    EXPECT_EQ(derived_level.json_limit_base::level, 0);
+    const auto base_members = krrs::json::decode_only<mocks::json_hidden_limit, &mocks::json_limit_base::level, &mocks::json_limit_base::limit>(limits_json);
+    EXPECT_EQ(base_members.json_limit_base::level, 1);
+    EXPECT_EQ(base_members.limit, 2);
+    EXPECT_EQ(base_members.level, 0);
+    // a full decode gives each level its own value back
+    const auto round_trip = krrs::json::deserialize<mocks::json_hidden_limit>(krrs::json::serialize(limits));
+    EXPECT_EQ(round_trip.json_limit_base::level, 1);
+    EXPECT_EQ(round_trip.level, 3);
+    EXPECT_EQ(round_trip.note, "note");
+    // stops after the second level, before the malformed note
+    const auto early_level = krrs::json::decode_only<mocks::json_hidden_limit, &mocks::json_hidden_limit::level>(R"({"level": 1, "level": 3, "note": [[[)");
+    EXPECT_EQ(early_level.level, 3);
+}
+
+TEST(test_json_serialization, serialize_escapes_strings)
+{
+    std::string out;
+    krrs::json::writer w{out};
+    w.write_string("plain");
+    w.write_string("say \"hi\"\\\n\t\x01\x1f caf\xC3\xA9");
+    EXPECT_EQ(out, R"("plain""say \"hi\"\\\n\t\u0001\u001f caf)" "\xC3\xA9\"");
+
+    // escape sites at every offset around the 16 / 32 byte steps must be found by every kernel
+    for (std::size_t length = 0; length != 80; ++length)
+    {
+        for (std::size_t at = 0; at <= length; ++at)
+        {
+            std::string text(length, 'x');
+            if (at != length)
+            {
+                text[at] = at % 3 == 0 ? '"' : at % 3 == 1 ? '\\' : '\x02';
+            }
+
+            for (const auto level : {krrs::reflect::simd::level::scalar, krrs::reflect::simd::level::sse2, krrs::reflect::simd::level::avx2})
+            {
+                EXPECT_EQ(krrs::json::internal::select_find_escape(level)(text.data(), text.size()), at) << "length " << length << " level " << static_cast<int>(level);
+            }
+
+            std::string json;
+            krrs::json::writer{json}.write_string(text);
+            std::string decoded;
+            krrs::json::reader::unescape(krrs::json::reader{json}.read_raw_string(), decoded);
+            EXPECT_EQ(decoded, text);
+        }
+    }
+}
+
+TEST(test_json_serialization, max_serialized_size_bounds_fixed_size_types)
+{
+    static_assert(krrs::json::concepts::fixed_size<mocks::json_point>);
+    static_assert(krrs::json::concepts::fixed_size<mocks::json_fixed_order>);
+    static_assert(!krrs::json::concepts::fixed_size<mocks::json_path>);
+    static_assert(!krrs::json::concepts::fixed_size<mocks::json_owning>);
+
+    // {"x": -2147483648, "y": -2.2250738585072014e-308}
+    static_assert(krrs::json::max_serialized_size<mocks::json_point>() == 2 + 5 + 11 + 7 + 24);
+    static_assert(krrs::json::max_serialized_size<mocks::json_side>() == std::string_view{"\"<unknown>\""}.size());
+
+    // the longest value of every member, written into a buffer reserved up front must not regrow it
+    const mocks::json_fixed_order worst{
+        .id = std::numeric_limits<int64_t>::min(),
+        .price = -std::numeric_limits<double>::min(),
+        .quantity = -std::numeric_limits<float>::min(),
+        .side = static_cast<mocks::json_side>(200),
+        .venue = static_cast<mocks::json_venue_id>(std::numeric_limits<int16_t>::min()),
+        .flags = {255, 255, 255},
+        .anchor = mocks::json_point{std::numeric_limits<int>::min(), -std::numeric_limits<double>::min()},
+        .active = false,
+        .tag = '\x01',
+    };
+
+    std::string out;
+    krrs::json::convert_to_json(worst, out);
+    const std::size_t reserved = out.capacity();
+    EXPECT_EQ(krrs::json::estimated_size(worst), krrs::json::max_serialized_size<mocks::json_fixed_order>());
+    EXPECT_LE(out.size(), krrs::json::max_serialized_size<mocks::json_fixed_order>());
+    EXPECT_GE(reserved, krrs::json::max_serialized_size<mocks::json_fixed_order>());
+
+    // enums round-trip by name (or by value without ENUM_PRINTABLE), arrays element by element
+    mocks::json_fixed_order order{};
+    order.side = mocks::json_side::SELL;
+    order.venue = static_cast<mocks::json_venue_id>(-3);
+    order.flags = {1, 2, 3};
+    const std::string json = krrs::json::convert_to_json(order);
+    EXPECT_THAT(json, HasSubstr(R"("side": "SELL", "venue": -3, "flags": [1, 2, 3])"));
+
+    mocks::json_fixed_order decoded{};
+    krrs::json::convert_from_json(decoded, json);
+    EXPECT_EQ(decoded.side, mocks::json_side::SELL);
+    EXPECT_EQ(decoded.venue, order.venue);
+    EXPECT_EQ(decoded.flags, order.flags);
+}
+
+TEST(test_json_serialization, estimated_size_covers_containers)
+{
+    mocks::json_owning obj{};
+    obj.name = "alice";
+    obj.tags = {"a", "bb", "ccc"};
+    obj.registry = {{"k", 1}};
+    obj.path.points = {{1, 2.0}, {3, 4.0}};
+
+    // an upper bound unless strings need escaping, without overshooting wildly
+    const std::string json = krrs::json::convert_to_json(obj);
+    EXPECT_GE(krrs::json::estimated_size(obj), json.size());
+    EXPECT_LE(krrs::json::estimated_size(obj), json.size() * 4);
+
+}
+
+TEST(test_json_serialization, borrowed_document_decodes_string_views)
+{
+    static_assert(krrs::json::internal::has_borrowed_strings<mocks::json_borrowed>());
+    static_assert(!krrs::json::internal::has_borrowed_strings<mocks::json_owning>());
+
+    krrs::json::borrowed_document document{R"({"venue": "XNAS", "tags": ["a", "b\"c"], "note": "line\nbreak", "quantity": 3})"};
+    const auto decoded = document.decode<mocks::json_borrowed>();
+    const std::string_view json = document.json();
+    const auto borrowed_from = [&json](std::string_view view) { return view.data() >= json.data() && view.data() + view.size() <= json.data() + json.size(); };
+
+    // clean strings point straight into the document, unescaped ones into its arena
+    EXPECT_EQ(decoded.venue, "XNAS");
+    EXPECT_TRUE(borrowed_from(decoded.venue));
+    ASSERT_EQ(decoded.tags.size(), 2u);
+    EXPECT_TRUE(borrowed_from(decoded.tags[0]));
+    EXPECT_EQ(decoded.tags[1], "b\"c");
+    EXPECT_FALSE(borrowed_from(decoded.tags[1]));
+    EXPECT_EQ(decoded.note, std::optional<std::string_view>{"line\nbreak"});
+    EXPECT_EQ(decoded.quantity, 3);
+
+    // the document is reused for the next message, enough escaped strings to spill over several arena chunks
+    mocks::json_borrowed original{};
+    std::vector<std::string> escaped;
+    for (int i = 0; i != 300; ++i)
+    {
+        escaped.push_back("\"" + std::to_string(i) + std::string(40, '\\'));
+    }
+    original.tags.assign(escaped.begin(), escaped.end());
+    document.assign(krrs::json::convert_to_json(original));
+
+    mocks::json_borrowed reused{};
+    document.decode(reused);
+    ASSERT_EQ(reused.tags.size(), escaped.size());
+    for (std::size_t i = 0; i != escaped.size(); ++i)
+    {
+        EXPECT_EQ(reused.tags[i], escaped[i]);
+    }
+
+    // the plain reader has nowhere to keep the strings
+    krrs::json::reader r{R"({"venue": "XNAS"})"};
+    mocks::json_borrowed unbacked{};
+    EXPECT_THROW(krrs::json::convert_from_json(unbacked, r), std::runtime_error);
+}
+
+TEST(test_json_serialization, serialize_through_sinks)
+{
+    mocks::json_owning record{};
+    record.count = 7;
+    record.name = std::string(3000, 'n');
+    record.tags = {"short", std::string(1500, 't'), "quoted \"tag\""};
+    record.path.points = {{1, 0.5}, {2, 0.25}};
+    const std::string expected = krrs::json::serialize(record);
+
+    const auto read_back = [](std::FILE* file) {
+        std::string contents(static_cast<std::size_t>(std::ftell(file)), '\0');
+        std::rewind(file);
+        EXPECT_EQ(std::fread(contents.data(), 1, contents.size(), file), contents.size());
+        return contents;
+    };
+
+    // a tiny staging buffer and many records force flushes mid-record, the long strings go out as borrowed iovecs
+    std::FILE* file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    {
+        krrs::io::fd_sink sink{fileno(file), 64};
+        for (int i = 0; i != 50; ++i)
+        {
+            krrs::json::serialize(record, sink);
+        }
+    }
+    std::fseek(file, 0, SEEK_END);
+    std::string repeated;
+    for (int i = 0; i != 50; ++i)
+    {
+        repeated += expected;
+    }
+    EXPECT_EQ(read_back(file), repeated);
+    std::fclose(file);
+
+    file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    krrs::io::file_sink stdio_sink{file};
+    krrs::json::convert_to_json(record, stdio_sink);
+    stdio_sink.flush();
+    EXPECT_EQ(read_back(file), krrs::json::convert_to_json(record));
+    std::fclose(file);
+
+    // a fixed buffer never allocates, and refuses to overflow
+    std::array<char, 64> storage{};
+    krrs::io::buffer_sink fixed{storage.data(), storage.size()};
+    krrs::json::convert_to_json(mocks::json_point{3, 1.5}, fixed);
+    EXPECT_EQ(fixed.view(), R"({"x": 3, "y": 1.5})");
+    fixed.clear();
+    EXPECT_THROW(krrs::json::serialize(record, fixed), std::runtime_error);
+
+    EXPECT_THROW(krrs::io::fd_sink{-1}, std::invalid_argument);
+}
+
 } // namespace tests
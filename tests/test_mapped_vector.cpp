@@ -0,0 +1,191 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#include "../include/storage/mapped_vector.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unistd.h>
+#include <vector>
+
+namespace tests {
+
+using namespace ::testing;
+
+namespace mocks {
+
+struct snapshot_position
+{
+    double bod_position;
+    double position;
+    double buy_quantity;
+    double sell_quantity;
+
+    REFLECT_PRINTABLE(snapshot_position, (), (bod_position, position, buy_quantity, sell_quantity));
+};
+
+struct snapshot_key
+{
+    uint32_t account;
+    std::array<char, 12> symbol;
+
+    REFLECT(snapshot_key, (), (account, symbol));
+};
+
+struct snapshot_row : snapshot_key
+{
+    snapshot_position pos;
+    int64_t timestamp;
+
+    double net() const
+    {
+        return pos.buy_quantity - pos.sell_quantity;
+    }
+
+    REFLECT(snapshot_row, (snapshot_key), (pos, timestamp, net));
+};
+
+// snapshot_position with another member order, so another schema
+struct snapshot_position_v2
+{
+    double position;
+    double bod_position;
+    double buy_quantity;
+    double sell_quantity;
+
+    REFLECT(snapshot_position_v2, (), (position, bod_position, buy_quantity, sell_quantity));
+};
+
+struct with_pointer
+{
+    const char* name;
+
+    REFLECT(with_pointer, (), (name));
+};
+
+struct with_string
+{
+    std::string name;
+
+    REFLECT(with_string, (), (name));
+};
+
+} // namespace mocks
+
+static_assert(krrs::storage::concepts::record<mocks::snapshot_position>);
+static_assert(krrs::storage::concepts::record<mocks::snapshot_row>);
+static_assert(!krrs::storage::concepts::record<mocks::with_pointer>);
+static_assert(!krrs::storage::concepts::record<mocks::with_string>);
+
+class test_mapped_vector : public Test
+{
+protected:
+    void SetUp() override
+    {
+        path_ = (std::filesystem::temp_directory_path() / ("test_mapped_vector_" + std::to_string(::getpid()) + ".bin")).string();
+        std::filesystem::remove(path_);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove(path_);
+    }
+
+    std::string path_;
+};
+
+TEST_F(test_mapped_vector, append_and_reopen)
+{
+    constexpr std::size_t count = 5000;
+    {
+        krrs::storage::mapped_vector<mocks::snapshot_row> rows{path_};
+        EXPECT_TRUE(rows.empty());
+        for (std::size_t i = 0; i != count; ++i)
+        {
+            const auto value = static_cast<double>(i);
+            rows.push_back({{static_cast<uint32_t>(i % 7), {'A', 'B', 'C'}}, {value, value + 1, value * 2, 0.5}, static_cast<int64_t>(i)});
+        }
+        EXPECT_EQ(rows.size(), count);
+        EXPECT_GE(rows.capacity(), count);
+        rows.flush();
+    }
+    // trimmed to the header plus the records on close
+    EXPECT_EQ(std::filesystem::file_size(path_), 64 + count * sizeof(mocks::snapshot_row));
+
+    const krrs::storage::mapped_vector<mocks::snapshot_row> rows{path_, krrs::storage::open_mode::read_only};
+    ASSERT_EQ(rows.size(), count);
+    EXPECT_EQ(rows[4321].account, 4321u % 7);
+    EXPECT_EQ(std::string_view(rows[4321].symbol.data()), "ABC");
+    EXPECT_DOUBLE_EQ(rows[4321].pos.buy_quantity, 8642.0);
+    EXPECT_DOUBLE_EQ(rows[4321].net(), 8641.5);
+    EXPECT_EQ(rows.records_view().back().timestamp, static_cast<int64_t>(count - 1));
+
+    int64_t total = 0;
+    for (const mocks::snapshot_row& row : rows)
+    {
+        total += row.timestamp;
+    }
+    EXPECT_EQ(total, static_cast<int64_t>(count * (count - 1) / 2));
+}
+
+TEST_F(test_mapped_vector, append_after_reopen)
+{
+    {
+        krrs::storage::mapped_vector<mocks::snapshot_position> positions{path_};
+        positions.push_back({1.0, 3.0, 4.0, 2.0});
+    }
+    {
+        krrs::storage::mapped_vector<mocks::snapshot_position> positions{path_};
+        ASSERT_EQ(positions.size(), 1u);
+        positions.reserve(10);
+        EXPECT_GE(positions.capacity(), 10u);
+        positions.push_back({2.0, 5.0, 3.0, 0.0});
+    }
+
+    krrs::storage::mapped_vector<mocks::snapshot_position> positions{path_, krrs::storage::open_mode::read_only};
+    ASSERT_EQ(positions.size(), 2u);
+    EXPECT_DOUBLE_EQ(positions[0].position, 3.0);
+    EXPECT_DOUBLE_EQ(positions[1].position, 5.0);
+    EXPECT_THROW(positions.push_back({}), std::runtime_error);
+
+    // moved from objects release nothing
+    auto moved = std::move(positions);
+    EXPECT_EQ(moved.size(), 2u);
+    EXPECT_EQ(positions.size(), 0u);
+    EXPECT_TRUE(positions.empty());
+    EXPECT_EQ(positions.capacity(), 0u);
+    EXPECT_TRUE(positions.records_view().empty());
+}
+
+TEST_F(test_mapped_vector, rejects_mismatched_files)
+{
+    EXPECT_THROW(krrs::storage::mapped_vector<mocks::snapshot_position>(path_, krrs::storage::open_mode::read_only), std::runtime_error);
+
+    {
+        krrs::storage::mapped_vector<mocks::snapshot_position> positions{path_};
+        positions.push_back({1.0, 3.0, 4.0, 2.0});
+    }
+    // same size, another member order
+    EXPECT_THROW(krrs::storage::mapped_vector<mocks::snapshot_position_v2>(path_, krrs::storage::open_mode::read_only), std::runtime_error);
+    EXPECT_THROW(krrs::storage::mapped_vector<mocks::snapshot_position_v2>{path_}, std::runtime_error);
+
+    // a header claiming more records than the file holds
+    std::filesystem::resize_file(path_, 64 + sizeof(mocks::snapshot_position) / 2);
+    EXPECT_THROW(krrs::storage::mapped_vector<mocks::snapshot_position>(path_, krrs::storage::open_mode::read_only), std::runtime_error);
+
+    {
+        std::ofstream out{path_, std::ios::binary | std::ios::trunc};
+        out << std::string(128, 'x');
+    }
+    EXPECT_THROW(krrs::storage::mapped_vector<mocks::snapshot_position>(path_, krrs::storage::open_mode::read_only), std::runtime_error);
+}
+
+} // namespace tests
@@ -0,0 +1,268 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#include "../include/msgpack/parser.hpp"
+#include "../include/reflect/schema.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace tests {
+
+using namespace ::testing;
+
+namespace mocks {
+
+enum class msgpack_side : int8_t
+{
+    BUY = 1,
+    SELL = -1,
+};
+
+struct msgpack_point
+{
+    int32_t x;
+    double y;
+
+    bool operator==(const msgpack_point&) const = default;
+
+    REFLECT(msgpack_point, (), (x, y));
+};
+
+struct msgpack_header
+{
+    std::string venue;
+    uint64_t sequence;
+
+    bool operator==(const msgpack_header&) const = default;
+
+    REFLECT(msgpack_header, (), (venue, sequence));
+};
+
+struct msgpack_book : msgpack_header
+{
+    char letter;
+    bool active;
+    float ratio;
+    msgpack_side side;
+    std::array<int16_t, 3> flags;
+    std::vector<double> levels;
+    std::vector<msgpack_point> points;
+    std::unordered_map<std::string, int64_t> counters;
+    std::optional<std::string> note;
+    std::vector<std::optional<int>> gaps;
+
+    bool operator==(const msgpack_book&) const = default;
+
+    REFLECT(msgpack_book, (msgpack_header), (letter, active, ratio, side, flags, levels, points, counters, note, gaps));
+};
+
+struct msgpack_switches
+{
+    std::vector<bool> on;
+    std::vector<std::vector<bool>> grid;
+
+    bool operator==(const msgpack_switches&) const = default;
+
+    REFLECT(msgpack_switches, (), (on, grid));
+};
+
+// msgpack_point as another service might define it
+struct msgpack_point_v2
+{
+    double y;
+    int64_t x;
+    std::optional<std::string> label;
+
+    REFLECT(msgpack_point_v2, (), (y, x, label));
+};
+
+} // namespace mocks
+
+TEST(test_msgpack, wire_format_follows_the_spec)
+{
+    // fixmap of 2, fixstr keys, positive fixint and float64
+    const mocks::msgpack_point point{1, 0.5};
+    const std::string expected{"\x82\xA1x\x01\xA1y\xCB\x3F\xE0\x00\x00\x00\x00\x00\x00", 15};
+    EXPECT_EQ(krrs::msgpack::serialize(point), expected);
+    EXPECT_EQ(krrs::msgpack::deserialize<mocks::msgpack_point>(expected), point);
+
+    // the array layout drops the keys
+    const std::string expected_array{"\x92\x01\xCB\x3F\xE0\x00\x00\x00\x00\x00\x00", 11};
+    EXPECT_EQ(krrs::msgpack::serialize<krrs::msgpack::layout::array>(point), expected_array);
+    EXPECT_EQ((krrs::msgpack::deserialize<mocks::msgpack_point, krrs::msgpack::layout::array>(expected_array)), point);
+
+    // integers always take the smallest format
+    std::string out;
+    krrs::msgpack::writer w{out};
+    w.write_integer(-32);
+    w.write_integer(-33);
+    w.write_integer(200);
+    w.write_integer(-129);
+    w.write_integer(70000);
+    w.write_integer(std::numeric_limits<int64_t>::min());
+    w.write_integer(std::numeric_limits<uint64_t>::max());
+    const std::string integers{"\xE0"
+                               "\xD0\xDF"
+                               "\xCC\xC8"
+                               "\xD1\xFF\x7F"
+                               "\xCE\x00\x01\x11\x70"
+                               "\xD3\x80\x00\x00\x00\x00\x00\x00\x00"
+                               "\xCF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF",
+                               31};
+    EXPECT_EQ(out, integers);
+
+    // str8 past 31 characters, nil for an empty optional
+    mocks::msgpack_header header{std::string(40, 'v'), 0};
+    const std::string encoded = krrs::msgpack::serialize(header);
+    EXPECT_EQ(encoded.substr(0, 9), std::string{"\x82\xA5venue\xD9\x28"});
+    std::optional<int> nothing;
+    out.clear();
+    krrs::msgpack::internal::write_value<krrs::msgpack::layout::map>(w, nothing);
+    EXPECT_EQ(out, "\xC0");
+}
+
+TEST(test_msgpack, round_trip)
+{
+    mocks::msgpack_book book{};
+    book.venue = "XNAS";
+    book.sequence = std::numeric_limits<uint64_t>::max();
+    book.letter = 'q';
+    book.active = true;
+    book.ratio = 0.25f;
+    book.side = mocks::msgpack_side::SELL;
+    book.flags = {-1, 0, std::numeric_limits<int16_t>::max()};
+    book.levels = {101.25, -0.0, std::numeric_limits<double>::denorm_min()};
+    book.points.assign(20, {-7, 2.5});
+    book.counters = {{"orders", 1200}, {"cancels", std::numeric_limits<int64_t>::min()}};
+    book.note = std::string(70000, 'n');
+    book.gaps = {std::nullopt, 4};
+
+    for (const std::string& bytes : {krrs::msgpack::serialize(book), krrs::msgpack::serialize<krrs::msgpack::layout::array>(book)})
+    {
+        SCOPED_TRACE(bytes.size());
+        const bool keyed = static_cast<unsigned char>(bytes.front()) == 0x8C;
+        const mocks::msgpack_book decoded = keyed ? krrs::msgpack::deserialize<mocks::msgpack_book>(bytes)
+                                                  : krrs::msgpack::deserialize<mocks::msgpack_book, krrs::msgpack::layout::array>(bytes);
+        EXPECT_EQ(decoded, book);
+    }
+
+    // the array layout is only safe when both sides agree on the schema
+    static_assert(krrs::reflect::schema_hash<mocks::msgpack_point>() != krrs::reflect::schema_hash<mocks::msgpack_point_v2>());
+}
+
+TEST(test_msgpack, vector_of_bool_round_trips)
+{
+    const mocks::msgpack_switches switches{{true, false, false, true, true}, {{}, {false}, {true, true, false}}};
+    EXPECT_EQ(krrs::msgpack::deserialize<mocks::msgpack_switches>(krrs::msgpack::serialize(switches)), switches);
+    EXPECT_EQ((krrs::msgpack::deserialize<mocks::msgpack_switches, krrs::msgpack::layout::array>(krrs::msgpack::serialize<krrs::msgpack::layout::array>(switches))),
+              switches);
+}
+
+TEST(test_msgpack, map_layout_tolerates_schema_changes)
+{
+    // keys are matched by name, members missing from the input keep their value and unknown keys are skipped
+    mocks::msgpack_point_v2 upgraded{};
+    upgraded.label = "kept";
+    const std::string bytes = krrs::msgpack::serialize(mocks::msgpack_point{-4, 8.5});
+    krrs::msgpack::reader r{bytes};
+    krrs::msgpack::convert_from_msgpack(upgraded, r);
+    EXPECT_TRUE(r.at_end());
+    EXPECT_EQ(upgraded.x, -4);
+    EXPECT_EQ(upgraded.y, 8.5);
+    EXPECT_EQ(upgraded.label, std::optional<std::string>{"kept"});
+
+    upgraded.label = "dropped";
+    const auto downgraded = krrs::msgpack::deserialize<mocks::msgpack_point>(krrs::msgpack::serialize(upgraded));
+    EXPECT_EQ(downgraded, (mocks::msgpack_point{-4, 8.5}));
+
+    // nested containers under an unknown key are skipped as a whole
+    const mocks::msgpack_book book{{"XLON", 3}, 'a', false, 1.0f, mocks::msgpack_side::BUY, {}, {1.0}, {{1, 1.0}}, {{"x", 1}}, "n", {1}};
+    mocks::msgpack_header header{};
+    const std::string book_bytes = krrs::msgpack::serialize(book);
+    krrs::msgpack::reader book_reader{book_bytes};
+    krrs::msgpack::convert_from_msgpack(header, book_reader);
+    EXPECT_TRUE(book_reader.at_end());
+    EXPECT_EQ(header, (mocks::msgpack_header{"XLON", 3}));
+}
+
+TEST(test_msgpack, serialize_through_sinks)
+{
+    mocks::msgpack_book book{};
+    book.venue = std::string(2000, 'v');
+    book.note = std::string(1000, 'n');
+    book.points.assign(100, {1, 2.0});
+    const std::string expected = krrs::msgpack::serialize(book);
+
+    // the large strings are handed to writev straight out of book
+    std::FILE* file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    {
+        krrs::io::fd_sink sink{fileno(file), 64};
+        krrs::msgpack::serialize(book, sink);
+        krrs::msgpack::serialize(book, sink);
+    }
+    std::string contents(expected.size() * 2, '\0');
+    std::rewind(file);
+    EXPECT_EQ(std::fread(contents.data(), 1, contents.size(), file), contents.size());
+    std::fclose(file);
+    EXPECT_EQ(contents, expected + expected);
+}
+
+TEST(test_msgpack, malformed_input_throws)
+{
+    const std::string bytes = krrs::msgpack::serialize(mocks::msgpack_point{1000, 0.5});
+
+    // truncated at every offset
+    for (std::size_t size = 0; size != bytes.size(); ++size)
+    {
+        EXPECT_THROW(krrs::msgpack::deserialize<mocks::msgpack_point>(bytes.substr(0, size)), std::runtime_error) << "size " << size;
+    }
+    EXPECT_THROW(krrs::msgpack::deserialize<mocks::msgpack_point>(bytes + '\xC0'), std::runtime_error);
+
+    // the wrong layout, or a value of the wrong type
+    EXPECT_THROW(krrs::msgpack::deserialize<mocks::msgpack_point>(krrs::msgpack::serialize<krrs::msgpack::layout::array>(mocks::msgpack_point{})),
+                 std::runtime_error);
+    EXPECT_THROW(krrs::msgpack::deserialize<mocks::msgpack_point>(std::string{"\x81\xA1x\xA1q", 5}), std::runtime_error);
+
+    // integers that do not fit the member
+    EXPECT_THROW(krrs::msgpack::deserialize<mocks::msgpack_point>(std::string{"\x81\xA1x\xCF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF", 12}), std::runtime_error);
+    EXPECT_EQ(krrs::msgpack::deserialize<mocks::msgpack_point>(std::string{"\x81\xA1x\xD0\x80", 5}).x, -128);
+
+    // a length claiming more than the input holds
+    EXPECT_THROW(krrs::msgpack::deserialize<mocks::msgpack_header>(std::string{"\x81\xA5venue\xDB\xFF\xFF\xFF\xFF", 12}), std::runtime_error);
+}
+
+TEST(test_msgpack, integers_decode_into_floating_point_members)
+{
+    // other encoders write whole doubles as integers
+    const auto y_of = [](std::string_view value) {
+        return krrs::msgpack::deserialize<mocks::msgpack_point>(std::string{"\x81\xA1y", 3} + std::string{value}).y;
+    };
+    EXPECT_EQ(y_of(std::string_view{"\x05", 1}), 5.0);
+    EXPECT_EQ(y_of(std::string_view{"\x7F", 1}), 127.0);
+    EXPECT_EQ(y_of(std::string_view{"\xFF", 1}), -1.0);
+    EXPECT_EQ(y_of(std::string_view{"\xE0", 1}), -32.0);
+    EXPECT_EQ(y_of(std::string_view{"\xCC\xC8", 2}), 200.0);
+    EXPECT_EQ(y_of(std::string_view{"\xD0\x80", 2}), -128.0);
+    EXPECT_EQ(y_of(std::string_view{"\xD1\xFF\x7F", 3}), -129.0);
+    EXPECT_EQ(y_of(std::string_view{"\xD2\xFF\xFE\xEE\x90", 5}), -70000.0);
+    EXPECT_EQ(y_of(std::string_view{"\xD3\x80\x00\x00\x00\x00\x00\x00\x00", 9}), static_cast<double>(std::numeric_limits<int64_t>::min()));
+    EXPECT_EQ(y_of(std::string_view{"\xCF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF", 9}), static_cast<double>(std::numeric_limits<uint64_t>::max()));
+
+    const std::string negative{"\xFF", 1};
+    krrs::msgpack::reader r{negative};
+    EXPECT_EQ(r.read_float<float>(), -1.0f);
+    EXPECT_TRUE(r.at_end());
+}
+
+} // namespace tests
@@ -0,0 +1,213 @@
+// Copyright (c) 2025 KiryuRS
+// SPDX-License-Identifier: MIT
+
+#include "../include/protowire/convert.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace tests {
+
+using namespace ::testing;
+
+namespace mocks {
+
+enum class proto_side : int32_t
+{
+    UNKNOWN = 0,
+    BUY = 1,
+    SELL = 2,
+};
+
+// message test1 { int32 a = 1; string b = 2; repeated int32 d = 4 [packed = true]; }, d moved by an override
+struct proto_example
+{
+    int32_t a;
+    std::string b;
+    std::vector<int32_t> d;
+
+    bool operator==(const proto_example&) const = default;
+
+    REFLECT(proto_example, (), (a, b, d));
+};
+
+struct proto_level
+{
+    double price;
+    int64_t size;
+
+    bool operator==(const proto_level&) const = default;
+
+    REFLECT(proto_level, (), (price, size));
+};
+
+struct proto_header
+{
+    std::string venue;
+    uint64_t sequence;
+
+    bool operator==(const proto_header&) const = default;
+
+    REFLECT(proto_header, (), (venue, sequence));
+};
+
+struct proto_book : proto_header
+{
+    proto_side side;
+    bool active;
+    float ratio;
+    char letter;
+    std::vector<double> bids;
+    std::vector<bool> flags;
+    std::vector<proto_level> levels;
+    std::vector<std::string> tags;
+    std::unordered_map<std::string, int32_t> counters;
+    std::optional<int32_t> limit;
+    std::optional<proto_level> best;
+    proto_level last;
+
+    int64_t total_size() const
+    {
+        return last.size;
+    }
+
+    bool operator==(const proto_book&) const = default;
+
+    REFLECT(proto_book, (proto_header), (side, active, ratio, letter, bids, flags, levels, tags, counters, limit, best, last, total_size));
+};
+
+} // namespace mocks
+
+} // namespace tests
+
+template <>
+inline constexpr std::uint32_t krrs::protowire::field_number<&tests::mocks::proto_example::d> = 4;
+
+namespace tests {
+
+TEST(test_protowire, wire_format_matches_protobuf)
+{
+    // the examples from the protobuf encoding guide
+    const std::string a{"\x08\x96\x01", 3};
+    const std::string b{"\x12\x07testing", 9};
+    const std::string d{"\x22\x06\x03\x8E\x02\x9E\xA7\x05", 8};
+    const mocks::proto_example example{150, "testing", {3, 270, 86942}};
+    EXPECT_EQ(krrs::protowire::encode(example), a + b + d);
+    EXPECT_EQ(krrs::protowire::encoded_size(example), a.size() + b.size() + d.size());
+    EXPECT_EQ(krrs::protowire::decode<mocks::proto_example>(a + b + d), example);
+
+    // defaults are left out, negative int32 takes ten bytes like protobuf
+    EXPECT_EQ(krrs::protowire::encode(mocks::proto_example{}), "");
+    EXPECT_EQ(krrs::protowire::encode(mocks::proto_example{-1, "", {}}), std::string("\x08\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\x01", 11));
+
+    // field numbers follow the descriptor index, base class members first, member functions are skipped
+    static_assert(krrs::protowire::internal::field_numbers<mocks::proto_book>[0] == 1);
+    static_assert(krrs::protowire::internal::field_numbers<mocks::proto_book>[13] == 14);
+    static_assert(krrs::protowire::internal::field_numbers<mocks::proto_book>[14] == 0);
+    static_assert(krrs::protowire::internal::field_numbers<mocks::proto_example>[2] == 4);
+    static_assert(krrs::protowire::internal::member_index<mocks::proto_example>(4) == 2);
+    static_assert(krrs::protowire::internal::member_index<mocks::proto_example>(3) == 3);
+}
+
+TEST(test_protowire, round_trip)
+{
+    mocks::proto_book book{};
+    book.venue = "XNAS";
+    book.sequence = std::numeric_limits<uint64_t>::max();
+    book.side = mocks::proto_side::SELL;
+    book.active = true;
+    book.ratio = -0.0f;
+    book.letter = 'q';
+    book.bids = {101.25, 101.0, -1.5};
+    book.flags = {true, false, true};
+    book.levels = {{1.5, 10}, {}, {2.5, -30}};
+    book.tags = {"", "a", std::string(200, 't')};
+    book.counters = {{"orders", 1200}, {"", 0}, {"cancels", std::numeric_limits<int32_t>::min()}};
+    book.limit = 0;
+    book.best = mocks::proto_level{};
+    book.last = {99.0, 1};
+
+    const std::string bytes = krrs::protowire::encode(book);
+    EXPECT_EQ(bytes.size(), krrs::protowire::encoded_size(book));
+    EXPECT_EQ(krrs::protowire::decode<mocks::proto_book>(bytes), book);
+
+    // decoding merges: repeated fields append and fields missing from the input keep their value
+    mocks::proto_book merged = book;
+    krrs::protowire::decode(merged, krrs::protowire::encode(mocks::proto_header{"XLON", 0}));
+    EXPECT_EQ(merged.venue, "XLON");
+    EXPECT_EQ(merged.sequence, book.sequence);
+    krrs::protowire::decode(merged, bytes);
+    EXPECT_EQ(merged.bids.size(), 6u);
+    EXPECT_EQ(merged.venue, "XNAS");
+}
+
+TEST(test_protowire, decodes_unpacked_and_unknown_fields)
+{
+    // repeated int32 d = 4 sent unpacked, an unknown fixed32 field 9 and an unknown message field 10 in between
+    const std::string bytes{"\x20\x03"
+                            "\x4D\x01\x02\x03\x04"
+                            "\x52\x02\x08\x01"
+                            "\x20\x8E\x02",
+                            14};
+    const auto example = krrs::protowire::decode<mocks::proto_example>(bytes);
+    EXPECT_EQ(example.d, (std::vector<int32_t>{3, 270}));
+
+    // a message written by the header alone reads into the derived type
+    const auto book = krrs::protowire::decode<mocks::proto_book>(krrs::protowire::encode(mocks::proto_header{"XNYS", 7}));
+    EXPECT_EQ(book.venue, "XNYS");
+    EXPECT_EQ(book.sequence, 7u);
+}
+
+TEST(test_protowire, encode_through_sinks)
+{
+    mocks::proto_book book{};
+    book.venue = std::string(2000, 'v');
+    book.bids.assign(1000, 3.5);
+    book.levels.assign(20, {1.0, 2});
+    const std::string expected = krrs::protowire::encode(book);
+
+    // the large string and the packed doubles are handed to writev straight out of book
+    std::FILE* file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    {
+        krrs::io::fd_sink sink{fileno(file), 64};
+        krrs::protowire::encode(book, sink);
+        krrs::protowire::encode(book, sink);
+    }
+    std::string contents(expected.size() * 2, '\0');
+    std::rewind(file);
+    EXPECT_EQ(std::fread(contents.data(), 1, contents.size(), file), contents.size());
+    std::fclose(file);
+    EXPECT_EQ(contents, expected + expected);
+}
+
+TEST(test_protowire, malformed_input_throws)
+{
+    const mocks::proto_example example{150, "testing", {3, 270, 86942}};
+    const std::string bytes = krrs::protowire::encode(example);
+
+    // truncated inside a field
+    for (const std::size_t size : {1u, 2u, 4u, 8u, 13u, 19u})
+    {
+        EXPECT_THROW(krrs::protowire::decode<mocks::proto_example>(bytes.substr(0, size)), std::runtime_error) << "size " << size;
+    }
+
+    // field 0, a group, a wire type that does not match the member and a value that does not fit it
+    EXPECT_THROW(krrs::protowire::decode<mocks::proto_example>(std::string{"\x00\x01", 2}), std::runtime_error);
+    EXPECT_THROW(krrs::protowire::decode<mocks::proto_example>(std::string{"\x2B", 1}), std::runtime_error);
+    EXPECT_THROW(krrs::protowire::decode<mocks::proto_example>(std::string{"\x0A\x00", 2}), std::runtime_error);
+    EXPECT_THROW(krrs::protowire::decode<mocks::proto_example>(std::string{"\x08\x80\x80\x80\x80\x10", 6}), std::runtime_error);
+
+    // a length running past the end of the input
+    EXPECT_THROW(krrs::protowire::decode<mocks::proto_example>(std::string{"\x12\xFF\xFF\xFF\xFF\x0F", 6}), std::runtime_error);
+}
+
+} // namespace tests
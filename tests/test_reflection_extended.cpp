@@ -1,12 +1,272 @@
 // Copyright (c) 2025 KiryuRS
 // SPDX-License-Identifier: MIT
 
+#include "../include/reflect/aggregate.hpp"
+#include "../include/reflect/compare.hpp"
+#include "../include/reflect/hash.hpp"
+#include "../include/reflect/hot_cold.hpp"
+#include "../include/reflect/key_table.hpp"
+#include "../include/reflect/layout.hpp"
+#include "../include/reflect/numeric.hpp"
+#include "../include/reflect/perfect_hash.hpp"
+#include "../include/reflect/schema.hpp"
+#include "../include/reflect/soa_vector.hpp"
 #include "reflection_mocks.hpp"
 
 #include <gtest/gtest.h>
 
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <unordered_map>
+#include <unordered_set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace tests::mocks {
+
+struct fixed_price_quote
+{
+    double price;
+    float size;
+
+    REFLECT_PRINTABLE(fixed_price_quote, (), (price, size));
+};
+
+struct risk_key
+{
+    int32_t account;
+    int64_t instrument;
+
+    REFLECT(risk_key, (), (account, instrument));
+};
+
+// a mix of member sizes, so every kernel reads its member at an odd stride out of an array of structs
+struct risk_record : risk_key
+{
+    double position;
+    float weight;
+    int16_t bucket;
+    std::string desk;
+
+    REFLECT(risk_record, (risk_key), (position, weight, bucket, desk));
+};
+
+// price and quantity are read on every tick, the rest only when an order is amended or reported
+struct resting_order
+{
+    double price;
+    std::string notes;
+    int64_t quantity;
+    bool hidden;
+    int32_t venue;
+
+    REFLECT_PRINTABLE(resting_order, (), ((hot, price), (cold, notes), (hot, quantity), (cold, hidden), venue));
+};
+
+// two touching ints and nothing else, one block of bytes
+struct int_pair
+{
+    int32_t a;
+    int32_t b;
+
+    REFLECT(int_pair, (), (a, b));
+};
+
+struct limit_base
+{
+    int32_t level;
+    int32_t limit;
+
+    REFLECT(limit_base, (), (level, limit));
+};
+
+// level hides the member of the base class, both are reflected
+struct hidden_limit : limit_base
+{
+    int32_t level;
+    std::string note;
+
+    REFLECT(hidden_limit, (limit_base), (level, note));
+};
+
+// constructing or copying one throws while armed, so a container fails part way through growing
+struct fragile
+{
+    static inline bool armed = false;
+
+    fragile()
+    {
+        throw_if_armed();
+    }
+
+    fragile(const fragile&)
+    {
+        throw_if_armed();
+    }
+
+    fragile& operator=(const fragile&) = default;
+
+    static void throw_if_armed()
+    {
+        if (armed)
+        {
+            throw std::runtime_error{"fragile"};
+        }
+    }
+};
+
+struct fragile_record
+{
+    int32_t id;
+    std::string name;
+    fragile payload;
+
+    REFLECT(fragile_record, (), (id, name, (cold, payload)));
+};
+
+// declared in the order a message lists its fields, which leaves holes after side and flag
+struct padded_fill
+{
+    char side;
+    double price;
+    char flag;
+    int32_t quantity;
+    std::array<int32_t, 12> fills;
+
+    REFLECT(padded_fill, (), (side, price, flag, quantity, fills));
+};
+
+// versions of the same type, as a reader and a writer built at different times would see it
+namespace schema_v1 {
+
+struct quote
+{
+    double price;
+    float size;
+
+    REFLECT(quote, (), (price, size));
+};
+
+// holds itself through a container
+struct tree_node
+{
+    int32_t value;
+    std::vector<tree_node> children;
+
+    REFLECT(tree_node, (), (value, children));
+};
+
+} // namespace schema_v1
+
+namespace schema_v2 {
+
+struct quote
+{
+    double price;
+    float size;
+
+    REFLECT(quote, (), (price, size));
+};
+
+struct reordered_quote
+{
+    float size;
+    double price;
+
+    REFLECT(reordered_quote, (), (size, price));
+};
+
+} // namespace schema_v2
+
+namespace schema_v3 {
+
+struct quote
+{
+    double price;
+    double size;
+
+    REFLECT(quote, (), (price, size));
+};
+
+// holds itself through a container
+struct tree_node
+{
+    int64_t value;
+    std::vector<tree_node> children;
+
+    REFLECT(tree_node, (), (value, children));
+};
+
+} // namespace schema_v3
+
+} // namespace tests::mocks
+
+template <>
+inline constexpr int krrs::reflect::print_precision<tests::mocks::fixed_price_quote> = 3;
+
 namespace tests {
 
+namespace {
+
+// renders `name=` for the first member and `;name=` for the rest
+struct assignment_key_format
+{
+    static constexpr std::size_t token_size(std::string_view name, std::size_t index)
+    {
+        return (index == 0 ? 0 : 1) + name.size() + 1;
+    }
+
+    static constexpr char* write_token(char* out, std::string_view name, std::size_t index)
+    {
+        if (index != 0)
+        {
+            *out++ = ';';
+        }
+        out = std::ranges::copy(name, out).out;
+        *out++ = '=';
+        return out;
+    }
+};
+
+// "m000" ... "m127", backing storage for names at the 128 member limit
+constexpr auto synthetic_name_chars = [] {
+    std::array<char, 128 * 4> chars{};
+    for (std::size_t i = 0; i != 128; ++i)
+    {
+        chars[i * 4] = 'm';
+        chars[i * 4 + 1] = static_cast<char>('0' + i / 100);
+        chars[i * 4 + 2] = static_cast<char>('0' + (i / 10) % 10);
+        chars[i * 4 + 3] = static_cast<char>('0' + i % 10);
+    }
+    return chars;
+}();
+
+constexpr auto synthetic_names = [] {
+    std::array<std::string_view, 128> names{};
+    for (std::size_t i = 0; i != names.size(); ++i)
+    {
+        names[i] = std::string_view{synthetic_name_chars.data() + i * 4, 4};
+    }
+    return names;
+}();
+
+struct name_collector
+{
+    template <typename Descriptor>
+    static std::string_view invoke()
+    {
+        return Descriptor::name;
+    }
+};
+
+} // namespace
+
 TEST(test_reflection_extended, test_function_descriptor)
 {
     mocks::with_functions obj{
@@ -272,4 +532,574 @@ TEST(test_reflection_extended, test_derived)
     static_assert(std::same_as<desc_note::member_type, std::string_view>);
 }
 
+TEST(test_reflection_extended, test_member_names_and_key_table)
+{
+    // names and indices follow for_each order, base class members first
+    constexpr auto names = krrs::reflect::generate_member_names<mocks::derived_more>();
+    static_assert(names.size() == 11);
+    static_assert(names.front() == "name");
+    static_assert(names[5] == "weight");
+    static_assert(names.back() == "note");
+
+    using desc_note = krrs::reflect::descriptor_for<mocks::derived_more, &mocks::derived_more::note>;
+    using desc_l = krrs::reflect::descriptor_for<mocks::foo, &mocks::foo::l>;
+    static_assert(krrs::reflect::descriptor_index<mocks::derived_more, desc_note>() == 10);
+    static_assert(krrs::reflect::descriptor_index<mocks::foo, desc_l>() == 0);
+    // not part of derived_more, so the sentinel (size) is returned
+    static_assert(krrs::reflect::descriptor_index<mocks::derived_more, desc_l>() == names.size());
+
+    // tokens are pre-rendered with their separators, by index or by descriptor
+    using table = krrs::reflect::key_table<mocks::foo, assignment_key_format>;
+    static_assert(table::size == 4);
+    static_assert(table::token<0>() == "l=");
+    static_assert(table::token<1>() == ";i=");
+    static_assert(table::token<desc_l>() == "l=");
+
+    std::string rendered;
+    krrs::reflect::for_each<mocks::foo>([&rendered]<typename Descriptor>() { rendered += table::token<Descriptor>(); });
+    EXPECT_EQ(rendered, "l=;i=;s=;c=");
+}
+
+TEST(test_reflection_extended, test_perfect_hash_member_lookup)
+{
+    // every member resolves to its for_each index, anything else is rejected
+    constexpr auto& lookup = krrs::reflect::member_lookup<mocks::derived_more>;
+    static_assert(lookup.find("name") == 0);
+    static_assert(lookup.find("weight") == 5);
+    static_assert(lookup.find("note") == 10);
+    static_assert(lookup.find("nam") == lookup.npos);
+    static_assert(lookup.find("") == lookup.npos);
+    EXPECT_EQ(lookup.find(std::string{"priority"}), 6u);
+
+    // stays collision free at the 128 member limit
+    static constexpr auto table = krrs::reflect::make_perfect_hash(synthetic_names);
+    for (std::size_t i = 0; i != synthetic_names.size(); ++i)
+    {
+        EXPECT_EQ(table.find(synthetic_names[i]), i);
+    }
+    EXPECT_EQ(table.find("m128"), table.npos);
+
+    // jump table entries line up with the lookup indices
+    static constexpr auto names = krrs::reflect::make_jump_table<mocks::derived_more, std::string_view(), name_collector>();
+    EXPECT_EQ(names[lookup.find("kind")](), "kind");
+    EXPECT_EQ(names[lookup.find("active")](), "active");
+}
+
+TEST(test_reflection_extended, test_numeric_formatting)
+{
+    namespace numeric = krrs::reflect::numeric;
+
+    // shortest round-trip: as few digits as possible, yet parsing them back gives the exact same value
+    EXPECT_EQ(numeric::to_string(0.1), "0.1");
+    EXPECT_EQ(numeric::to_string(101.25), "101.25");
+    EXPECT_EQ(numeric::to_string(3.14f), "3.14");
+    EXPECT_EQ(numeric::to_string(-1e-7), "-1e-07");
+    EXPECT_EQ(numeric::to_string(std::numeric_limits<int64_t>::min()), "-9223372036854775808");
+    EXPECT_EQ(numeric::to_string(std::int8_t{-5}), "-5");
+    for (const double value : {0.1 + 0.2, 1.0 / 3.0, 6.02214076e23, std::numeric_limits<double>::max()})
+    {
+        EXPECT_EQ(numeric::parse<double>(numeric::to_string(value)), value);
+    }
+
+    // fixed notation, including values too long for the stack buffer
+    EXPECT_EQ(numeric::to_string(2.0, 3), "2.000");
+    EXPECT_EQ(numeric::to_string(0.0005, 3), "0.001");
+    EXPECT_EQ(numeric::to_string(1e300, 2).size(), 304u);
+
+    // parsing must consume the whole input
+    EXPECT_EQ(numeric::parse<int>("+42"), 42);
+    EXPECT_EQ(numeric::parse<int>("-42"), -42);
+    EXPECT_FALSE(numeric::parse<int>("3.5").has_value());
+    EXPECT_FALSE(numeric::parse<int>("+-1").has_value());
+    EXPECT_FALSE(numeric::parse<int>("").has_value());
+    EXPECT_FALSE(numeric::parse<std::uint8_t>("256").has_value());
+
+    // printable types use the shortest form unless print_precision asks for fixed decimals
+    EXPECT_EQ(to_string(mocks::fixed_price_quote{.price = 69.0, .size = 0.5f}), "{fixed_price_quote: {'price': 69.000, 'size': 0.500} }");
+}
+
+TEST(test_reflection_extended, test_schema_hash)
+{
+    // the namespace is not part of the fingerprint, the same members in the same order agree
+    static_assert(krrs::reflect::schema_hash<mocks::schema_v1::quote>() == krrs::reflect::schema_hash<mocks::schema_v2::quote>());
+    // a changed type, member order or declaring class does not
+    static_assert(krrs::reflect::schema_hash<mocks::schema_v1::quote>() != krrs::reflect::schema_hash<mocks::schema_v3::quote>());
+    static_assert(krrs::reflect::schema_hash<mocks::schema_v2::quote>() != krrs::reflect::schema_hash<mocks::schema_v2::reordered_quote>());
+    static_assert(krrs::reflect::schema_hash<mocks::base>() != krrs::reflect::schema_hash<mocks::derived_more>());
+    // a type reached again from inside itself is folded in by name, so the recursion ends
+    static_assert(krrs::reflect::schema_hash<mocks::schema_v1::tree_node>() != krrs::reflect::schema_hash<mocks::schema_v3::tree_node>());
+
+    // usable wherever a constant is, e.g. as a stream header
+    constexpr std::uint64_t fingerprint = krrs::reflect::schema_hash<mocks::with_functions>();
+    EXPECT_NE(fingerprint, 0u);
+}
+
+TEST(test_reflection_extended, test_soa_vector)
+{
+    krrs::reflect::soa_vector<mocks::derived_more> soa;
+    EXPECT_TRUE(soa.empty());
+    for (int i = 0; i != 100; ++i)
+    {
+        mocks::derived_more d{};
+        d.name = "entity" + std::to_string(i);
+        d.id = static_cast<uint32_t>(i);
+        d.score = i * 0.5;
+        d.active = i % 2 == 0;
+        d.x = -i;
+        soa.push_back(d);
+    }
+    ASSERT_EQ(soa.size(), 100u);
+
+    // each member is its own contiguous array, base class members included
+    const std::span<double> scores = soa.column<&mocks::base::score>();
+    EXPECT_EQ(std::accumulate(scores.begin(), scores.end(), 0.0), 2475.0);
+    const std::span<bool> active = soa.column<&mocks::base_2::active>();
+    EXPECT_EQ(std::count(active.begin(), active.end(), true), 50);
+    EXPECT_EQ(soa.column<&mocks::derived_more::x>().data() + 1, &soa[1].get<&mocks::derived_more::x>());
+
+    // proxies read and write the columns in place
+    soa[7].get<&mocks::derived_more::x>() = 700;
+    EXPECT_EQ(soa.column<&mocks::derived_more::x>()[7], 700);
+    const mocks::derived_more copy = soa[7];
+    EXPECT_EQ(copy.name, "entity7");
+    EXPECT_EQ(copy.x, 700);
+    EXPECT_FALSE(copy.active);
+
+    mocks::derived_more replacement = copy;
+    replacement.name = "replaced";
+    replacement.active = true;
+    soa[3] = replacement;
+    EXPECT_EQ(soa[3].get<&mocks::base::name>(), "replaced");
+    EXPECT_TRUE(soa[3].get<&mocks::base_2::active>());
+
+    int total = 0;
+    for (auto&& element : std::as_const(soa))
+    {
+        total += element.get<&mocks::derived_more::x>();
+    }
+    // x[7] went from -7 to 700, and x[3] from -3 to the 700 of its replacement
+    EXPECT_EQ(total, -4950 + 707 + 703);
+
+    soa.pop_back();
+    soa.resize(120);
+    EXPECT_EQ(soa.size(), 120u);
+    EXPECT_EQ(soa.column<&mocks::base::name>()[110], "");
+    EXPECT_FALSE(soa.column<&mocks::base_2::active>()[110]);
+    EXPECT_TRUE(soa.column<&mocks::base_2::active>()[98]);
+
+    // assigning one proxy to another copies the element, it does not rebind the proxy
+    soa[0] = soa[3];
+    EXPECT_EQ(soa[0].get<&mocks::base::name>(), "replaced");
+    EXPECT_EQ(soa[0].get<&mocks::derived_more::x>(), 700);
+    EXPECT_TRUE(soa[0].get<&mocks::base_2::active>());
+    auto first = soa.begin();
+    auto second = std::next(first);
+    *first = *second;
+    EXPECT_EQ(soa[0].get<&mocks::base::name>(), "entity1");
+    EXPECT_EQ(soa[0].get<&mocks::derived_more::x>(), -1);
+    EXPECT_EQ(soa[3].get<&mocks::base::name>(), "replaced");
+
+    const auto copied = soa;
+    soa.clear();
+    EXPECT_TRUE(soa.empty());
+    EXPECT_EQ(copied.size(), 120u);
+    EXPECT_EQ(copied[3].get<&mocks::base::name>(), "replaced");
+}
+
+TEST(test_reflection_extended, test_soa_vector_failed_growth)
+{
+    krrs::reflect::soa_vector<mocks::fragile_record> soa;
+    for (int32_t i = 0; i != 3; ++i)
+    {
+        soa.push_back({i, "record " + std::to_string(i), {}});
+    }
+
+    // id and name are appended before payload throws, and are cut back again
+    mocks::fragile_record failed{};
+    failed.id = 99;
+    failed.name = "failed";
+    mocks::fragile::armed = true;
+    EXPECT_THROW(soa.push_back(failed), std::runtime_error);
+    EXPECT_THROW(soa.resize(10), std::runtime_error);
+    mocks::fragile::armed = false;
+    ASSERT_EQ(soa.size(), 3u);
+
+    soa.push_back({3, "record 3", {}});
+    const mocks::fragile_record last = soa[3];
+    EXPECT_EQ(last.id, 3);
+    EXPECT_EQ(last.name, "record 3");
+    EXPECT_EQ(soa.column<&mocks::fragile_record::name>().data() + 3, &soa[3].get<&mocks::fragile_record::name>());
+}
+
+TEST(test_reflection_extended, test_aggregate)
+{
+    using krrs::reflect::simd::level;
+
+    // 1003 records, so every vector loop leaves a tail
+    std::vector<mocks::risk_record> records;
+    krrs::reflect::soa_vector<mocks::risk_record> soa;
+    for (int i = 0; i != 1003; ++i)
+    {
+        const mocks::risk_record r{{(i * 37) % 1000 - 500, int64_t{i} * 1'000'000'007}, (i % 17) * 0.25 - 2.0, static_cast<float>(i % 8), static_cast<int16_t>(i % 5), "desk"};
+        records.push_back(r);
+        soa.push_back(r);
+    }
+
+    for (const level requested : {level::scalar, level::avx2})
+    {
+        EXPECT_EQ(krrs::reflect::sum<&mocks::risk_record::position>(records, requested), krrs::reflect::sum<&mocks::risk_record::position>(soa, requested));
+        EXPECT_DOUBLE_EQ(krrs::reflect::sum<&mocks::risk_record::position>(records, requested),
+                         krrs::reflect::reduce<&mocks::risk_record::position>(records, 0.0, std::plus{}));
+        EXPECT_EQ(krrs::reflect::sum<&mocks::risk_record::weight>(records, requested), 3.5f * 1003 - 3.5f * 3 + 3.0f);
+        EXPECT_EQ(krrs::reflect::sum<&mocks::risk_key::instrument>(soa, requested), int64_t{1003 * 1002 / 2} * 1'000'000'007);
+        EXPECT_EQ(krrs::reflect::sum<&mocks::risk_record::bucket>(records, requested), 2003);
+
+        // int32 members are summed in 64 bits, and their extremes come back as int32
+        const int64_t accounts = krrs::reflect::sum<&mocks::risk_key::account>(records, requested);
+        EXPECT_EQ(accounts, krrs::reflect::reduce<&mocks::risk_key::account>(records, int64_t{0}, std::plus{}));
+        EXPECT_EQ(krrs::reflect::min<&mocks::risk_key::account>(records, requested), std::optional<int32_t>{-500});
+        EXPECT_EQ(krrs::reflect::max<&mocks::risk_key::account>(soa, requested), std::optional<int32_t>{499});
+        EXPECT_EQ(krrs::reflect::min<&mocks::risk_record::position>(soa, requested), std::optional<double>{-2.0});
+        EXPECT_EQ(krrs::reflect::max<&mocks::risk_record::position>(records, requested), std::optional<double>{2.0});
+        EXPECT_EQ(krrs::reflect::max<&mocks::risk_record::weight>(records, requested), std::optional<float>{7.0f});
+        EXPECT_EQ(krrs::reflect::min<&mocks::risk_key::instrument>(records, requested), std::optional<int64_t>{0});
+        EXPECT_EQ(krrs::reflect::max<&mocks::risk_key::instrument>(records, requested), std::optional<int64_t>{int64_t{1002} * 1'000'000'007});
+        EXPECT_EQ(krrs::reflect::min<&mocks::risk_record::bucket>(soa, requested), std::optional<int16_t>{0});
+    }
+
+    EXPECT_EQ(krrs::reflect::count_if<&mocks::risk_record::position>(records, [](double p) { return p < 0.0; }),
+              krrs::reflect::count_if<&mocks::risk_record::position>(soa, [](double p) { return p < 0.0; }));
+    EXPECT_EQ(krrs::reflect::count_if<&mocks::risk_record::desk>(std::span{records}.first(10), [](const std::string& d) { return d == "desk"; }), 10u);
+
+    const std::vector<mocks::risk_record> none;
+    EXPECT_EQ(krrs::reflect::sum<&mocks::risk_record::position>(none), 0.0);
+    EXPECT_FALSE(krrs::reflect::min<&mocks::risk_record::position>(none).has_value());
+}
+
+TEST(test_reflection_extended, test_hot_cold)
+{
+    using krrs::reflect::temperature;
+    using price_descriptor = krrs::reflect::detail::descriptor_for<mocks::resting_order, &mocks::resting_order::price>;
+    using notes_descriptor = krrs::reflect::detail::descriptor_for<mocks::resting_order, &mocks::resting_order::notes>;
+    using venue_descriptor = krrs::reflect::detail::descriptor_for<mocks::resting_order, &mocks::resting_order::venue>;
+    static_assert(krrs::reflect::temperature_of<price_descriptor> == temperature::hot);
+    static_assert(krrs::reflect::temperature_of<notes_descriptor> == temperature::cold);
+    static_assert(krrs::reflect::temperature_of<venue_descriptor> == temperature::hot);
+    EXPECT_EQ(notes_descriptor::name, "notes");
+
+    // annotations change nothing else about the type
+    const mocks::resting_order order{101.5, "iceberg", 300, true, 7};
+    std::ostringstream oss;
+    oss << order;
+    EXPECT_EQ(oss.str(), "{resting_order: {'price': 101.5, 'notes': iceberg, 'quantity': 300, 'hidden': 1, 'venue': 7} }");
+
+    krrs::reflect::hot_cold_vector<mocks::resting_order> book;
+    static_assert(decltype(book)::hot_row_size < sizeof(mocks::resting_order));
+    EXPECT_TRUE(book.empty());
+    book.reserve(50);
+    for (int i = 0; i != 50; ++i)
+    {
+        book.push_back({100.0 + i, "order " + std::to_string(i), i * 10, i % 2 == 0, i % 3});
+    }
+    ASSERT_EQ(book.size(), 50u);
+
+    book[4].get<&mocks::resting_order::quantity>() += 5;
+    EXPECT_EQ(book[4].get<&mocks::resting_order::quantity>(), 45);
+    EXPECT_EQ(krrs::reflect::get_member_variable<notes_descriptor>(book[9]), "order 9");
+    krrs::reflect::get_member_variable<price_descriptor>(book[9]) = 0.5;
+
+    const mocks::resting_order copy = book[9];
+    EXPECT_EQ(copy.price, 0.5);
+    EXPECT_EQ(copy.notes, "order 9");
+    EXPECT_EQ(copy.quantity, 90);
+    EXPECT_FALSE(copy.hidden);
+    EXPECT_EQ(copy.venue, 0);
+
+    book[2] = order;
+    EXPECT_EQ(book[2].get<&mocks::resting_order::notes>(), "iceberg");
+    EXPECT_TRUE(book[2].get<&mocks::resting_order::hidden>());
+
+    book[1] = book[2];
+    EXPECT_EQ(book[1].get<&mocks::resting_order::notes>(), "iceberg");
+    EXPECT_EQ(book[1].get<&mocks::resting_order::quantity>(), 300);
+    book[2] = book[3];
+    EXPECT_EQ(book[2].get<&mocks::resting_order::notes>(), "order 3");
+    EXPECT_EQ(book[1].get<&mocks::resting_order::notes>(), "iceberg");
+
+    // code written against descriptors runs unchanged over every container
+    int64_t quantity = 0;
+    for (auto&& element : std::as_const(book))
+    {
+        quantity += krrs::reflect::get_member_variable<krrs::reflect::detail::descriptor_for<mocks::resting_order, &mocks::resting_order::quantity>>(element);
+    }
+    EXPECT_EQ(quantity, 10 * 49 * 50 / 2 + 5 - 10 + 300 - 20 + 30);
+
+    krrs::reflect::soa_vector<mocks::resting_order> soa;
+    soa.push_back(order);
+    EXPECT_EQ(krrs::reflect::get_member_variable<notes_descriptor>(soa[0]), "iceberg");
+
+    book.pop_back();
+    book.resize(60);
+    EXPECT_EQ(book.size(), 60u);
+    EXPECT_EQ(book[55].get<&mocks::resting_order::notes>(), "");
+    EXPECT_EQ(book[48].get<&mocks::resting_order::notes>(), "order 48");
+    book.clear();
+    EXPECT_TRUE(book.empty());
+}
+
+TEST(test_reflection_extended, test_hot_cold_failed_growth)
+{
+    krrs::reflect::hot_cold_vector<mocks::fragile_record> book;
+    static_assert(std::ranges::input_range<decltype(book)>);
+    for (int32_t i = 0; i != 3; ++i)
+    {
+        book.push_back({i, "record " + std::to_string(i), {}});
+    }
+
+    // payload is cold, so the hot row is already appended when growing the cold array throws
+    const mocks::fragile_record failed{99, "failed", {}};
+    mocks::fragile::armed = true;
+    EXPECT_THROW(book.push_back(failed), std::runtime_error);
+    EXPECT_THROW(book.resize(10), std::runtime_error);
+    mocks::fragile::armed = false;
+    ASSERT_EQ(book.size(), 3u);
+
+    book.push_back({3, "record 3", {}});
+    const mocks::fragile_record last = book[3];
+    EXPECT_EQ(last.id, 3);
+    EXPECT_EQ(last.name, "record 3");
+    EXPECT_EQ(book[2].get<&mocks::fragile_record::name>(), "record 2");
+}
+
+TEST(test_reflection_extended, test_layout_info)
+{
+    using fill_layout = krrs::reflect::layout_info<mocks::padded_fill>;
+    static_assert(fill_layout::size == 72);
+    static_assert(fill_layout::bytes_wasted == 10);
+    static_assert(fill_layout::suggested_size == 64 && fill_layout::bytes_saved_by_reordering == 8);
+    static_assert(fill_layout::suggested_order == std::array<std::string_view, 5>{"price", "fills", "quantity", "side", "flag"});
+
+    ASSERT_EQ(fill_layout::members.size(), 5u);
+    EXPECT_EQ(fill_layout::members[0].name, "side");
+    EXPECT_EQ(fill_layout::members[0].padding, 7u);
+    EXPECT_EQ(fill_layout::members[2].offset, offsetof(mocks::padded_fill, flag));
+    EXPECT_EQ(fill_layout::members[2].padding, 3u);
+    EXPECT_EQ(fill_layout::members[4].alignment, alignof(int32_t));
+    EXPECT_TRUE(fill_layout::members[4].straddles_cache_line);
+    EXPECT_EQ(fill_layout::cache_line_straddles, 1u);
+
+    const std::string report = fill_layout::report();
+    EXPECT_TRUE(report.starts_with("padded_fill: 72 bytes, 10 wasted, 64 in the suggested order (price, fills, quantity, side, flag)")) << report;
+    EXPECT_NE(report.find("      24    48      4        0  fills (straddles a cache line)"), std::string::npos) << report;
+
+    // base class members are placed within the derived object, member functions take no space
+    const mocks::derived_more derived{};
+    const auto* const bytes = reinterpret_cast<const char*>(&derived);
+    using derived_layout = krrs::reflect::layout_info<mocks::derived_more>;
+    std::size_t index = 0;
+    for (const krrs::reflect::member_layout& member : derived_layout::members)
+    {
+        EXPECT_GE(member.offset, index);
+        index = member.offset + member.size;
+    }
+    EXPECT_EQ(index + derived_layout::members.back().padding, sizeof(mocks::derived_more));
+    EXPECT_EQ(bytes + derived_layout::members[0].offset, reinterpret_cast<const char*>(&derived.name));
+    const auto weight = std::ranges::find(derived_layout::members, "weight", &krrs::reflect::member_layout::name);
+    ASSERT_NE(weight, derived_layout::members.end());
+    EXPECT_EQ(bytes + weight->offset, reinterpret_cast<const char*>(&derived.weight));
+    static_assert(krrs::reflect::layout_info<mocks::with_functions>::members.size() == 7);
+
+    // the audit a test would run over every message type
+    static_assert(krrs::reflect::layout_info<mocks::fixed_price_quote>::bytes_saved_by_reordering == 0);
+    static_assert(krrs::reflect::layout_info<mocks::foo>::bytes_wasted == 1);
+    static_assert(krrs::reflect::layout_info<mocks::resting_order>::bytes_saved_by_reordering == 0);
+}
+
+TEST(test_reflection_extended, test_hash)
+{
+    // account and instrument sit 4 bytes apart, so each is a block of its own. position, weight and desk are hashed
+    // one by one, and bucket starts a new block after weight
+    constexpr auto runs = krrs::reflect::detail::member_runs<mocks::risk_record>();
+    using krrs::reflect::detail::member_run;
+    static_assert(runs[0].how == member_run::block && runs[0].bytes == 4);
+    static_assert(runs[1].how == member_run::block && runs[1].bytes == 8);
+    static_assert(runs[2].how == member_run::single && runs[5].how == member_run::single);
+    static_assert(runs[4].how == member_run::block && runs[4].bytes == 2);
+
+    // quantity and fills touch, so they are one block and fills is not visited on its own
+    constexpr auto fill_runs = krrs::reflect::detail::member_runs<mocks::padded_fill>();
+    static_assert(fill_runs[2].how == member_run::block && fill_runs[2].bytes == 1);
+    static_assert(fill_runs[3].how == member_run::block && fill_runs[3].bytes == 4 + 48 && fill_runs[4].how == member_run::in_block);
+    static_assert(krrs::reflect::is_bitwise_comparable<mocks::risk_key> == false);
+    static_assert(krrs::reflect::is_bitwise_comparable<std::array<int32_t, 4>> && !krrs::reflect::is_bitwise_comparable<double>);
+
+    // the fallback for compilers without a 128-bit integer folds the same product
+    using krrs::reflect::detail::fold_multiply;
+    using krrs::reflect::detail::fold_multiply_portable;
+    static_assert(fold_multiply_portable(~0ull, ~0ull) == (1ull ^ 0xFFFFFFFFFFFFFFFEull));
+    static_assert(fold_multiply_portable(1ull << 32, 1ull << 32) == 1);
+    std::uint64_t a = krrs::reflect::detail::hash_k0;
+    for (int i = 0; i != 1000; ++i)
+    {
+        const std::uint64_t b = a * krrs::reflect::detail::hash_k1 + static_cast<std::uint64_t>(i);
+        EXPECT_EQ(fold_multiply(a, b), fold_multiply_portable(a, b));
+        a = fold_multiply(a ^ krrs::reflect::detail::hash_k2, b);
+    }
+
+    const krrs::reflect::hash<mocks::risk_record> hasher;
+    const mocks::risk_record record{{7, 1'000'000'007}, 2.5, 0.5f, 3, "rates"};
+    mocks::risk_record other = record;
+    EXPECT_EQ(hasher(record), hasher(other));
+    other.desk = "credit";
+    EXPECT_NE(hasher(record), hasher(other));
+    other = record;
+    other.instrument += 1;
+    EXPECT_NE(hasher(record), hasher(other));
+    other = record;
+    other.position = -0.0;
+    mocks::risk_record zero = record;
+    zero.position = 0.0;
+    EXPECT_EQ(hasher(zero), hasher(other));
+
+    // strings, containers and optionals are hashed by contents, unordered ones regardless of order
+    mocks::with_functions lhs{};
+    lhs.label = "label";
+    lhs.tags = {"a", "b"};
+    lhs.maybe_status = mocks::another_enum{};
+    mocks::with_functions rhs = lhs;
+    const std::string label = "label";
+    rhs.label = label;
+    for (int i = 0; i != 32; ++i)
+    {
+        lhs.registry.emplace(std::to_string(i), i);
+        rhs.registry.emplace(std::to_string(31 - i), 31 - i);
+    }
+    const krrs::reflect::hash<mocks::with_functions> function_hasher;
+    EXPECT_EQ(function_hasher(lhs), function_hasher(rhs));
+    rhs.tags = {"ab"};
+    EXPECT_NE(function_hasher(lhs), function_hasher(rhs));
+    rhs = lhs;
+    rhs.maybe_status.reset();
+    EXPECT_NE(function_hasher(lhs), function_hasher(rhs));
+
+    std::unordered_map<mocks::risk_key, int, krrs::reflect::hash<mocks::risk_key>, decltype([](const mocks::risk_key& a, const mocks::risk_key& b) {
+                           return a.account == b.account && a.instrument == b.instrument;
+                       })>
+        positions;
+    std::unordered_set<std::size_t> distinct;
+    for (int i = 0; i != 1000; ++i)
+    {
+        const mocks::risk_key key{i % 10, i / 10};
+        positions[key] += i;
+        distinct.insert(krrs::reflect::hash<mocks::risk_key>{}(key));
+    }
+    EXPECT_EQ(positions.size(), 1000u);
+    EXPECT_EQ(distinct.size(), 1000u);
+    EXPECT_EQ((positions[mocks::risk_key{3, 12}]), 123);
+}
+
+TEST(test_reflection_extended, test_equal_and_compare)
+{
+    // risk_key has 4 bytes of padding after account, so it is compared member by member
+    static_assert(!krrs::reflect::is_bitwise_comparable<mocks::risk_key>);
+    const mocks::risk_key key{7, 42};
+    EXPECT_TRUE(krrs::reflect::equal(key, mocks::risk_key{7, 42}));
+    EXPECT_FALSE(krrs::reflect::equal(key, mocks::risk_key{7, 43}));
+    static_assert(std::same_as<decltype(krrs::reflect::compare(key, key)), std::strong_ordering>);
+    EXPECT_EQ(krrs::reflect::compare(key, mocks::risk_key{8, 0}), std::strong_ordering::less);
+    EXPECT_EQ(krrs::reflect::compare(key, mocks::risk_key{7, -1}), std::strong_ordering::greater);
+    static_assert(krrs::reflect::equal(mocks::risk_key{1, 2}, mocks::risk_key{1, 2}));
+    static_assert(krrs::reflect::compare(mocks::risk_key{1, 2}, mocks::risk_key{1, 3}) < 0);
+
+    // a and b form one block, which constant evaluation compares member by member
+    static_assert(krrs::reflect::is_bitwise_comparable<mocks::int_pair>);
+    static_assert(krrs::reflect::equal(mocks::int_pair{1, 2}, mocks::int_pair{1, 2}));
+    static_assert(!krrs::reflect::equal(mocks::int_pair{1, 2}, mocks::int_pair{1, 3}));
+    static_assert(krrs::reflect::compare(mocks::int_pair{1, 2}, mocks::int_pair{1, 3}) < 0);
+    EXPECT_FALSE(krrs::reflect::equal(mocks::int_pair{1, 2}, mocks::int_pair{1, 3}));
+
+    // desk is a string, so the scalars are compared first, and a double makes the ordering partial
+    constexpr auto order = krrs::reflect::detail::equality_order<mocks::risk_record>();
+    static_assert(order == std::array<std::size_t, 6>{0, 1, 4, 2, 3, 5});
+    const mocks::risk_record record{{7, 42}, 2.5, 0.5f, 3, "rates"};
+    mocks::risk_record other = record;
+    EXPECT_TRUE(krrs::reflect::equal(record, other));
+    static_assert(std::same_as<decltype(krrs::reflect::compare(record, other)), std::partial_ordering>);
+    EXPECT_EQ(krrs::reflect::compare(record, other), std::partial_ordering::equivalent);
+    other.desk = "credit";
+    EXPECT_FALSE(krrs::reflect::equal(record, other));
+    EXPECT_EQ(krrs::reflect::compare(record, other), std::partial_ordering::greater);
+    other = record;
+    other.position = -0.0;
+    mocks::risk_record zero = record;
+    zero.position = 0.0;
+    EXPECT_TRUE(krrs::reflect::equal(zero, other));
+    other.position = std::numeric_limits<double>::quiet_NaN();
+    EXPECT_FALSE(krrs::reflect::equal(other, other));
+    EXPECT_EQ(krrs::reflect::compare(zero, other), std::partial_ordering::unordered);
+
+    // quantity and fills form one block. it is compared as bytes for equality, member by member for ordering
+    mocks::padded_fill fill{'B', 101.5, 'N', 300, {}};
+    mocks::padded_fill larger = fill;
+    larger.fills[0] = 1;
+    EXPECT_FALSE(krrs::reflect::equal(fill, larger));
+    EXPECT_EQ(krrs::reflect::compare(fill, larger), std::partial_ordering::less);
+    larger.quantity = -1;
+    EXPECT_EQ(krrs::reflect::compare(fill, larger), std::partial_ordering::greater);
+
+    // base classes take part, and so do containers and nested reflected types without operators
+    mocks::derived_more derived{};
+    derived.name = "name";
+    derived.priority = 3;
+    mocks::derived_more derived_other = derived;
+    EXPECT_TRUE(krrs::reflect::equal(derived, derived_other));
+    derived_other.priority = 4;
+    EXPECT_FALSE(krrs::reflect::equal(derived, derived_other));
+    EXPECT_TRUE(krrs::reflect::compare(derived, derived_other) < 0);
+
+    mocks::with_functions lhs{};
+    lhs.tags = {"a", "b"};
+    mocks::with_functions rhs = lhs;
+    rhs.registry.emplace("k", 1.0);
+    EXPECT_FALSE(krrs::reflect::equal(lhs, rhs));
+    rhs.registry.clear();
+    EXPECT_TRUE(krrs::reflect::equal(lhs, rhs));
+
+    const std::vector<mocks::risk_key> lhs_keys{{1, 2}, {3, 4}};
+    const std::vector<mocks::risk_key> rhs_keys{{1, 2}, {3, 5}};
+    EXPECT_FALSE(krrs::reflect::detail::equal_value(lhs_keys, rhs_keys));
+    EXPECT_EQ(krrs::reflect::detail::compare_value(lhs_keys, rhs_keys), std::strong_ordering::less);
+}
+
+TEST(test_reflection_extended, test_hidden_member_layout)
+{
+    // the base class level keeps its own offset, so both levels and limit form one block of 12 bytes
+    using hidden_layout = krrs::reflect::layout_info<mocks::hidden_limit>;
+    static_assert(hidden_layout::members.size() == 4);
+    static_assert(hidden_layout::members[0].offset == 0 && hidden_layout::members[1].offset == 4 && hidden_layout::members[2].offset == 8);
+    static_assert(hidden_layout::members[2].padding == 4 && hidden_layout::bytes_wasted == 4);
+    constexpr auto runs = krrs::reflect::detail::member_runs<mocks::hidden_limit>();
+    using krrs::reflect::detail::member_run;
+    static_assert(runs[0].how == member_run::block && runs[0].bytes == 12);
+    static_assert(runs[1].how == member_run::in_block && runs[2].how == member_run::in_block && runs[3].how == member_run::single);
+
+    mocks::hidden_limit lhs{};
+    lhs.limit_base::level = 1;
+    lhs.limit = 2;
+    lhs.level = 3;
+    lhs.note = "note";
+    mocks::hidden_limit rhs = lhs;
+    const krrs::reflect::hash<mocks::hidden_limit> hasher;
+    EXPECT_TRUE(krrs::reflect::equal(lhs, rhs));
+    EXPECT_EQ(hasher(lhs), hasher(rhs));
+    rhs.limit_base::level = 4;
+    EXPECT_FALSE(krrs::reflect::equal(lhs, rhs));
+    EXPECT_NE(hasher(lhs), hasher(rhs));
+    EXPECT_EQ(krrs::reflect::compare(lhs, rhs), std::strong_ordering::less);
+    rhs = lhs;
+    rhs.level = 0;
+    EXPECT_FALSE(krrs::reflect::equal(lhs, rhs));
+    EXPECT_EQ(krrs::reflect::compare(lhs, rhs), std::strong_ordering::greater);
+}
+
 } // namespace tests
@@ -145,4 +145,36 @@ complex_types:
     EXPECT_EQ(converted, round_trip_converted);
 }
 
+TEST(test_yaml_with_reflection, test_shortest_round_trip_numbers)
+{
+    const mocks::complex_types original{.vector = {-7},
+                                        .string = "prices",
+                                        .unordered_map = {},
+                                        .optional = 0.1,
+                                        .empty_vector = {0.1, 101.25, 1e-7},
+                                        .empty_optional = {},
+                                        .s = {}};
+
+    // yaml-cpp alone would stream 0.1 as 0.10000000000000001
+    const std::string yaml_str = ::krrs::yaml::serialize(original);
+    EXPECT_THAT(yaml_str, HasSubstr("optional: 0.1\n"));
+    EXPECT_THAT(yaml_str, Not(HasSubstr("0.1000")));
+    EXPECT_EQ(::krrs::yaml::deserialize<mocks::complex_types>(yaml_str), original);
+}
+
+TEST(test_yaml_with_reflection, test_serialize_to_sink)
+{
+    const mocks::built_in_types obj{1.5f, 42, 'c', 2.25, 7};
+    const std::string expected = krrs::yaml::serialize(obj);
+
+    std::string storage(expected.size(), '\0');
+    krrs::io::buffer_sink sink{storage.data(), storage.size()};
+    krrs::yaml::serialize(obj, sink);
+    EXPECT_EQ(sink.view(), expected);
+
+    // errors raised by the sink make it out of the emitter
+    krrs::io::buffer_sink too_small{storage.data(), 4};
+    EXPECT_THROW(krrs::yaml::serialize(obj, too_small), std::runtime_error);
+}
+
 } // namespace tests